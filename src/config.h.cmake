@@ -32,6 +32,9 @@
 /* Define to 1 in order to disable TraCI Server. */
 #undef NO_TRACI
 
+/* defined if the memory pools shall be bypassed (e.g. for valgrind) */
+#cmakedefine NO_MEMORY_POOL
+
 /* defines the epsilon to use on general floating point comparison */
 #define NUMERICAL_EPS 0.001
 
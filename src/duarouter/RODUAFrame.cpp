@@ -105,7 +105,7 @@ RODUAFrame::addImportOptions() {
     oc.addDescription("weights.expand", "Processing", "Expand weights behind the simulation's end");
 
     oc.doRegister("routing-algorithm", new Option_String("dijkstra"));
-    oc.addDescription("routing-algorithm", "Processing", "Select among routing algorithms ['dijkstra', 'astar', 'CH', 'CHWrapper']");
+    oc.addDescription("routing-algorithm", "Processing", "Select among routing algorithms ['dijkstra', 'bidijkstra', 'astar', 'CH', 'CHWrapper']");
 
     oc.doRegister("weight-period", new Option_String("3600", "TIME"));
     oc.addDescription("weight-period", "Processing", "Aggregation period for the given weight files; triggers rebuilding of Contraction Hierarchy");
@@ -114,10 +114,13 @@ RODUAFrame::addImportOptions() {
     oc.addDescription("astar.all-distances", "Processing", "Initialize lookup table for astar from the given file (generated by marouter --all-pairs-output)");
 
     oc.doRegister("astar.landmark-distances", new Option_FileName());
-    oc.addDescription("astar.landmark-distances", "Processing", "Initialize lookup table for astar ALT-variant from the given file");
+    oc.addDescription("astar.landmark-distances", "Processing", "Initialize lookup table for astar ALT-variant from the given file (text or binary format)");
+
+    oc.doRegister("astar.landmark-count", new Option_Integer(0));
+    oc.addDescription("astar.landmark-count", "Processing", "Select INT landmarks for astar ALT-variant automatically if no landmark file is given");
 
     oc.doRegister("astar.save-landmark-distances", new Option_FileName());
-    oc.addDescription("astar.save-landmark-distances", "Processing", "Save lookup table for astar ALT-variant to the given file");
+    oc.addDescription("astar.save-landmark-distances", "Processing", "Save lookup table for astar ALT-variant to the given file (binary format if the name ends with '.bin')");
 }
 
 
@@ -212,7 +215,7 @@ RODUAFrame::checkOptions() {
         WRITE_ERROR("Routing algorithm '" + oc.getString("routing-algorithm") + "' does not support bulk routing.");
         return false;
     }
-    if (oc.isDefault("routing-algorithm") && (oc.isSet("astar.all-distances") || oc.isSet("astar.landmark-distances") || oc.isSet("astar.save-landmark-distances"))) {
+    if (oc.isDefault("routing-algorithm") && (oc.isSet("astar.all-distances") || oc.isSet("astar.landmark-distances") || oc.getInt("astar.landmark-count") > 0 || oc.isSet("astar.save-landmark-distances"))) {
         oc.set("routing-algorithm", "astar");
     }
 
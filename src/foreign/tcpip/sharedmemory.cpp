@@ -0,0 +1,501 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2018-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    sharedmemory.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// A pair of ring buffers in a named shared memory segment for local TraCI connections
+/****************************************************************************/
+
+#include "socket.h"
+#include "sharedmemory.h"
+
+#ifndef WIN32
+	#include <sys/mman.h>
+	#include <signal.h>
+	#include <sys/stat.h>
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#else
+	#ifdef ERROR
+		#undef ERROR
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+
+
+namespace tcpip
+{
+	const std::size_t SharedMemory::DEFAULT_CAPACITY = 1 << 23;
+
+	/// @brief Identifies an initialized segment
+	static const unsigned int SHM_MAGIC = 0x54724349;
+
+	/// @brief Bits of the connection state
+	static const unsigned int SERVER_CLOSED = 1;
+	static const unsigned int CLIENT_ATTACHED = 2;
+	static const unsigned int CLIENT_CLOSED = 4;
+
+
+	/// @brief The start of the segment, the first ring (server to client) follows directly
+	struct alignas(64) SharedMemory::Header
+	{
+		Header(const unsigned int capacity) : magic(0), capacity(capacity), state(0), serverProcess(0), clientProcess(0) {}
+		std::atomic<unsigned int> magic;
+		unsigned int capacity;
+		std::atomic<unsigned int> state;
+		unsigned int serverProcess;
+		unsigned int clientProcess;
+	};
+
+
+	/// @brief The positions of a ring (counting all bytes modulo 2^32), the data follows directly
+	struct SharedMemory::Ring
+	{
+		Ring() : head(0), tail(0) {}
+		/// @brief Number of bytes written, only changed by the writer
+		alignas(64) std::atomic<unsigned int> head;
+		/// @brief Number of bytes read, only changed by the reader (separate cache line)
+		alignas(64) std::atomic<unsigned int> tail;
+	};
+
+
+	// ----------------------------------------------------------------------
+	SharedMemory::
+		SharedMemory(const std::string& name, const bool create, std::size_t capacity)
+		: name_(name),
+		server_(create),
+		header_(0),
+		out_(0),
+		in_(0),
+		size_(0),
+#ifdef WIN32
+		handle_(0)
+#else
+		linked_(false)
+#endif
+	{
+		std::size_t ringCapacity = 4096;
+		while (ringCapacity < capacity && ringCapacity < (1u << 30))
+			ringCapacity <<= 1;
+		map(create, sizeof(Header) + 2 * (sizeof(Ring) + ringCapacity));
+		if (create)
+		{
+			header_ = new (header_) Header(static_cast<unsigned int>(ringCapacity));
+			header_->serverProcess = processID();
+			new (reinterpret_cast<unsigned char*>(header_) + sizeof(Header)) Ring();
+			new (reinterpret_cast<unsigned char*>(header_) + sizeof(Header) + sizeof(Ring) + ringCapacity) Ring();
+			header_->magic.store(SHM_MAGIC, std::memory_order_release);
+		}
+		else
+		{
+			if (header_->magic.load(std::memory_order_acquire) != SHM_MAGIC
+					|| size_ < sizeof(Header) + 2 * (sizeof(Ring) + header_->capacity))
+			{
+				unmap();
+				throw SocketException("tcpip::SharedMemory: segment '" + name_ + "' is not ready");
+			}
+			header_->clientProcess = processID();
+			const unsigned int previous = header_->state.fetch_or(CLIENT_ATTACHED);
+			if ((previous & (SERVER_CLOSED | CLIENT_ATTACHED)) != 0)
+			{
+				unmap();
+				throw SocketException("tcpip::SharedMemory: segment '" + name_ + "' is already in use");
+			}
+		}
+		Ring* const first = reinterpret_cast<Ring*>(reinterpret_cast<unsigned char*>(header_) + sizeof(Header));
+		Ring* const second = reinterpret_cast<Ring*>(data(first) + header_->capacity);
+		out_ = create ? first : second;
+		in_ = create ? second : first;
+	}
+
+
+	// ----------------------------------------------------------------------
+	SharedMemory::
+		~SharedMemory()
+	{
+		close();
+		unmap();
+		unlink();
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		SharedMemory::
+		accept()
+	{
+		int round = 0;
+		while ((header_->state.load(std::memory_order_acquire) & CLIENT_ATTACHED) == 0)
+			wait(round);
+		// nobody else may attach, so the name is not needed anymore
+		unlink();
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		SharedMemory::
+		write(const unsigned char* data, std::size_t len)
+	{
+		const unsigned int capacity = header_->capacity;
+		unsigned char* const ringData = this->data(out_);
+		const unsigned int head = out_->head.load(std::memory_order_relaxed);
+		unsigned int written = 0;
+		int round = 0;
+		while (len > 0)
+		{
+			const unsigned int space = capacity - (head + written - out_->tail.load(std::memory_order_acquire));
+			if (space == 0)
+			{
+				if (peerClosed(round >= 2000))
+					throw SocketException("tcpip::SharedMemory::write: peer shutdown");
+				// let the reader see what is there already
+				out_->head.store(head + written, std::memory_order_release);
+				wait(round);
+				continue;
+			}
+			round = 0;
+			const unsigned int pos = (head + written) & (capacity - 1);
+			const std::size_t num = std::min(len, static_cast<std::size_t>(std::min(space, capacity - pos)));
+			memcpy(ringData + pos, data, num);
+			data += num;
+			len -= num;
+			written += static_cast<unsigned int>(num);
+		}
+		out_->head.store(head + written, std::memory_order_release);
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		SharedMemory::
+		read(unsigned char* data, std::size_t len)
+	{
+		int round = 0;
+		while (len > 0)
+		{
+			const std::size_t num = readAvailable(data, len);
+			if (num == 0)
+			{
+				// the peer writes everything before closing, so check the ring again afterwards
+				if (peerClosed(round >= 2000) && in_->head.load(std::memory_order_acquire) == in_->tail.load(std::memory_order_relaxed))
+					throw SocketException("tcpip::SharedMemory::read: peer shutdown");
+				wait(round);
+				continue;
+			}
+			round = 0;
+			data += num;
+			len -= num;
+		}
+	}
+
+
+	// ----------------------------------------------------------------------
+	std::size_t
+		SharedMemory::
+		readAvailable(unsigned char* data, std::size_t len)
+	{
+		const unsigned int capacity = header_->capacity;
+		const unsigned int tail = in_->tail.load(std::memory_order_relaxed);
+		const unsigned int available = in_->head.load(std::memory_order_acquire) - tail;
+		const unsigned int pos = tail & (capacity - 1);
+		const std::size_t num = std::min(len, static_cast<std::size_t>(std::min(available, capacity - pos)));
+		if (num > 0)
+		{
+			memcpy(data, this->data(in_) + pos, num);
+			in_->tail.store(tail + static_cast<unsigned int>(num), std::memory_order_release);
+		}
+		return num;
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		SharedMemory::
+		close()
+	{
+		if (header_ != 0)
+			header_->state.fetch_or(server_ ? SERVER_CLOSED : CLIENT_CLOSED);
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		SharedMemory::
+		wait(int& round)
+	{
+		// a local controller usually answers within microseconds, so spin first
+		if (round >= 2000)
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		else if (round >= 1000)
+			std::this_thread::yield();
+		round++;
+	}
+
+
+	// ----------------------------------------------------------------------
+	bool
+		SharedMemory::
+		peerClosed(const bool checkProcess)
+		const
+	{
+		if ((header_->state.load(std::memory_order_acquire) & (server_ ? CLIENT_CLOSED : SERVER_CLOSED)) != 0)
+			return true;
+		return checkProcess && !processAlive(server_ ? header_->clientProcess : header_->serverProcess);
+	}
+
+
+	// ----------------------------------------------------------------------
+	unsigned char*
+		SharedMemory::
+		data(Ring* ring)
+		const
+	{
+		return reinterpret_cast<unsigned char*>(ring) + sizeof(Ring);
+	}
+
+
+#ifdef WIN32
+	// ----------------------------------------------------------------------
+	void
+		SharedMemory::
+		map(const bool create, std::size_t size)
+	{
+		if (create)
+		{
+			const unsigned long long size64 = size;
+			handle_ = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+				static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFF), name_.c_str());
+			if (handle_ != NULL && GetLastError() == ERROR_ALREADY_EXISTS)
+			{
+				CloseHandle(handle_);
+				handle_ = 0;
+				throw SocketException("tcpip::SharedMemory: segment '" + name_ + "' is already in use");
+			}
+		}
+		else
+			handle_ = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name_.c_str());
+		if (handle_ == NULL)
+		{
+			handle_ = 0;
+			throw SocketException("tcpip::SharedMemory: could not open segment '" + name_ + "'");
+		}
+		void* start = MapViewOfFile(handle_, FILE_MAP_ALL_ACCESS, 0, 0, create ? size : 0);
+		if (start == NULL)
+		{
+			CloseHandle(handle_);
+			handle_ = 0;
+			throw SocketException("tcpip::SharedMemory: could not map segment '" + name_ + "'");
+		}
+		if (!create)
+		{
+			MEMORY_BASIC_INFORMATION info;
+			VirtualQuery(start, &info, sizeof(info));
+			size = info.RegionSize;
+		}
+		header_ = static_cast<Header*>(start);
+		size_ = size;
+	}
+
+
+	// ----------------------------------------------------------------------
+	unsigned int
+		SharedMemory::
+		processID()
+	{
+		return static_cast<unsigned int>(GetCurrentProcessId());
+	}
+
+
+	// ----------------------------------------------------------------------
+	bool
+		SharedMemory::
+		processAlive(const unsigned int id)
+	{
+		HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(id));
+		if (process == NULL)
+			return false;
+		const bool alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+		CloseHandle(process);
+		return alive;
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		SharedMemory::
+		unmap()
+	{
+		if (header_ != 0)
+		{
+			UnmapViewOfFile(header_);
+			header_ = 0;
+		}
+		if (handle_ != 0)
+		{
+			CloseHandle(handle_);
+			handle_ = 0;
+		}
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		SharedMemory::
+		unlink()
+	{
+		// the mapping disappears together with its last handle
+	}
+
+#else
+	// ----------------------------------------------------------------------
+	void
+		SharedMemory::
+		map(const bool create, std::size_t size)
+	{
+		const std::string posixName = name_[0] == '/' ? name_ : "/" + name_;
+		int fd = -1;
+		if (create)
+		{
+			fd = shm_open(posixName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+			if (fd < 0 && errno == EEXIST)
+			{
+				if (serverRunning(posixName))
+					throw SocketException("tcpip::SharedMemory: segment '" + name_ + "' is already in use");
+				// remove a segment left over by a crashed server (similar to SO_REUSEADDR)
+				shm_unlink(posixName.c_str());
+				fd = shm_open(posixName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+			}
+			if (fd >= 0)
+			{
+				linked_ = true;
+				if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+				{
+					const std::string msg = strerror(errno);
+					::close(fd);
+					unlink();
+					throw SocketException("tcpip::SharedMemory: could not resize segment '" + name_ + "': " + msg);
+				}
+			}
+		}
+		else
+		{
+			fd = shm_open(posixName.c_str(), O_RDWR, 0);
+			struct stat info;
+			if (fd >= 0 && fstat(fd, &info) == 0)
+				size = static_cast<std::size_t>(info.st_size);
+			if (fd >= 0 && size < sizeof(Header))
+			{
+				::close(fd);
+				throw SocketException("tcpip::SharedMemory: segment '" + name_ + "' is not ready");
+			}
+		}
+		if (fd < 0)
+			throw SocketException("tcpip::SharedMemory: could not open segment '" + name_ + "': " + strerror(errno));
+		void* start = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		const std::string msg = strerror(errno);
+		::close(fd);
+		if (start == MAP_FAILED)
+		{
+			unlink();
+			throw SocketException("tcpip::SharedMemory: could not map segment '" + name_ + "': " + msg);
+		}
+		header_ = static_cast<Header*>(start);
+		size_ = size;
+	}
+
+
+	// ----------------------------------------------------------------------
+	bool
+		SharedMemory::
+		serverRunning(const std::string& posixName)
+	{
+		const int fd = shm_open(posixName.c_str(), O_RDONLY, 0);
+		if (fd < 0)
+			return false;
+		// a server which is just starting resizes the segment and sets up the header within a few milliseconds
+		struct stat info;
+		for (int i = 0; i < 100 && fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) < sizeof(Header); ++i)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		void* start = MAP_FAILED;
+		if (fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= sizeof(Header))
+			start = mmap(NULL, sizeof(Header), PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (start == MAP_FAILED)
+			return false;
+		const Header* const header = static_cast<const Header*>(start);
+		for (int i = 0; i < 100 && header->magic.load(std::memory_order_acquire) != SHM_MAGIC; ++i)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		const bool running = header->magic.load(std::memory_order_acquire) == SHM_MAGIC
+			&& (header->state.load() & SERVER_CLOSED) == 0
+			&& processAlive(header->serverProcess);
+		munmap(start, sizeof(Header));
+		return running;
+	}
+
+
+	// ----------------------------------------------------------------------
+	unsigned int
+		SharedMemory::
+		processID()
+	{
+		return static_cast<unsigned int>(getpid());
+	}
+
+
+	// ----------------------------------------------------------------------
+	bool
+		SharedMemory::
+		processAlive(const unsigned int id)
+	{
+		return kill(static_cast<pid_t>(id), 0) == 0 || errno == EPERM;
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		SharedMemory::
+		unmap()
+	{
+		if (header_ != 0)
+		{
+			munmap(header_, size_);
+			header_ = 0;
+		}
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		SharedMemory::
+		unlink()
+	{
+		if (linked_)
+		{
+			shm_unlink((name_[0] == '/' ? name_ : "/" + name_).c_str());
+			linked_ = false;
+		}
+	}
+#endif
+
+}	// namespace tcpip
@@ -0,0 +1,145 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2018-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    sharedmemory.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// A pair of ring buffers in a named shared memory segment for local TraCI connections
+/****************************************************************************/
+#ifndef __SUMO_TCPIP_SHAREDMEMORY_H
+#define __SUMO_TCPIP_SHAREDMEMORY_H
+
+#include <string>
+#include <cstddef>
+
+
+namespace tcpip
+{
+
+	/**
+	 * @class SharedMemory
+	 * @brief A pair of ring buffers in a named shared memory segment
+	 *
+	 * The server creates the segment and waits for a single client to attach.
+	 *  Afterwards both sides stream bytes into their ring and read from the ring
+	 *  of the peer without any system call. Reading from an empty ring and writing
+	 *  into a full ring spin for a short while and back off to sleeping after that.
+	 *  Messages larger than the ring are streamed in pieces. While sleeping the
+	 *  process of the peer is checked so a crashed peer does not block forever.
+	 *
+	 * Creating a segment whose name is still used by a running server fails, a segment
+	 *  left over by a crashed server is replaced.
+	 *
+	 * Errors (including a peer which closed the segment) are reported as SocketException.
+	 */
+	class SharedMemory
+	{
+	public:
+		/** @brief Creates (server) or opens (client) the segment with the given name
+		 * @param[in] name The name of the segment
+		 * @param[in] create Whether to create the segment
+		 * @param[in] capacity The size of each ring in bytes (rounded up to a power of two, only used when creating)
+		 */
+		SharedMemory(const std::string& name, const bool create, std::size_t capacity = DEFAULT_CAPACITY);
+
+		/// @brief Destructor, closes the connection and releases the segment
+		~SharedMemory();
+
+		/// @brief Waits until the client has attached to the segment (server only)
+		void accept();
+
+		/// @brief Writes the given bytes into the ring of the peer, waiting for space if necessary
+		void write(const unsigned char* data, std::size_t len);
+
+		/// @brief Reads exactly len bytes from the own ring, waiting for data if necessary
+		void read(unsigned char* data, std::size_t len);
+
+		/// @brief Reads up to len bytes which are already available and returns their number
+		std::size_t readAvailable(unsigned char* data, std::size_t len);
+
+		/// @brief Tells the peer that this side is gone
+		void close();
+
+		/// @brief The default size of each ring
+		static const std::size_t DEFAULT_CAPACITY;
+
+	private:
+		struct Header;
+		struct Ring;
+
+		/// @brief Waits a little, spinning in the first rounds and sleeping later on
+		static void wait(int& round);
+
+		/** @brief Returns whether the peer has closed the connection
+		 * @param[in] checkProcess Whether to check that the peer process is still running (which needs a system call)
+		 */
+		bool peerClosed(const bool checkProcess) const;
+
+		/// @brief Returns the id of the current process
+		static unsigned int processID();
+
+		/// @brief Returns whether the process with the given id is still running
+		static bool processAlive(const unsigned int id);
+
+		/// @brief Returns the first byte of the data of the given ring
+		unsigned char* data(Ring* ring) const;
+
+		/// @brief Maps the segment (creating it if requested)
+		void map(const bool create, std::size_t size);
+
+		/// @brief Unmaps the segment
+		void unmap();
+
+		/// @brief Removes the name of the segment (the memory stays valid until unmapped)
+		void unlink();
+
+#ifndef WIN32
+		/// @brief Returns whether the existing segment with the given name belongs to a running server
+		static bool serverRunning(const std::string& posixName);
+#endif
+
+		/// @brief The name of the segment
+		std::string name_;
+
+		/// @brief Whether this is the side which created the segment
+		bool server_;
+
+		/// @brief The start of the mapped segment
+		Header* header_;
+
+		/// @brief The ring this side writes into
+		Ring* out_;
+
+		/// @brief The ring this side reads from
+		Ring* in_;
+
+		/// @brief The size of the mapped segment in bytes
+		std::size_t size_;
+
+#ifdef WIN32
+		/// @brief The handle of the file mapping
+		void* handle_;
+#else
+		/// @brief Whether the name of the segment still needs to be removed
+		bool linked_;
+#endif
+
+	private:
+		/// @brief Invalidated copy constructor.
+		SharedMemory(const SharedMemory&);
+
+		/// @brief Invalidated assignment operator.
+		SharedMemory& operator=(const SharedMemory&);
+	};
+
+}	// namespace tcpip
+
+#endif
@@ -11,6 +11,7 @@
 	#include <sys/simulation/simulation_controller.h>
 #else
 	#include "socket.h"
+	#include "sharedmemory.h"
 #endif
 
 #ifdef BUILD_TCPIP
@@ -76,6 +77,7 @@ namespace tcpip
 		socket_(-1),
 		server_socket_(-1),
 		blocking_(true),
+		shm_(0),
 		verbose_(false)
 	{
 		init();
@@ -89,11 +91,29 @@ namespace tcpip
 		socket_(-1),
 		server_socket_(-1),
 		blocking_(true),
+		shm_(0),
 		verbose_(false)
 	{
 		init();
 	}
 
+	// ----------------------------------------------------------------------
+	Socket::
+		Socket(std::string shmName, bool server) 
+		: host_(""),
+		port_(0),
+		socket_(-1),
+		server_socket_(-1),
+		blocking_(true),
+		shmName_(shmName),
+		shm_(0),
+		verbose_(false)
+	{
+		init();
+		if (server)
+			shm_ = new SharedMemory(shmName_, true);
+	}
+
 	// ----------------------------------------------------------------------
 	void
 		Socket::
@@ -232,6 +252,21 @@ namespace tcpip
 		if( socket_ >= 0 )
 			return 0;
 
+		if( !shmName_.empty() )
+		{
+			if( shm_ == 0 )
+				throw SocketException("tcpip::Socket::accept() @ shared memory segment '" + shmName_ + "' is already in use");
+			shm_->accept();
+			if (create) {
+				Socket* result = new Socket(0);
+				result->shmName_ = shmName_;
+				result->shm_ = shm_;
+				shm_ = 0;
+				return result;
+			}
+			return 0;
+		}
+
 		struct sockaddr_in client_addr;
 #ifdef WIN32
 		int addrlen = sizeof(client_addr);
@@ -327,6 +362,13 @@ namespace tcpip
 		Socket::
 		connect()
 	{
+		if( !shmName_.empty() )
+		{
+			if( shm_ == 0 )
+				shm_ = new SharedMemory(shmName_, false);
+			return;
+		}
+
 		sockaddr_in address;
 
 		if( !atoaddr( host_.c_str(), address) )
@@ -352,6 +394,11 @@ namespace tcpip
 		close()
 	{
 		// Close client-connection 
+		if( shm_ != 0 )
+		{
+			delete shm_;
+			shm_ = 0;
+		}
 		if( socket_ >= 0 )
 		{
 #ifdef WIN32
@@ -369,6 +416,14 @@ namespace tcpip
 		Socket::
 		send( const std::vector<unsigned char> &buffer)
 	{
+		if( shm_ != 0 )
+		{
+			printBufferOnVerbose(buffer, "Send");
+			if( !buffer.empty() )
+				shm_->write(&buffer[0], buffer.size());
+			return;
+		}
+
 		if( socket_ < 0 )
 			return;
 
@@ -403,6 +458,15 @@ namespace tcpip
 		Storage length_storage;
 		length_storage.writeInt(lengthLen + length);
 
+		if( shm_ != 0 )
+		{
+			// the ring buffer needs no complete message, so copy straight from the storages
+			shm_->write(&*length_storage.begin(), lengthLen);
+			if( length > 0 )
+				shm_->write(&*b.begin(), length);
+			return;
+		}
+
 		// Sending length_storage and b independently would probably be possible and
 		// avoid some copying here, but both parts would have to go through the
 		// TCP/IP stack on their own which probably would cost more performance.
@@ -439,6 +503,11 @@ namespace tcpip
 		receiveComplete(unsigned char * buffer, size_t len)
 		const
 	{
+		if( shm_ != 0 )
+		{
+			shm_->read(buffer, len);
+			return;
+		}
 		while (len > 0)
 		{
 			const size_t bytesReceived = recvAndCheck(buffer, len);
@@ -473,9 +542,17 @@ namespace tcpip
 	{
 		std::vector<unsigned char> buffer;
 
-		if( socket_ < 0 )
+		if( socket_ < 0 && shm_ == 0 )
 			connect();
 
+		if( shm_ != 0 )
+		{
+			buffer.resize(bufSize);
+			buffer.resize(shm_->readAvailable(&buffer[0], bufSize));
+			printBufferOnVerbose(buffer, "Rcvd");
+			return buffer;
+		}
+
 		if( !datawaiting( socket_) )
 			return buffer;
 
@@ -529,7 +606,7 @@ namespace tcpip
 		has_client_connection() 
 		const
 	{
-		return socket_ >= 0;
+		return socket_ >= 0 || shm_ != 0;
 	}
 
 	// ----------------------------------------------------------------------
@@ -51,6 +51,8 @@ struct sockaddr_in;
 namespace tcpip
 {
 
+	class SharedMemory;
+
 	class SocketException: public std::runtime_error
 	{
 	public:
@@ -67,6 +69,9 @@ namespace tcpip
 		/// Constructor that prepare for accepting a connection on given port
 		Socket(int port);
 
+		/// Constructor that prepares a connection via the named shared memory segment which is created by the server
+		Socket(std::string shmName, bool server);
+
 		/// Destructor
 		~Socket();
 
@@ -118,6 +123,11 @@ namespace tcpip
 		int server_socket_;
 		bool blocking_;
 
+		/// Name of the shared memory segment (empty for TCP/IP)
+		std::string shmName_;
+		/// The shared memory connection replacing socket_ (if connected via shared memory)
+		SharedMemory* shm_;
+
 		bool verbose_;
 #ifdef WIN32
 		static bool init_windows_sockets_;
@@ -93,8 +93,10 @@ std::vector<GUIGlID>
 GUIEdge::getIDs(bool includeInternal) {
     std::vector<GUIGlID> ret;
     ret.reserve(MSEdge::myDict.size());
-    for (MSEdge::DictType::const_iterator i = MSEdge::myDict.begin(); i != MSEdge::myDict.end(); ++i) {
-        const GUIEdge* edge = dynamic_cast<const GUIEdge*>(i->second);
+    std::vector<std::string> ids;
+    MSEdge::insertIDs(ids);
+    for (const std::string& id : ids) {
+        const GUIEdge* edge = dynamic_cast<const GUIEdge*>(MSEdge::myDict[id]);
         assert(edge);
         if (includeInternal || !edge->isInternal()) {
             ret.push_back(edge->getGlID());
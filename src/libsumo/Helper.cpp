@@ -35,6 +35,7 @@
 #include <microsim/MSLane.h>
 #include <microsim/MSVehicle.h>
 #include <microsim/MSTransportable.h>
+#include <microsim/MSPositionGrid.h>
 #include <microsim/pedestrians/MSPerson.h>
 #include <libsumo/TraCIDefs.h>
 #include <libsumo/InductionLoop.h>
@@ -52,37 +53,20 @@
 
 void
 LaneStoringVisitor::add(const MSLane* const l) const {
+    if (myLanes != 0) {
+        myLanes->insert(l);
+        return;
+    }
     switch (myDomain) {
-        case CMD_GET_VEHICLE_VARIABLE: {
-            const MSLane::VehCont& vehs = l->getVehiclesSecure();
-            for (MSLane::VehCont::const_iterator j = vehs.begin(); j != vehs.end(); ++j) {
-                if (myShape.distance2D((*j)->getPosition()) <= myRange) {
-                    myIDs.insert((*j)->getID());
-                }
-            }
-            l->releaseVehicles();
-        }
-        break;
-        case CMD_GET_PERSON_VARIABLE: {
-            l->getVehiclesSecure();
-            std::vector<MSTransportable*> persons = l->getEdge().getSortedPersons(MSNet::getInstance()->getCurrentTimeStep(), true);
-            for (auto p : persons) {
-                if (myShape.distance2D(p->getPosition()) <= myRange) {
-                    myIDs.insert(p->getID());
-                }
-            }
-            l->releaseVehicles();
-        }
-        break;
         case CMD_GET_EDGE_VARIABLE: {
-            if (myShape.size() != 1 || l->getShape().distance2D(myShape[0]) <= myRange) {
-                myIDs.insert(l->getEdge().getID());
+            if (myShape->size() != 1 || l->getShape().distance2D((*myShape)[0]) <= myRange) {
+                myIDs->insert(l->getEdge().getID());
             }
         }
         break;
         case CMD_GET_LANE_VARIABLE: {
-            if (myShape.size() != 1 || l->getShape().distance2D(myShape[0]) <= myRange) {
-                myIDs.insert(l->getID());
+            if (myShape->size() != 1 || l->getShape().distance2D((*myShape)[0]) <= myRange) {
+                myIDs->insert(l->getID());
             }
         }
         break;
@@ -98,6 +82,7 @@ namespace libsumo {
 // ===========================================================================
 std::map<int, NamedRTree*> Helper::myObjects;
 LANE_RTREE_QUAL* Helper::myLaneTree;
+LANE_RTREE_QUAL* Helper::myLaneSegmentTree;
 std::map<std::string, MSVehicle*> Helper::myRemoteControlledVehicles;
 std::map<std::string, MSPerson*> Helper::myRemoteControlledPersons;
 
@@ -188,22 +173,50 @@ Helper::getLaneChecking(const std::string& edgeID, int laneIndex, double pos) {
 
 std::pair<MSLane*, double>
 Helper::convertCartesianToRoadMap(Position pos) {
-    /// XXX use rtree instead
-    std::pair<MSLane*, double> result;
-    std::vector<std::string> allEdgeIds;
+    // build the look-up tree if not yet existing
+    if (myLaneSegmentTree == 0) {
+        myLaneSegmentTree = new LANE_RTREE_QUAL(&MSLane::visit);
+        for (const MSEdge* const edge : MSEdge::getAllEdges()) {
+            for (MSLane* const lane : edge->getLanes()) {
+                const PositionVector& shape = lane->getShape();
+                const int last = (int)shape.size() - 1;
+                for (int i = 0; i < MAX2(last, 1); i++) {
+                    Boundary b;
+                    b.add(shape[i]);
+                    b.add(shape[MIN2(i + 1, last)]);
+                    b.grow(POSITION_EPS);
+                    const float cmin[2] = {(float) b.xmin(), (float) b.ymin()};
+                    const float cmax[2] = {(float) b.xmax(), (float) b.ymax()};
+                    myLaneSegmentTree->Insert(cmin, cmax, lane);
+                }
+            }
+        }
+    }
+    // search in growing squares around the position; the closest candidate is the
+    //  closest lane as soon as it is not farther away than the half size of the square
+    std::pair<MSLane*, double> result(0, 0.);
     double minDistance = std::numeric_limits<double>::max();
-
-    allEdgeIds = MSNet::getInstance()->getEdgeControl().getEdgeNames();
-    for (std::vector<std::string>::iterator itId = allEdgeIds.begin(); itId != allEdgeIds.end(); itId++) {
-        const std::vector<MSLane*>& allLanes = MSEdge::dictionary((*itId))->getLanes();
-        for (std::vector<MSLane*>::const_iterator itLane = allLanes.begin(); itLane != allLanes.end(); itLane++) {
-            const double newDistance = (*itLane)->getShape().distance2D(pos);
-            if (newDistance < minDistance) {
+    std::set<const MSLane*> candidates;
+    for (double range = 10.; result.first == 0 || minDistance > range; range *= 2.) {
+        if ((int)candidates.size() == MSLane::dictSize()) {
+            break;
+        }
+        const float cmin[2] = {(float)(pos.x() - range), (float)(pos.y() - range)};
+        const float cmax[2] = {(float)(pos.x() + range), (float)(pos.y() + range)};
+        candidates.clear();
+        LaneStoringVisitor sv(candidates);
+        myLaneSegmentTree->Search(cmin, cmax, sv);
+        for (const MSLane* const lane : candidates) {
+            const double newDistance = lane->getShape().distance2D(pos);
+            if (newDistance < minDistance || (newDistance == minDistance && lane->getNumericalID() < result.first->getNumericalID())) {
                 minDistance = newDistance;
-                result.first = (*itLane);
+                result.first = const_cast<MSLane*>(lane);
             }
         }
     }
+    if (result.first == 0) {
+        throw TraCIException("No lane found for position " + toString(pos) + ".");
+    }
     // @todo this may be a place where 3D is required but 2D is delivered
     result.second = result.first->getShape().nearest_offset_to_point2D(pos, false);
     return result;
@@ -217,6 +230,8 @@ Helper::cleanup() {
     myObjects.clear();
     delete myLaneTree;
     myLaneTree = 0;
+    delete myLaneSegmentTree;
+    myLaneSegmentTree = 0;
 }
 
 
@@ -230,12 +245,8 @@ Helper::collectObjectsInRange(int domain, const PositionVector& shape, double ra
                 break;
             case CMD_GET_EDGE_VARIABLE:
             case CMD_GET_LANE_VARIABLE:
-            case CMD_GET_PERSON_VARIABLE:
-            case CMD_GET_VEHICLE_VARIABLE:
                 myObjects[CMD_GET_EDGE_VARIABLE] = 0;
                 myObjects[CMD_GET_LANE_VARIABLE] = 0;
-                myObjects[CMD_GET_PERSON_VARIABLE] = 0;
-                myObjects[CMD_GET_VEHICLE_VARIABLE] = 0;
                 myLaneTree = new LANE_RTREE_QUAL(&MSLane::visit);
                 MSLane::fill(*myLaneTree);
                 break;
@@ -265,13 +276,32 @@ Helper::collectObjectsInRange(int domain, const PositionVector& shape, double ra
         }
         break;
         case CMD_GET_EDGE_VARIABLE:
-        case CMD_GET_LANE_VARIABLE:
-        case CMD_GET_PERSON_VARIABLE:
-        case CMD_GET_VEHICLE_VARIABLE: {
+        case CMD_GET_LANE_VARIABLE: {
             LaneStoringVisitor sv(into, shape, range, domain);
             myLaneTree->Search(cmin, cmax, sv);
         }
         break;
+        case CMD_GET_VEHICLE_VARIABLE: {
+            // the grid is shared by all queries of the step
+            std::vector<MSPositionGrid::VehicleEntry> vehicles;
+            MSNet::getInstance()->getPositionGrid().getVehicles(b, vehicles);
+            for (std::vector<MSPositionGrid::VehicleEntry>::const_iterator j = vehicles.begin(); j != vehicles.end(); ++j) {
+                if (shape.distance2D(j->second) <= range) {
+                    into.insert(j->first->getID());
+                }
+            }
+        }
+        break;
+        case CMD_GET_PERSON_VARIABLE: {
+            std::vector<MSPositionGrid::PersonEntry> persons;
+            MSNet::getInstance()->getPositionGrid().getPersons(b, persons);
+            for (std::vector<MSPositionGrid::PersonEntry>::const_iterator j = persons.begin(); j != persons.end(); ++j) {
+                if (shape.distance2D(j->second) <= range) {
+                    into.insert(j->first->getID());
+                }
+            }
+        }
+        break;
         default:
             break;
     }
@@ -51,7 +51,11 @@ public:
     /// @brief Constructor
     LaneStoringVisitor(std::set<std::string>& ids, const PositionVector& shape,
                        const double range, const int domain)
-        : myIDs(ids), myShape(shape), myRange(range), myDomain(domain) {}
+        : myIDs(&ids), myLanes(0), myShape(&shape), myRange(range), myDomain(domain) {}
+
+    /// @brief Constructor for collecting the visited lanes themselves
+    LaneStoringVisitor(std::set<const MSLane*>& lanes)
+        : myIDs(0), myLanes(&lanes), myShape(0), myRange(0.), myDomain(-1) {}
 
     /// @brief Destructor
     ~LaneStoringVisitor() {}
@@ -60,8 +64,9 @@ public:
     void add(const MSLane* const l) const;
 
     /// @brief The container
-    std::set<std::string>& myIDs;
-    const PositionVector& myShape;
+    std::set<std::string>* const myIDs;
+    std::set<const MSLane*>* const myLanes;
+    const PositionVector* const myShape;
     const double myRange;
     const int myDomain;
 
@@ -223,6 +228,9 @@ private:
     /// @brief A storage of lanes
     static LANE_RTREE_QUAL* myLaneTree;
 
+    /// @brief A storage of lanes with one entry per shape segment (for finding the closest lane)
+    static LANE_RTREE_QUAL* myLaneSegmentTree;
+
     static std::map<std::string, MSVehicle*> myRemoteControlledVehicles;
     static std::map<std::string, MSPerson*> myRemoteControlledPersons;
 
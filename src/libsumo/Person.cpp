@@ -346,6 +346,8 @@ Person::removeStage(const std::string& personID, int nextStageIndex) {
         throw TraCIException("The stage index may not be negative.");
     }
     p->removeStage(nextStageIndex);
+    // removing the current stage may move or remove the person
+    MSNet::getInstance()->invalidatePositionGrid();
 }
 
 
@@ -507,6 +509,7 @@ Person::moveToXY(const std::string& personID, const std::string& edgeID, const d
         switch (p->getStageType(0)) {
             case MSTransportable::MOVING_WITHOUT_VEHICLE: {
                 Helper::setRemoteControlled(p, pos, lane, lanePos, lanePosLat, angle, routeOffset, edges, MSNet::getInstance()->getCurrentTimeStep());
+                MSNet::getInstance()->invalidatePositionGrid();
                 break;
             }
             default:
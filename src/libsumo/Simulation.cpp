@@ -41,6 +41,7 @@
 #include <microsim/MSVehicle.h>
 #include <microsim/MSVehicleControl.h>
 #include <microsim/MSStateHandler.h>
+#include <microsim/MSStepProfiler.h>
 #include <microsim/MSStoppingPlace.h>
 #include <microsim/devices/MSDevice_Routing.h>
 #include <netload/NLBuilder.h>
@@ -147,6 +148,20 @@ Simulation::getMinExpectedNumber() {
 }
 
 
+double
+Simulation::getStepProfile(const std::string& phase) {
+    const MSStepProfiler& profiler = MSNet::getInstance()->getStepProfiler();
+    if (phase == "") {
+        return profiler.getLastStepDuration();
+    }
+    const MSStepProfiler::Phase p = MSStepProfiler::getPhase(phase);
+    if (p == MSStepProfiler::PHASE_NUMBER) {
+        throw TraCIException("Unknown step phase '" + phase + "'.");
+    }
+    return profiler.getLastStepDuration(p);
+}
+
+
 TraCIStage
 Simulation::findRoute(const std::string& from, const std::string& to, const std::string& typeID, const SUMOTime depart, const int routingMode) {
     TraCIStage result(MSTransportable::DRIVING);
@@ -69,6 +69,8 @@ public:
 
     static int getMinExpectedNumber();
 
+    static double getStepProfile(const std::string& phase = "");
+
     static TraCIStage findRoute(const std::string& from, const std::string& to, const std::string& typeID, const SUMOTime depart, const int routingMode);
 
     static std::vector<TraCIStage> findIntermodalRoute(const std::string& from, const std::string& to, const std::string& modes="",
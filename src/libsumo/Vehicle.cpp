@@ -949,6 +949,7 @@ Vehicle::moveToXY(const std::string& vehicleID, const std::string& edgeID, const
             MSNet::getInstance()->getInsertionControl().alreadyDeparted(veh);
 
         }
+        MSNet::getInstance()->invalidatePositionGrid();
     } else {
         if (lane == 0) {
             throw TraCIException("Could not map vehicle '" + vehicleID + "' no road found within " + toString(maxRouteDistance) + "m.");
@@ -1147,6 +1148,8 @@ Vehicle::moveTo(const std::string& vehicleID, const std::string& laneID, double
     }
     l->forceVehicleInsertion(veh, position,
                              veh->hasDeparted() ? MSMoveReminder::NOTIFICATION_TELEPORT : MSMoveReminder::NOTIFICATION_DEPARTED);
+    // context subscriptions have to find the vehicle at its new position
+    MSNet::getInstance()->invalidatePositionGrid();
 }
 
 
@@ -1213,6 +1216,7 @@ Vehicle::remove(const std::string& vehicleID, char reason) {
         MSNet::getInstance()->getInsertionControl().alreadyDeparted(veh);
         MSNet::getInstance()->getVehicleControl().deleteVehicle(veh, true);
     }
+    MSNet::getInstance()->invalidatePositionGrid();
 }
 
 
@@ -188,22 +188,49 @@ ROMAAssignments::addRoute(ConstROEdgeVector& edges, std::vector<RORoute*>& paths
 
 void
 ROMAAssignments::getKPaths(const int kPaths, const double penalty) {
-    for (std::vector<ODCell*>::const_iterator i = myMatrix.getCells().begin(); i != myMatrix.getCells().end(); ++i) {
-        ODCell* c = *i;
+    if (kPaths <= 0) {
+        return;
+    }
+    std::vector<ODCell*>::const_iterator i = myMatrix.getCells().begin();
+    while (i != myMatrix.getCells().end()) {
+        // the first paths do not depend on penalties, so all cells with the same origin share the search
         myPenalties.clear();
-        for (int k = 0; k < kPaths; k++) {
-            ConstROEdgeVector edges;
-            myRouter.compute(myNet.getEdge(c->origin + "-source"), myNet.getEdge(c->destination + "-sink"), myDefaultVehicle, 0, edges);
-            for (ConstROEdgeVector::iterator e = edges.begin(); e != edges.end(); e++) {
-                myPenalties[*e] = penalty;
+        std::vector<ConstROEdgeVector> firstPaths;
+        const std::vector<ODCell*>::const_iterator originEnd = computeOriginRoutes(i, 0, firstPaths);
+        for (int index = 0; i != originEnd; ++i, ++index) {
+            ODCell* c = *i;
+            myPenalties.clear();
+            for (int k = 0; k < kPaths; k++) {
+                ConstROEdgeVector edges;
+                if (k == 0) {
+                    edges = firstPaths[index];
+                } else {
+                    myRouter.compute(myNet.getEdge(c->origin + "-source"), myNet.getEdge(c->destination + "-sink"), myDefaultVehicle, 0, edges);
+                }
+                for (ConstROEdgeVector::iterator e = edges.begin(); e != edges.end(); e++) {
+                    myPenalties[*e] = penalty;
+                }
+                addRoute(edges, c->pathsVector, c->origin + c->destination + toString(c->pathsVector.size()), 0);
             }
-            addRoute(edges, c->pathsVector, c->origin + c->destination + toString(c->pathsVector.size()), 0);
         }
     }
     myPenalties.clear();
 }
 
 
+std::vector<ODCell*>::const_iterator
+ROMAAssignments::computeOriginRoutes(std::vector<ODCell*>::const_iterator first, const SUMOTime begin, std::vector<ConstROEdgeVector>& into) {
+    std::vector<const ROEdge*> sinks;
+    std::vector<ODCell*>::const_iterator last = first;
+    while (last != myMatrix.getCells().end() && (*last)->origin == (*first)->origin) {
+        sinks.push_back(myNet.getEdge((*last)->destination + "-sink"));
+        ++last;
+    }
+    myRouter.computeOneToMany(myNet.getEdge((*first)->origin + "-source"), sinks, myDefaultVehicle, begin, into);
+    return last;
+}
+
+
 void
 ROMAAssignments::resetFlows() {
     const double begin = STEPS2TIME(MIN2(myBegin, myMatrix.getCells().front()->begin));
@@ -390,11 +417,14 @@ ROMAAssignments::sue(const int maxOuterIteration, const int maxInnerIteration, c
         // check for a new route, if none available, break
         // several modifications about when a route is new and when to break are in the original script
         bool newRoute = false;
-        for (std::vector<ODCell*>::const_iterator i = myMatrix.getCells().begin(); i != myMatrix.getCells().end(); ++i) {
-            ODCell* c = *i;
-            ConstROEdgeVector edges;
-            myRouter.compute(myNet.getEdge(c->origin + "-source"), myNet.getEdge(c->destination + "-sink"), myDefaultVehicle, 0, edges);
-            newRoute |= addRoute(edges, c->pathsVector, c->origin + c->destination + toString(c->pathsVector.size()), 0);
+        std::vector<ODCell*>::const_iterator i = myMatrix.getCells().begin();
+        while (i != myMatrix.getCells().end()) {
+            std::vector<ConstROEdgeVector> paths;
+            const std::vector<ODCell*>::const_iterator originEnd = computeOriginRoutes(i, 0, paths);
+            for (int index = 0; i != originEnd; ++i, ++index) {
+                ODCell* c = *i;
+                newRoute |= addRoute(paths[index], c->pathsVector, c->origin + c->destination + toString(c->pathsVector.size()), 0);
+            }
         }
         if (!newRoute) {
             break;
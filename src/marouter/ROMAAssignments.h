@@ -129,6 +129,14 @@ private:
     /// @brief get the k shortest paths
     void getKPaths(const int kPaths, const double penalty);
 
+    /** @brief computes the routes for the given cell and all following cells with the same origin using a single query
+     * @param[in] first The first cell to compute the route for
+     * @param[in] begin The departure time
+     * @param[filled] into The routes, one for each cell
+     * @return the first cell with a different origin
+     */
+    std::vector<ODCell*>::const_iterator computeOriginRoutes(std::vector<ODCell*>::const_iterator first, const SUMOTime begin, std::vector<ConstROEdgeVector>& into);
+
 private:
     const SUMOTime myBegin;
     const SUMOTime myEnd;
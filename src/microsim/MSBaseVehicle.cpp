@@ -151,6 +151,16 @@ MSBaseVehicle::getEdge() const {
 
 void
 MSBaseVehicle::reroute(SUMOTime t, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, const bool onInit, const bool withTaz) {
+    ConstMSEdgeVector legs;
+    getRerouteLegs(onInit, withTaz, legs);
+    ConstMSEdgeVector edges;
+    computeReroute(t, router, legs, edges);
+    applyReroute(edges, legs, onInit);
+}
+
+
+void
+MSBaseVehicle::getRerouteLegs(const bool onInit, const bool withTaz, ConstMSEdgeVector& legs) const {
     // check whether to reroute
     const MSEdge* source = withTaz && onInit ? MSEdge::dictionary(myParameter->fromTaz + "-source") : getRerouteOrigin();
     if (source == 0) {
@@ -160,7 +170,6 @@ MSBaseVehicle::reroute(SUMOTime t, SUMOAbstractRouter<MSEdge, SUMOVehicle>& rout
     if (sink == 0) {
         sink = myRoute->getLastEdge();
     }
-    ConstMSEdgeVector edges;
     ConstMSEdgeVector stops;
     if (myParameter->via.size() == 0) {
         stops = getStopEdges();
@@ -176,41 +185,61 @@ MSBaseVehicle::reroute(SUMOTime t, SUMOAbstractRouter<MSEdge, SUMOVehicle>& rout
             stops.push_back(viaEdge);
         }
     }
-
+    legs.push_back(source);
     for (MSRouteIterator s = stops.begin(); s != stops.end(); ++s) {
-        if (*s != source) {
-            // !!! need to adapt t here
-            ConstMSEdgeVector into;
-            router.compute(source, *s, this, t, into);
-            if (into.size() > 0) {
-                into.pop_back();
-                edges.insert(edges.end(), into.begin(), into.end());
+        if (*s != legs.back()) {
+            legs.push_back(*s);
+        }
+    }
+    legs.push_back(sink);
+}
+
+
+void
+MSBaseVehicle::computeReroute(SUMOTime t, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, const ConstMSEdgeVector& legs, ConstMSEdgeVector& edges) const {
+    computeRoute(*this, t, router, legs, edges);
+}
+
+
+void
+MSBaseVehicle::computeRoute(const SUMOVehicle& veh, SUMOTime t, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, const ConstMSEdgeVector& legs, ConstMSEdgeVector& edges) {
+    // all but the last leg end at a stop
+    for (int i = 1; i < (int)legs.size() - 1; i++) {
+        // !!! need to adapt t here
+        ConstMSEdgeVector into;
+        router.compute(legs[i - 1], legs[i], &veh, t, into);
+        if (into.size() > 0) {
+            into.pop_back();
+            edges.insert(edges.end(), into.begin(), into.end());
+        } else {
+            std::string error = "Vehicle '" + veh.getID() + "' has no valid route from edge '" + legs[i - 1]->getID() + "' to stop edge '" + legs[i]->getID() + "'.";
+            if (MSGlobals::gCheckRoutes) {
+                throw ProcessError(error);
             } else {
-                std::string error = "Vehicle '" + getID() + "' has no valid route from edge '" + source->getID() + "' to stop edge '" + (*s)->getID() + "'.";
-                if (MSGlobals::gCheckRoutes) {
-                    throw ProcessError(error);
-                } else {
-                    WRITE_WARNING(error);
-                    edges.push_back(source);
-                }
+                WRITE_WARNING(error);
+                edges.push_back(legs[i - 1]);
             }
-            source = *s;
         }
     }
-    router.compute(source, sink, this, t, edges);
+    router.compute(legs[legs.size() - 2], legs.back(), &veh, t, edges);
     if (!edges.empty() && edges.front()->isTazConnector()) {
         edges.erase(edges.begin());
     }
     if (!edges.empty() && edges.back()->isTazConnector()) {
         edges.pop_back();
     }
+}
+
+
+void
+MSBaseVehicle::applyReroute(ConstMSEdgeVector& edges, const ConstMSEdgeVector& legs, const bool onInit) {
     replaceRouteEdges(edges, onInit);
     // this must be called even if the route could not be replaced
     if (onInit) {
         if (edges.empty()) {
             if (MSGlobals::gCheckRoutes) {
                 throw ProcessError("Vehicle '" + getID() + "' has no valid route.");
-            } else if (source->isTazConnector()) {
+            } else if (legs[legs.size() - 2]->isTazConnector()) {
                 WRITE_WARNING("Removing vehicle '" + getID() + "' which has no valid route.");
                 MSNet::getInstance()->getInsertionControl().descheduleDeparture(this);
                 return;
@@ -34,6 +34,7 @@
 #include <set>
 #include <utils/vehicle/SUMOVehicle.h>
 #include <utils/common/StdDefs.h>
+#include <utils/common/MemoryPool.h>
 #include "MSRoute.h"
 #include "MSMoveReminder.h"
 #include "MSVehicleType.h"
@@ -78,6 +79,18 @@ public:
     virtual ~MSBaseVehicle();
 
 
+    /// @brief Allocates the memory for a vehicle from the memory pool
+    static void* operator new(std::size_t size) {
+        return MemoryPool<MSBaseVehicle>::allocate(size);
+    }
+
+
+    /// @brief Gives the memory of a vehicle back to the memory pool
+    static void operator delete(void* p, std::size_t size) {
+        MemoryPool<MSBaseVehicle>::deallocate(p, size);
+    }
+
+
     /// Returns the name of the vehicle
     const std::string& getID() const;
 
@@ -204,6 +217,34 @@ public:
     void reroute(SUMOTime t, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, const bool onInit = false, const bool withTaz = false);
 
 
+    /** @brief Collects the edges a rerouting has to pass (origin, stops or via edges and destination)
+     * @see SUMOVehicle::getRerouteLegs
+     */
+    void getRerouteLegs(const bool onInit, const bool withTaz, ConstMSEdgeVector& legs) const;
+
+
+    /** @brief Computes the route along the given legs without changing the vehicle
+     *
+     * This only reads the vehicle class and speed information of the vehicle.
+     * @see SUMOVehicle::computeReroute
+     */
+    void computeReroute(SUMOTime t, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, const ConstMSEdgeVector& legs, ConstMSEdgeVector& edges) const;
+
+
+    /** @brief Computes the route of the given vehicle along the given legs
+     *
+     * This is the implementation of computeReroute which only needs the
+     *  routing related information (id, class and speeds) of the vehicle.
+     */
+    static void computeRoute(const SUMOVehicle& veh, SUMOTime t, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, const ConstMSEdgeVector& legs, ConstMSEdgeVector& edges);
+
+
+    /** @brief Replaces the current route by the result of computeReroute
+     * @see SUMOVehicle::applyReroute
+     */
+    void applyReroute(ConstMSEdgeVector& edges, const ConstMSEdgeVector& legs, const bool onInit);
+
+
     /** @brief Replaces the current route by the given edges
      *
      * It is possible that the new route is not accepted, if a) it does not
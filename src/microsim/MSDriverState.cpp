@@ -104,11 +104,11 @@ MSDriverState::OUProcess::~OUProcess() {}
 
 
 void
-MSDriverState::OUProcess::step(double dt) {
+MSDriverState::OUProcess::step(double dt, std::mt19937* rng) {
 #ifdef DEBUG_OUPROCESS
     const double oldstate = myState;
 #endif
-    myState = exp(-dt/myTimeScale)*myState + myNoiseIntensity*sqrt(2*dt/myTimeScale)*RandHelper::randNorm(0, 1);
+    myState = exp(-dt/myTimeScale)*myState + myNoiseIntensity*sqrt(2*dt/myTimeScale)*RandHelper::randNorm(0, 1, rng);
 #ifdef DEBUG_OUPROCESS
     std::cout << "  step (" << dt << " s.): " << oldstate << "->" << myState << std::endl;
 #endif
@@ -274,7 +274,7 @@ MSDriverState::updateErrorProcess(OUProcess& errorProcess, double timeScaleCoeff
     } else {
         errorProcess.setTimeScale(timeScaleCoefficient/myCurrentDrivingDifficulty);
         errorProcess.setNoiseIntensity(myCurrentDrivingDifficulty*noiseIntensityCoefficient);
-        errorProcess.step(myStepDuration);
+        errorProcess.step(myStepDuration, myVehicle->getRNG());
     }
 }
 
@@ -27,6 +27,7 @@
 #endif
 
 #include <memory>
+#include <random>
 #include <utils/common/SUMOTime.h>
 #include <utils/xml/SUMOXMLDefinitions.h>
 
@@ -124,8 +125,8 @@ protected:
         /// @brief destructor
         ~OUProcess();
 
-        /// @brief evolve for a time step of length dt.
-        void step(double dt);
+        /// @brief evolve for a time step of length dt using the given random number generator (0 for the default one).
+        void step(double dt, std::mt19937* rng = 0);
 
         /// @brief set the process' timescale to a new value
         void setTimeScale(double timeScale) {
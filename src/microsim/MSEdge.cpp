@@ -36,6 +36,7 @@
 #include <cassert>
 #include <utils/common/StringTokenizer.h>
 #include <utils/options/OptionsCont.h>
+#include <utils/vehicle/SuccessorGraph.h>
 #include <microsim/devices/MSDevice_Routing.h>
 #include <mesosim/MELoop.h>
 #include <mesosim/MESegment.h>
@@ -242,6 +243,13 @@ MSEdge::allowsLaneChanging() {
 
 void
 MSEdge::rebuildAllowedLanes() {
+#ifdef HAVE_FOX
+    // the look-ahead routing runs across simulation steps and must not see the lanes change
+    MSDevice_Routing::waitForLookahead();
+    if (MSDevice_Routing::isParallel()) {
+        MSDevice_Routing::lock();
+    }
+#endif
     // clear myClassedAllowed.
     // it will be rebuilt on demand
     for (ClassedAllowedLanesCont::iterator i2 = myClassedAllowed.begin(); i2 != myClassedAllowed.end(); i2++) {
@@ -251,6 +259,8 @@ MSEdge::rebuildAllowedLanes() {
     }
     myClassedAllowed.clear();
     myClassesSuccessorMap.clear();
+    // the routers need to rebuild their successor graphs
+    SuccessorGraph<MSEdge>::permissionsChanged();
     // rebuild myMinimumPermissions and myCombinedPermissions
     myMinimumPermissions = SVCAll;
     myCombinedPermissions = 0;
@@ -258,6 +268,11 @@ MSEdge::rebuildAllowedLanes() {
         myMinimumPermissions &= (*i)->getPermissions();
         myCombinedPermissions |= (*i)->getPermissions();
     }
+#ifdef HAVE_FOX
+    if (MSDevice_Routing::isParallel()) {
+        MSDevice_Routing::unlock();
+    }
+#endif
 }
 
 
@@ -614,6 +629,12 @@ MSEdge::insertVehicle(SUMOVehicle& v, SUMOTime time, const bool checkOnly, const
         }
         return false;
     }
+    if (!forceCheck && myLastFailedInsertionTime == time && myFailedInsertionMemory.size() == myLanes->size()
+            && pars.departLaneProcedure != DEPART_LANE_RANDOM && pars.departLaneProcedure != DEPART_LANE_BEST_FREE) {
+        // all lanes already rejected a vehicle in this timestep, no need to choose one
+        // (random and best lanes are still determined for the random number sequence and the best lanes cache)
+        return false;
+    }
     MSLane* insertionLane = getDepartLane(static_cast<MSVehicle&>(v));
     if (insertionLane == 0) {
         return false;
@@ -789,9 +810,12 @@ MSEdge::clear() {
 
 void
 MSEdge::insertIDs(std::vector<std::string>& into) {
+    const int offset = (int)into.size();
+    into.reserve(offset + myDict.size());
     for (DictType::iterator i = myDict.begin(); i != myDict.end(); ++i) {
         into.push_back((*i).first);
     }
+    std::sort(into.begin() + offset, into.end());
 }
 
 
@@ -33,6 +33,7 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <string>
 #include <iostream>
 #include <utils/common/Named.h>
@@ -430,6 +431,13 @@ public:
         return MSNet::getInstance()->getTravelTime(edge, veh, time);
     }
 
+    /** @brief Returns the travel time for the given vehicle and time as used by the routers
+     * @see getTravelTimeStatic
+     */
+    inline double getTravelTime(const SUMOVehicle* const veh, double time) const {
+        return getTravelTimeStatic(this, veh, time);
+    }
+
     /** @brief Returns the averaged speed used by the routing device
      */
     double getRoutingSpeed() const;
@@ -670,7 +678,7 @@ public:
     /** @brief Clears the dictionary */
     static void clear();
 
-    /** @brief Inserts IDs of all known edges into the given vector */
+    /** @brief Inserts IDs of all known edges into the given vector (sorted) */
     static void insertIDs(std::vector<std::string>& into);
 
 
@@ -843,8 +851,8 @@ protected:
     /// @name Static edge container
     /// @{
 
-    /// @brief definition of the static dictionary type
-    typedef std::map< std::string, MSEdge* > DictType;
+    /// @brief definition of the static dictionary type (unordered, use insertIDs for sorted access)
+    typedef std::unordered_map< std::string, MSEdge* > DictType;
 
     /** @brief Static dictionary to associate string-ids with objects.
      * @deprecated Move to MSEdgeControl, make non-static
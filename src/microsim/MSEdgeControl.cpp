@@ -43,6 +43,7 @@
 MSEdgeControl::MSEdgeControl(const std::vector< MSEdge* >& edges)
     : myEdges(edges),
       myLanes(MSLane::dictSize()),
+      myAmActive(MSLane::dictSize(), false),
       myLastLaneChange(MSEdge::dictSize()) {
     // build the usage definitions for lanes
     for (std::vector< MSEdge* >::const_iterator i = myEdges.begin(); i != myEdges.end(); ++i) {
@@ -52,7 +53,6 @@ MSEdgeControl::MSEdgeControl(const std::vector< MSEdge* >& edges)
             myLanes[pos].lane = *(lanes.begin());
             myLanes[pos].firstNeigh = lanes.end();
             myLanes[pos].lastNeigh = lanes.end();
-            myLanes[pos].amActive = false;
             myLanes[pos].haveNeighbors = false;
         } else {
             for (std::vector<MSLane*>::const_iterator j = lanes.begin(); j != lanes.end(); ++j) {
@@ -60,12 +60,18 @@ MSEdgeControl::MSEdgeControl(const std::vector< MSEdge* >& edges)
                 myLanes[pos].lane = *j;
                 myLanes[pos].firstNeigh = (j + 1);
                 myLanes[pos].lastNeigh = lanes.end();
-                myLanes[pos].amActive = false;
                 myLanes[pos].haveNeighbors = true;
             }
             myLastLaneChange[(*i)->getNumericalID()] = -1;
         }
     }
+#ifdef HAVE_FOX
+    if (MSGlobals::gNumSimThreads > 1) {
+        while (myThreadPool.size() < MSGlobals::gNumSimThreads) {
+            new FXWorkerThread(myThreadPool);
+        }
+    }
+#endif
 }
 
 
@@ -76,31 +82,78 @@ MSEdgeControl::~MSEdgeControl() {
 void
 MSEdgeControl::patchActiveLanes() {
     for (std::set<MSLane*, Named::ComparatorIdLess>::iterator i = myChangedStateLanes.begin(); i != myChangedStateLanes.end(); ++i) {
-        LaneUsage& lu = myLanes[(*i)->getNumericalID()];
         // if the lane was inactive but is now...
-        if (!lu.amActive && (*i)->getVehicleNumber() > 0) {
+        if (!myAmActive[(*i)->getNumericalID()] && (*i)->getVehicleNumber() > 0) {
             // ... add to active lanes and mark as such
-            if (lu.haveNeighbors) {
-                myActiveLanes.push_front(*i);
-            } else {
-                myActiveLanes.push_back(*i);
-            }
-            lu.amActive = true;
+            addActiveLane(*i);
         }
     }
     myChangedStateLanes.clear();
+    updateActiveLanes();
 }
 
+
+void
+MSEdgeControl::addActiveLane(MSLane* const lane) {
+    myAmActive[lane->getNumericalID()] = true;
+    if (myLanes[lane->getNumericalID()].haveNeighbors) {
+        myActivatedFront.push_back(lane);
+    } else {
+        myActivatedBack.push_back(lane);
+    }
+}
+
+
+void
+MSEdgeControl::updateActiveLanes() {
+    if (!myActivatedFront.empty()) {
+        // the lanes activated last come first
+        myActiveLanes.insert(myActiveLanes.begin(), myActivatedFront.rbegin(), myActivatedFront.rend());
+        myActivatedFront.clear();
+    }
+    if (!myActivatedBack.empty()) {
+        myActiveLanes.insert(myActiveLanes.end(), myActivatedBack.begin(), myActivatedBack.end());
+        myActivatedBack.clear();
+    }
+}
+
+
 void
 MSEdgeControl::planMovements(SUMOTime t) {
-    for (std::list<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end();) {
+#ifdef HAVE_FOX
+    MSLane::setParallelPlanMovements(MSGlobals::gNumSimThreads > 1);
+#endif
+    std::deque<MSLane*>::iterator last = myActiveLanes.begin();
+    for (std::deque<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
         if ((*i)->getVehicleNumber() == 0) {
-            myLanes[(*i)->getNumericalID()].amActive = false;
-            i = myActiveLanes.erase(i);
+            myAmActive[(*i)->getNumericalID()] = false;
+            continue;
+        }
+#ifdef HAVE_FOX
+        if (MSGlobals::gNumSimThreads > 1) {
+            myThreadPool.add((*i)->getPlanMoveTask(t), (*i)->getRNGIndex() % myThreadPool.size());
         } else {
             (*i)->planMovements(t);
-            ++i;
         }
+#else
+        (*i)->planMovements(t);
+#endif
+        *last++ = *i;
+    }
+    myActiveLanes.erase(last, myActiveLanes.end());
+#ifdef HAVE_FOX
+    if (MSGlobals::gNumSimThreads > 1) {
+        myThreadPool.waitAll(false);
+        MSLane::setParallelPlanMovements(false);
+    }
+#endif
+}
+
+
+void
+MSEdgeControl::setJunctionApproaches(SUMOTime t) {
+    for (MSLane* const lane : myActiveLanes) {
+        lane->setJunctionApproaches(t);
     }
 }
 
@@ -108,27 +161,21 @@ MSEdgeControl::planMovements(SUMOTime t) {
 void
 MSEdgeControl::executeMovements(SUMOTime t) {
     myWithVehicles2Integrate.clear();
-    for (std::list<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end();) {
+    std::deque<MSLane*>::iterator last = myActiveLanes.begin();
+    for (std::deque<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
         if ((*i)->getVehicleNumber() == 0 || (*i)->executeMovements(t, myWithVehicles2Integrate)) {
-            myLanes[(*i)->getNumericalID()].amActive = false;
-            i = myActiveLanes.erase(i);
+            myAmActive[(*i)->getNumericalID()] = false;
         } else {
-            ++i;
+            *last++ = *i;
         }
     }
+    myActiveLanes.erase(last, myActiveLanes.end());
     for (std::vector<MSLane*>::iterator i = myWithVehicles2Integrate.begin(); i != myWithVehicles2Integrate.end(); ++i) {
-        if ((*i)->integrateNewVehicle(t)) {
-            LaneUsage& lu = myLanes[(*i)->getNumericalID()];
-            if (!lu.amActive) {
-                if (lu.haveNeighbors) {
-                    myActiveLanes.push_front(*i);
-                } else {
-                    myActiveLanes.push_back(*i);
-                }
-                lu.amActive = true;
-            }
+        if ((*i)->integrateNewVehicle(t) && !myAmActive[(*i)->getNumericalID()]) {
+            addActiveLane(*i);
         }
     }
+    updateActiveLanes();
     if (MSGlobals::gLateralResolution > 0) {
         // multiple vehicle shadows may have entered an inactive lane and would
         // not be sorted otherwise
@@ -141,35 +188,28 @@ MSEdgeControl::executeMovements(SUMOTime t) {
 
 void
 MSEdgeControl::changeLanes(SUMOTime t) {
-    std::vector<MSLane*> toAdd;
-    for (std::list<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end();) {
-        LaneUsage& lu = myLanes[(*i)->getNumericalID()];
-        if (lu.haveNeighbors) {
-            MSEdge& edge = (*i)->getEdge();
-            if (myLastLaneChange[edge.getNumericalID()] != t) {
-                myLastLaneChange[edge.getNumericalID()] = t;
-                edge.changeLanes(t);
-                const std::vector<MSLane*>& lanes = edge.getLanes();
-                for (std::vector<MSLane*>::const_iterator i = lanes.begin(); i != lanes.end(); ++i) {
-                    LaneUsage& lu = myLanes[(*i)->getNumericalID()];
-                    //if ((*i)->getID() == "disabled") {
-                    //    std::cout << SIMTIME << " vehicles=" << toString((*i)->getVehiclesSecure()) << "\n";
-                    //    (*i)->releaseVehicles();
-                    //}
-                    if ((*i)->getVehicleNumber() > 0 && !lu.amActive) {
-                        toAdd.push_back(*i);
-                        lu.amActive = true;
-                    }
+    for (std::deque<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
+        if (!myLanes[(*i)->getNumericalID()].haveNeighbors) {
+            // lanes with neighbors come first, so we are done
+            break;
+        }
+        MSEdge& edge = (*i)->getEdge();
+        if (myLastLaneChange[edge.getNumericalID()] != t) {
+            myLastLaneChange[edge.getNumericalID()] = t;
+            edge.changeLanes(t);
+            const std::vector<MSLane*>& lanes = edge.getLanes();
+            for (std::vector<MSLane*>::const_iterator j = lanes.begin(); j != lanes.end(); ++j) {
+                //if ((*j)->getID() == "disabled") {
+                //    std::cout << SIMTIME << " vehicles=" << toString((*j)->getVehiclesSecure()) << "\n";
+                //    (*j)->releaseVehicles();
+                //}
+                if ((*j)->getVehicleNumber() > 0 && !myAmActive[(*j)->getNumericalID()]) {
+                    addActiveLane(*j);
                 }
             }
-            ++i;
-        } else {
-            i = myActiveLanes.end();
         }
     }
-    for (std::vector<MSLane*>::iterator i = toAdd.begin(); i != toAdd.end(); ++i) {
-        myActiveLanes.push_front(*i);
-    }
+    updateActiveLanes();
     if (MSGlobals::gLateralResolution > 0) {
         // sort maneuver reservations
         for (LaneUsageVector::iterator it = myLanes.begin(); it != myLanes.end(); ++it) {
@@ -182,7 +222,7 @@ MSEdgeControl::changeLanes(SUMOTime t) {
 void
 MSEdgeControl::detectCollisions(SUMOTime timestep, const std::string& stage) {
     // Detections is made by the edge's lanes, therefore hand over.
-    for (std::list<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
+    for (std::deque<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
         (*i)->detectCollisions(timestep, stage);
     }
 }
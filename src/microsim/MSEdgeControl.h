@@ -32,6 +32,7 @@
 #include <config.h>
 #endif
 
+#include <deque>
 #include <vector>
 #include <map>
 #include <string>
@@ -41,6 +42,10 @@
 #include <utils/common/SUMOTime.h>
 #include <utils/common/Named.h>
 
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXWorkerThread.h>
+#endif
+
 
 // ===========================================================================
 // class declarations
@@ -98,15 +103,26 @@ public:
     /// @{
 
     /** @brief Compute safe velocities for all vehicles based on positions and
-     * speeds from the last time step. Also registers
-     * ApproachingVehicleInformation for all links
+     * speeds from the last time step.
      *
      * This method goes through all active lanes calling their "planMovements" method.
+     * If more than one simulation thread is used, the lanes are distributed
+     * over the threads such that all lanes sharing a random number generator
+     * are processed by the same thread in the order of myActiveLanes.
      * @see MSLane::planMovements
      */
     void planMovements(SUMOTime t);
 
 
+    /** @brief Register junction approaches for all vehicles after velocities
+     * have been planned. This is a prerequisite for executeMovements
+     *
+     * This method goes through all active lanes calling their "setJunctionApproaches" method.
+     * @see MSLane::setJunctionApproaches
+     */
+    void setJunctionApproaches(SUMOTime t);
+
+
     /** @brief Executes planned vehicle movements with regards to right-of-way
      *
      * This method goes through all active lanes calling their executeMovements
@@ -128,7 +144,8 @@ public:
      *
      * Calls "changeLanes" of each of the multi-lane edges. Check then for this
      *  edge whether a lane got active, adding it to "myActiveLanes" and marking
-     *  it as active in such cases.
+     *  it as active in such cases. Since lanes of multi-lane edges are at the front
+     *  of "myActiveLanes" the iteration stops at the first lane without neighbors.
      *
      * @see MSEdge::changeLanes
      */
@@ -195,8 +212,6 @@ public:
         std::vector<MSLane*>::const_iterator firstNeigh;
         /// @brief The end of this lane's edge's lane container
         std::vector<MSLane*>::const_iterator lastNeigh;
-        /// @brief Information whether this lane is active
-        bool amActive;
         /// @brief Information whether this lane belongs to a multi-lane edge
         bool haveNeighbors;
     };
@@ -211,8 +226,23 @@ private:
     /// @brief Information about lanes' number of vehicles and neighbors
     LaneUsageVector myLanes;
 
-    /// @brief The list of active (not empty) lanes
-    std::list<MSLane*> myActiveLanes;
+    /** @brief The active (not empty) lanes
+     *
+     * Lanes of multi-lane edges come first (the lane changing relies on this),
+     *  newly activated ones are added in front of them like in a list with push_front.
+     *  The deque makes this independent of the number of active lanes and is
+     *  compacted in place whenever lanes get inactive.
+     */
+    std::deque<MSLane*> myActiveLanes;
+
+    /// @brief Information whether a lane is active (indexed by the lane's numerical id)
+    std::vector<bool> myAmActive;
+
+    /// @brief Lanes of multi-lane edges which got active and still need to be added to myActiveLanes
+    std::vector<MSLane*> myActivatedFront;
+
+    /// @brief Lanes of single-lane edges which got active and still need to be added to myActiveLanes
+    std::vector<MSLane*> myActivatedBack;
 
     /// @brief A storage for lanes which shall be integrated because vehicles have moved onto them
     std::vector<MSLane*> myWithVehicles2Integrate;
@@ -223,6 +253,18 @@ private:
     /// @brief The list of active (not empty) lanes
     std::vector<SUMOTime> myLastLaneChange;
 
+private:
+    /// @brief marks the lane as active, it is added to myActiveLanes by the next call to updateActiveLanes
+    void addActiveLane(MSLane* const lane);
+
+    /// @brief adds the lanes which got active since the last call to myActiveLanes
+    void updateActiveLanes();
+
+#ifdef HAVE_FOX
+    /// @brief the thread pool for parallel simulation
+    FXWorkerThread::Pool myThreadPool;
+#endif
+
 private:
     /// @brief Copy constructor.
     MSEdgeControl(const MSEdgeControl&);
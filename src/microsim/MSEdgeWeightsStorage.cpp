@@ -26,13 +26,15 @@
 #include <config.h>
 #endif
 
+#include "MSEdge.h"
 #include "MSEdgeWeightsStorage.h"
 
 
 // ===========================================================================
 // method definitions
 // ===========================================================================
-MSEdgeWeightsStorage::MSEdgeWeightsStorage() {
+MSEdgeWeightsStorage::MSEdgeWeightsStorage(const bool dense) :
+    myAmDense(dense) {
 }
 
 
@@ -42,6 +44,9 @@ MSEdgeWeightsStorage::~MSEdgeWeightsStorage() {
 
 bool
 MSEdgeWeightsStorage::retrieveExistingTravelTime(const MSEdge* const e, const double t, double& value) const {
+    if (myAmDense && myTravelTimeMatrix.isDense()) {
+        return myTravelTimeMatrix.retrieve(e->getNumericalID(), t, value);
+    }
     std::map<const MSEdge*, ValueTimeLine<double> >::const_iterator i = myTravelTimes.find(e);
     if (i == myTravelTimes.end()) {
         return false;
@@ -57,6 +62,9 @@ MSEdgeWeightsStorage::retrieveExistingTravelTime(const MSEdge* const e, const do
 
 bool
 MSEdgeWeightsStorage::retrieveExistingEffort(const MSEdge* const e, const double t, double& value) const {
+    if (myAmDense && myEffortMatrix.isDense()) {
+        return myEffortMatrix.retrieve(e->getNumericalID(), t, value);
+    }
     std::map<const MSEdge*, ValueTimeLine<double> >::const_iterator i = myEfforts.find(e);
     if (i == myEfforts.end()) {
         return false;
@@ -80,6 +88,9 @@ MSEdgeWeightsStorage::addTravelTime(const MSEdge* const e,
         i = myTravelTimes.find(e);
     }
     (*i).second.add(begin, end, value);
+    if (myAmDense) {
+        myTravelTimeMatrix.add(e->getNumericalID(), begin, end, value);
+    }
 }
 
 
@@ -93,6 +104,9 @@ MSEdgeWeightsStorage::addEffort(const MSEdge* const e,
         i = myEfforts.find(e);
     }
     (*i).second.add(begin, end, value);
+    if (myAmDense) {
+        myEffortMatrix.add(e->getNumericalID(), begin, end, value);
+    }
 }
 
 
@@ -102,6 +116,9 @@ MSEdgeWeightsStorage::removeTravelTime(const MSEdge* const e) {
     if (i != myTravelTimes.end()) {
         myTravelTimes.erase(i);
     }
+    if (myAmDense) {
+        myTravelTimeMatrix.remove(e->getNumericalID());
+    }
 }
 
 
@@ -111,6 +128,9 @@ MSEdgeWeightsStorage::removeEffort(const MSEdge* const e) {
     if (i != myEfforts.end()) {
         myEfforts.erase(i);
     }
+    if (myAmDense) {
+        myEffortMatrix.remove(e->getNumericalID());
+    }
 }
 
 
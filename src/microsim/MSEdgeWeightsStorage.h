@@ -29,6 +29,7 @@
 #endif
 
 #include <utils/common/ValueTimeLine.h>
+#include <utils/common/ValueTimeMatrix.h>
 
 
 // ===========================================================================
@@ -44,11 +45,17 @@ class SUMOVehicle;
 /**
  * @class MSEdgeWeightsStorage
  * @brief A storage for edge travel times and efforts
+ *
+ * A dense storage additionally keeps the values in a ValueTimeMatrix indexed by
+ *  the numerical edge id which avoids the map lookup for every edge during routing.
+ *  This pays off for the global storage which usually describes all edges.
  */
 class MSEdgeWeightsStorage {
 public:
-    /// @brief Constructor
-    MSEdgeWeightsStorage();
+    /** @brief Constructor
+     * @param[in] dense Whether a matrix over all edges shall be used for the lookup
+     */
+    MSEdgeWeightsStorage(const bool dense = false);
 
 
     /// @brief Destructor
@@ -124,6 +131,15 @@ private:
     /// @brief A map of edge->time->effort
     std::map<const MSEdge*, ValueTimeLine<double> > myEfforts;
 
+    /// @brief Whether the matrices are used
+    const bool myAmDense;
+
+    /// @brief The travel times by numerical edge id and time (if dense)
+    ValueTimeMatrix myTravelTimeMatrix;
+
+    /// @brief The efforts by numerical edge id and time (if dense)
+    ValueTimeMatrix myEffortMatrix;
+
 
 private:
     /// @brief Invalidated copy constructor.
@@ -30,24 +30,37 @@
 #endif
 
 #include <cassert>
+#include <algorithm>
 #include "MSEventControl.h"
 #include <utils/common/MsgHandler.h>
 #include <utils/common/Command.h>
 #include "MSNet.h"
 
 
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const int MSEventControl::WHEEL_SIZE = 4096;
+
+
 // ===========================================================================
 // member definitions
 // ===========================================================================
 MSEventControl::MSEventControl()
-    : currentTimeStep(-1), myEvents() {}
+    : currentTimeStep(-1), myWheel(WHEEL_SIZE), myCurrentBucket(0), myBucketWidth(MAX2(DELTA_T, (SUMOTime)1)),
+      myWheelEvents(0), myEvents(), myInsertionNumber(0) {}
 
 
 MSEventControl::~MSEventControl() {
     // delete the events
+    for (Bucket& bucket : myWheel) {
+        for (int i = bucket.next; i < (int)bucket.events.size(); i++) {
+            delete bucket.events[i].command;
+        }
+    }
     while (!myEvents.empty()) {
         Event e = myEvents.top();
-        delete e.first;
+        delete e.command;
         myEvents.pop();
     }
 }
@@ -55,21 +68,52 @@ MSEventControl::~MSEventControl() {
 
 void
 MSEventControl::addEvent(Command* operation, SUMOTime execTimeStep) {
-    myEvents.push(Event(operation, execTimeStep));
+    insert(Event(operation, execTimeStep, myInsertionNumber++));
+}
+
+
+void
+MSEventControl::insert(const Event& e) {
+    SUMOTime bucketNo = myCurrentBucket;
+    if (e.time >= 0) {
+        bucketNo = MAX2(bucketNo, getBucket(e.time));
+        if (bucketNo >= myCurrentBucket + WHEEL_SIZE) {
+            myEvents.push(e);
+            return;
+        }
+    }
+    Bucket& bucket = myWheel[bucketNo % WHEEL_SIZE];
+    if (bucket.sorted && (int)bucket.events.size() > bucket.next && EventSortCrit()(bucket.events.back(), e)) {
+        bucket.sorted = false;
+    }
+    bucket.events.push_back(e);
+    myWheelEvents++;
 }
 
 
 void
 MSEventControl::execute(SUMOTime execTime) {
     // Execute all events that are scheduled for execTime.
-    while (!myEvents.empty()) {
-        Event currEvent = myEvents.top();
-        if (currEvent.second < 0) {
-            currEvent.second = execTime;
-        }
-        if (currEvent.second < execTime + DELTA_T) {
-            Command* command = currEvent.first;
-            myEvents.pop();
+    const SUMOTime lastBucket = MAX2(myCurrentBucket, getBucket(execTime + DELTA_T - 1));
+    while (true) {
+        Bucket& bucket = myWheel[myCurrentBucket % WHEEL_SIZE];
+        while (bucket.next < (int)bucket.events.size()) {
+            if (!bucket.sorted) {
+                std::sort(bucket.events.begin() + bucket.next, bucket.events.end(), [](const Event & e1, const Event & e2) {
+                    return EventSortCrit()(e2, e1);
+                });
+                bucket.sorted = true;
+            }
+            Event currEvent = bucket.events[bucket.next];
+            if (currEvent.time < 0) {
+                currEvent.time = execTime;
+            }
+            if (currEvent.time >= execTime + DELTA_T) {
+                break;
+            }
+            bucket.next++;
+            myWheelEvents--;
+            Command* command = currEvent.command;
             SUMOTime time = 0;
             try {
                 time = command->execute(execTime);
@@ -84,23 +128,66 @@ MSEventControl::execute(SUMOTime execTime) {
                 if (time < 0) {
                     WRITE_WARNING("Command returned negative repeat number; will be deleted.");
                 }
-                delete currEvent.first;
+                delete currEvent.command;
             } else {
-                currEvent.second += time;
-                myEvents.push(currEvent);
+                currEvent.time += time;
+                currEvent.number = myInsertionNumber++;
+                insert(currEvent);
             }
-        } else {
+        }
+        if (bucket.next == (int)bucket.events.size()) {
+            bucket.events.clear();
+            bucket.next = 0;
+            bucket.sorted = true;
+        }
+        if (myCurrentBucket >= lastBucket) {
             break;
         }
+        if (myWheelEvents == 0) {
+            // skip the empty buckets
+            myCurrentBucket = myEvents.empty() ? lastBucket : MIN2(lastBucket, MAX2(myCurrentBucket + 1, getBucket(myEvents.top().time)));
+        } else {
+            myCurrentBucket++;
+        }
+        // move the events which are now covered by the wheel
+        while (!myEvents.empty() && getBucket(myEvents.top().time) < myCurrentBucket + WHEEL_SIZE) {
+            const Event e = myEvents.top();
+            myEvents.pop();
+            insert(e);
+        }
     }
 }
 
 
 bool
 MSEventControl::isEmpty() {
-    return myEvents.empty();
+    return myWheelEvents == 0 && myEvents.empty();
+}
+
+void
+MSEventControl::clearState(const SUMOTime currentTime, const SUMOTime newTime) {
+    std::vector<Event> events;
+    for (Bucket& bucket : myWheel) {
+        events.insert(events.end(), bucket.events.begin() + bucket.next, bucket.events.end());
+        bucket.events.clear();
+        bucket.next = 0;
+        bucket.sorted = true;
+    }
+    while (!myEvents.empty()) {
+        events.push_back(myEvents.top());
+        myEvents.pop();
+    }
+    myWheelEvents = 0;
+    myCurrentBucket = getBucket(newTime);
+    for (Event& e : events) {
+        if (e.time >= 0) {
+            e.time = MAX2(newTime, e.time - currentTime + newTime);
+        }
+        insert(e);
+    }
 }
 
+
 void
 MSEventControl::setCurrentTimeStep(SUMOTime time) {
     currentTimeStep = time;
@@ -50,11 +50,25 @@ class Command;
 /**
  * @class MSEventControl
  * @brief Stores time-dependant events and executes them at the proper time
+ *
+ * The events are kept in a time wheel with one bucket per simulation step,
+ *  events which lie further in the future than the wheel covers wait in a
+ *  priority queue until the wheel reaches them. Events are executed sorted
+ *  by their execution time, events with the same time in the order they were
+ *  added.
  */
 class MSEventControl {
 public:
-    /// @brief Combination of an event and the time it shall be executed at
-    typedef std::pair< Command*, SUMOTime > Event;
+    /// @brief Combination of an event, the time it shall be executed at and its insertion number
+    struct Event {
+        Event(Command* c, SUMOTime t, long long int n) : command(c), time(t), number(n) {}
+        /// @brief the command to execute
+        Command* command;
+        /// @brief the execution time
+        SUMOTime time;
+        /// @brief the insertion number (to keep the order of events with the same time)
+        long long int number;
+    };
 
 
 public:
@@ -111,30 +125,77 @@ public:
     void setCurrentTimeStep(SUMOTime time);
 
 
+    /** @brief Moves all pending events to run the simulation again from an earlier time
+     *
+     * The events keep their order and their distance to the current time.
+     *
+     * @param[in] currentTime The current simulation time
+     * @param[in] newTime The time the simulation continues with
+     */
+    void clearState(const SUMOTime currentTime, const SUMOTime newTime);
+
+
 protected:
     /** @brief Sort-criterion for events.
      *
-     * Sorts events by their execution time
+     * Sorts events by their execution time and insertion number
      */
     class EventSortCrit {
     public:
         /// @brief compares two events
         bool operator()(const Event& e1, const Event& e2) const {
-            return e1.second > e2.second;
+            return e1.time > e2.time || (e1.time == e2.time && e1.number > e2.number);
         }
     };
 
 
 private:
-    /// @brief Container for time-dependant events, e.g. traffic-light-change.
+    /// @brief The events of one step
+    struct Bucket {
+        Bucket() : next(0), sorted(true) {}
+        /// @brief the events (the ones before next were already executed)
+        std::vector<Event> events;
+        /// @brief the index of the next event to execute
+        int next;
+        /// @brief whether the events from next on are sorted
+        bool sorted;
+    };
+
+    /// @brief Container for events beyond the time wheel
     typedef std::priority_queue< Event, std::vector< Event >, EventSortCrit > EventCont;
 
+    /// @brief Adds the event to the wheel or the overflow queue
+    void insert(const Event& e);
+
+    /// @brief Returns the bucket number for the given time
+    inline SUMOTime getBucket(SUMOTime time) const {
+        return time / myBucketWidth;
+    }
+
     /// The current TimeStep
     SUMOTime currentTimeStep;
 
-    /// @brief Event-container, holds executable events.
+    /// @brief The time wheel
+    std::vector<Bucket> myWheel;
+
+    /// @brief The number of the bucket to execute next
+    SUMOTime myCurrentBucket;
+
+    /// @brief The time span covered by a bucket
+    const SUMOTime myBucketWidth;
+
+    /// @brief The number of events not yet executed in the wheel
+    int myWheelEvents;
+
+    /// @brief Event-container, holds events beyond the time wheel
     EventCont myEvents;
 
+    /// @brief The number of events added so far
+    long long int myInsertionNumber;
+
+    /// @brief The number of buckets in the wheel
+    static const int WHEEL_SIZE;
+
     /// get the Current TimeStep used in addEvent.
     SUMOTime getCurrentTimeStep();
 
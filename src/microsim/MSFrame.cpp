@@ -48,6 +48,7 @@
 #include <microsim/MSRoute.h>
 #include <microsim/MSNet.h>
 #include <microsim/MSGlobals.h>
+#include <microsim/MSIterativeAssignment.h>
 #include <microsim/lcmodels/MSAbstractLaneChangeModel.h>
 #include <microsim/devices/MSDevice.h>
 #include <microsim/devices/MSDevice_Vehroutes.h>
@@ -157,6 +158,12 @@ MSFrame::fillOptions() {
     oc.addSynonyme("summary-output", "summary");
     oc.addDescription("summary-output", "Output", "Save aggregated vehicle departure info into FILE");
 
+    oc.doRegister("step-profile-output", new Option_FileName());
+    oc.addDescription("step-profile-output", "Output", "Save the time spent in the phases of the simulation steps into FILE");
+
+    oc.doRegister("step-profile-output.period", new Option_String("60", "TIME"));
+    oc.addDescription("step-profile-output.period", "Output", "Aggregate the step profile over intervals of TIME length");
+
     oc.doRegister("tripinfo-output", new Option_FileName());
     oc.addSynonyme("tripinfo-output", "tripinfo");
     oc.addDescription("tripinfo-output", "Output", "Save single vehicle trip info into FILE");
@@ -324,6 +331,9 @@ MSFrame::fillOptions() {
     oc.doRegister("time-to-impatience", new Option_String("300", "TIME"));
     oc.addDescription("time-to-impatience", "Processing", "Specify how long a vehicle may wait until impatience grows from 0 to 1, defaults to 300, non-positive values disable impatience growth");
 
+    oc.doRegister("threads", new Option_Integer(1));
+    oc.addDescription("threads", "Processing", "Defines the number of threads for parallel simulation");
+
     oc.doRegister("default.action-step-length", new Option_Float(0.0));
     oc.addDescription("default.action-step-length", "Processing", "Length of the default interval length between action points for the car-following and lane-change models (in seconds). If not specified, the simulation step-length is used per default. Vehicle- or VType-specific settings override the default. Must be a multiple of the simulation step-length.");
 
@@ -346,7 +356,7 @@ MSFrame::fillOptions() {
     // generic routing options
     oc.doRegister("routing-algorithm", new Option_String("dijkstra"));
     oc.addDescription("routing-algorithm", "Routing",
-                      "Select among routing algorithms ['dijkstra', 'astar', 'CH', 'CHWrapper']");
+                      "Select among routing algorithms ['dijkstra', 'bidijkstra', 'astar', 'CH', 'CCH', 'CHWrapper']");
     oc.doRegister("weights.random-factor", new Option_Float(1.));
     oc.addDescription("weights.random-factor", "Routing", "Edge weights for routing are dynamically disturbed by a random factor drawn uniformly from [1,FLOAT)");
 
@@ -354,7 +364,10 @@ MSFrame::fillOptions() {
     oc.addDescription("astar.all-distances", "Routing", "Initialize lookup table for astar from the given file (generated by marouter --all-pairs-output)");
 
     oc.doRegister("astar.landmark-distances", new Option_FileName());
-    oc.addDescription("astar.landmark-distances", "Routing", "Initialize lookup table for astar ALT-variant from the given file");
+    oc.addDescription("astar.landmark-distances", "Routing", "Initialize lookup table for astar ALT-variant from the given file (text or binary format)");
+
+    oc.doRegister("astar.landmark-count", new Option_Integer(0));
+    oc.addDescription("astar.landmark-count", "Routing", "Select INT landmarks for astar ALT-variant automatically if no landmark file is given");
 
     oc.doRegister("persontrip.walkfactor", new Option_Float(double(0.75)));
     oc.addDescription("persontrip.walkfactor", "Routing", "Use FLOAT as a factor on pedestrian maximum speed during intermodal routing");
@@ -362,6 +375,9 @@ MSFrame::fillOptions() {
     oc.doRegister("persontrip.transfer.car-walk", new Option_String("parkingAreas"));
     oc.addDescription("persontrip.transfer.car-walk", "Routing", "Where are mode changes from car to walking allowed (possible values: 'parkingAreas', 'ptStops', 'allJunctions' and combinations)");
 
+    // iterative assignment
+    MSIterativeAssignment::insertOptions(oc);
+
     // devices
     oc.addOptionSubTopic("Emissions");
     oc.doRegister("phemlight-path", new Option_FileName("./PHEMlight/"));
@@ -379,6 +395,9 @@ MSFrame::fillOptions() {
     oc.doRegister("duration-log.statistics", new Option_Bool(false));
     oc.addDescription("duration-log.statistics", "Report", "Enable statistics on vehicle trips");
 
+    oc.doRegister("duration-log.phases", new Option_Bool(false));
+    oc.addDescription("duration-log.phases", "Report", "Enable statistics on the time spent in the phases of the simulation steps");
+
     oc.doRegister("no-step-log", new Option_Bool(false));
     oc.addDescription("no-step-log", "Report", "Disable console output of current simulation step");
 
@@ -386,6 +405,8 @@ MSFrame::fillOptions() {
     oc.addOptionSubTopic("TraCI Server");
     oc.doRegister("remote-port", new Option_Integer(0));
     oc.addDescription("remote-port", "TraCI Server", "Enables TraCI Server if set");
+    oc.doRegister("remote-shm", new Option_String());
+    oc.addDescription("remote-shm", "TraCI Server", "Enables TraCI Server for a local client using the shared memory segment with the given name");
     oc.doRegister("num-clients", new Option_Integer(1));
     oc.addDescription("num-clients", "TraCI Server", "Expected number of connecting clients");
 #ifdef HAVE_PYTHON
@@ -429,6 +450,9 @@ MSFrame::fillOptions() {
 
     // add rand options
     RandHelper::insertRandOptions();
+    oc.doRegister("thread-rngs", new Option_Integer(64));
+    oc.addDescription("thread-rngs", "Random Number",
+                      "Number of pre-allocated random number generators to ensure repeatable multi-threaded simulations (should be at least the number of threads for repeatable simulations).");
 
     // add GUI options
     // the reason that we include them in vanilla sumo as well is to make reusing config files easy
@@ -481,6 +505,7 @@ MSFrame::buildStreams() {
     OutputDevice::createDeviceByOption("netstate-dump", "netstate", "netstate_file.xsd");
     OutputDevice::createDeviceByOption("summary-output", "summary", "summary_file.xsd");
     OutputDevice::createDeviceByOption("tripinfo-output", "tripinfos", "tripinfo_file.xsd");
+    OutputDevice::createDeviceByOption("step-profile-output", "stepProfile", "stepprofile_file.xsd");
 
     //extended
     OutputDevice::createDeviceByOption("fcd-output", "fcd-export", "fcd_file.xsd");
@@ -549,6 +574,16 @@ MSFrame::checkOptions() {
             ok = false;
         }
     }
+    if (oc.isSet("remote-shm")) {
+        if (oc.getInt("remote-port") != 0) {
+            WRITE_ERROR("Only one of the options 'remote-port' or 'remote-shm' may be given.");
+            ok = false;
+        }
+        if (oc.getInt("num-clients") != 1) {
+            WRITE_ERROR("A TraCI server using shared memory supports a single client only.");
+            ok = false;
+        }
+    }
     if (string2time(oc.getString("step-length")) <= 0) {
         WRITE_ERROR("the minimum step-length is 0.001");
         ok = false;
@@ -573,7 +608,7 @@ MSFrame::checkOptions() {
         WRITE_WARNING("The option 'python-script' is deprecated. Use libsumo or TraCI instead.");
     }
 #endif
-    if (oc.getBool("duration-log.statistics") && oc.isDefault("verbose")) {
+    if ((oc.getBool("duration-log.statistics") || oc.getBool("duration-log.phases")) && oc.isDefault("verbose")) {
         oc.set("verbose", "true");
     }
     if (oc.isDefault("precision") && string2time(oc.getString("step-length")) < 10) {
@@ -597,7 +632,28 @@ MSFrame::checkOptions() {
         WRITE_ERROR("Unknown model '" + oc.getString("carfollow.model")  + "' for option 'carfollow.model'.");
         ok = false;
     }
+    if (oc.isSet("step-profile-output") && string2time(oc.getString("step-profile-output.period")) <= 0) {
+        WRITE_ERROR("The period for the step profile output must be positive.");
+        ok = false;
+    }
+    if (oc.getInt("threads") < 1) {
+        WRITE_ERROR("The number of threads must be positive.");
+        ok = false;
+    }
+#ifndef HAVE_FOX
+    if (oc.getInt("threads") > 1) {
+        WRITE_ERROR("Parallel simulation is only possible when compiled with Fox.");
+        ok = false;
+    }
+#endif
+    if (oc.getInt("thread-rngs") < 1) {
+        WRITE_ERROR("The number of thread-rngs must be positive.");
+        ok = false;
+    } else if (oc.getInt("threads") > oc.getInt("thread-rngs")) {
+        WRITE_WARNING("The number of threads exceeds the number of thread-rngs, some threads will remain idle.");
+    }
     ok &= MSDevice::checkOptions(oc);
+    ok &= MSIterativeAssignment::checkOptions(oc);
     ok &= SystemFrame::checkOptions();
 
     return ok;
@@ -631,8 +687,10 @@ MSFrame::setMSGlobals(OptionsCont& oc) {
         MSGlobals::gUsingInternalLanes = false;
     }
     MSGlobals::gWaitingTimeMemory = string2time(oc.getString("waiting-time-memory"));
+    MSGlobals::gNumSimThreads = oc.getInt("threads");
     MSAbstractLaneChangeModel::initGlobalOptions(oc);
     MSLane::initCollisionOptions(oc);
+    MSLane::initRNGs(oc);
 
     DELTA_T = string2time(oc.getString("step-length"));
 
@@ -63,5 +63,8 @@ bool MSGlobals::gSemiImplicitEulerUpdate;
 SUMOTime MSGlobals::gWaitingTimeMemory;
 
 SUMOTime MSGlobals::gActionStepLength;
+
+int MSGlobals::gNumSimThreads = 1;
+
 /****************************************************************************/
 
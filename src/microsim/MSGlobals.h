@@ -115,6 +115,9 @@ public:
     /// default value for the interval between two action points for MSVehicle (defaults to DELTA_T)
     static SUMOTime gActionStepLength;
 
+    /// @brief how many threads to use for simulation
+    static int gNumSimThreads;
+
 };
 
 
@@ -345,4 +345,20 @@ MSInsertionControl::saveState(OutputDevice& out) {
 }
 
 
+void
+MSInsertionControl::clearState() {
+    assert(myAllVeh.isEmpty());
+    // the flow ids are kept to prevent reusing them
+    for (const Flow& flow : myFlows) {
+        delete flow.pars;
+    }
+    myFlows.clear();
+    myPendingEmits.clear();
+    myEmitCandidates.clear();
+    myAbortedEmits.clear();
+    myPendingEmitsForLane.clear();
+    myPendingEmitsUpdateTime = SUMOTime_MIN;
+}
+
+
 /****************************************************************************/
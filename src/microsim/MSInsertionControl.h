@@ -158,6 +158,12 @@ public:
      */
     void saveState(OutputDevice& out);
 
+    /** @brief Discards the remaining flows and all insertion buffers
+     *
+     * All vehicles need to be removed (using alreadyDeparted) before.
+     */
+    void clearState();
+
 private:
     /** @brief Tries to emit the vehicle
      *
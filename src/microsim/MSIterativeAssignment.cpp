@@ -0,0 +1,520 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    MSIterativeAssignment.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// Computes a dynamic user assignment by simulating the same period repeatedly
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <algorithm>
+#include <set>
+#include <utils/common/MsgHandler.h>
+#include <utils/common/RandHelper.h>
+#include <utils/common/StdDefs.h>
+#include <utils/common/ToString.h>
+#include <utils/common/UtilExceptions.h>
+#include <utils/iodevices/OutputDevice.h>
+#include <utils/options/OptionsCont.h>
+#include <utils/vehicle/DijkstraRouter.h>
+#include <utils/vehicle/SUMOVehicleParameter.h>
+#include "MSEdgeWeightsStorage.h"
+#include "MSGlobals.h"
+#include "MSInsertionControl.h"
+#include "MSLane.h"
+#include "MSRoute.h"
+#include "MSVehicle.h"
+#include "MSVehicleControl.h"
+#include "MSVehicleType.h"
+#include "MSIterativeAssignment.h"
+
+
+// ===========================================================================
+// static method definitions
+// ===========================================================================
+void
+MSIterativeAssignment::insertOptions(OptionsCont& oc) {
+    oc.addOptionSubTopic("Assignment");
+
+    oc.doRegister("assignment.iterations", new Option_Integer(0));
+    oc.addDescription("assignment.iterations", "Assignment", "Simulate INT iterations of a dynamic user assignment before the final simulation");
+
+    oc.doRegister("assignment.aggregation", new Option_String("900", "TIME"));
+    oc.addDescription("assignment.aggregation", "Assignment", "Aggregate the measured travel times over intervals of length TIME");
+
+    oc.doRegister("assignment.route-output", new Option_FileName());
+    oc.addDescription("assignment.route-output", "Assignment", "Write the route alternatives of the final simulation to FILE");
+
+    oc.doRegister("route-choice-method", new Option_String("gawron"));
+    oc.addDescription("route-choice-method", "Assignment", "Choose a route choice method: gawron or logit");
+
+    oc.doRegister("gawron.beta", new Option_Float(double(0.3)));
+    oc.addDescription("gawron.beta", "Assignment", "Use FLOAT as Gawron's beta");
+
+    oc.doRegister("gawron.a", new Option_Float(double(0.05)));
+    oc.addDescription("gawron.a", "Assignment", "Use FLOAT as Gawron's a");
+
+    oc.doRegister("logit.beta", new Option_Float(double(-1)));
+    oc.addDescription("logit.beta", "Assignment", "Use FLOAT as logit's beta");
+
+    oc.doRegister("logit.gamma", new Option_Float(double(1)));
+    oc.addDescription("logit.gamma", "Assignment", "Use FLOAT as logit's gamma");
+
+    oc.doRegister("logit.theta", new Option_Float(double(-1)));
+    oc.addDescription("logit.theta", "Assignment", "Use FLOAT as logit's theta (negative values mean auto-estimation)");
+
+    oc.doRegister("max-alternatives", new Option_Integer(5));
+    oc.addDescription("max-alternatives", "Assignment", "Prune the number of alternatives to INT");
+
+    oc.doRegister("keep-all-routes", new Option_Bool(false));
+    oc.addDescription("keep-all-routes", "Assignment", "Save routes with near zero probability");
+
+    oc.doRegister("skip-new-routes", new Option_Bool(false));
+    oc.addDescription("skip-new-routes", "Assignment", "Only reuse routes from input, do not calculate new ones");
+}
+
+
+bool
+MSIterativeAssignment::checkOptions(OptionsCont& oc) {
+    bool ok = true;
+    if (oc.getInt("assignment.iterations") < 0) {
+        WRITE_ERROR("The number of assignment iterations must not be negative.");
+        ok = false;
+    }
+    if (oc.getInt("assignment.iterations") == 0) {
+        return ok;
+    }
+    if (string2time(oc.getString("assignment.aggregation")) <= 0) {
+        WRITE_ERROR("The aggregation period of the assignment must be positive.");
+        ok = false;
+    }
+    if (oc.getString("route-choice-method") != "gawron" && oc.getString("route-choice-method") != "logit") {
+        WRITE_ERROR("Unknown route choice method '" + oc.getString("route-choice-method") + "'.");
+        ok = false;
+    }
+    if (oc.getInt("max-alternatives") < 2) {
+        WRITE_ERROR("At least two alternatives should be enabled.");
+        ok = false;
+    }
+    if (oc.getBool("mesosim")) {
+        WRITE_ERROR("The iterative assignment does not support the mesoscopic simulation.");
+        ok = false;
+    }
+    if (oc.getInt("remote-port") != 0 || oc.isSet("remote-shm")) {
+        WRITE_ERROR("The iterative assignment cannot be used together with TraCI.");
+        ok = false;
+    }
+#ifdef HAVE_PYTHON
+    if (oc.isSet("python-script")) {
+        WRITE_ERROR("The iterative assignment cannot be used together with a python script.");
+        ok = false;
+    }
+#endif
+    if (oc.isSet("load-state")) {
+        WRITE_ERROR("The iterative assignment cannot start from a saved state.");
+        ok = false;
+    }
+    return ok;
+}
+
+
+MSNet::SimulationState
+MSIterativeAssignment::simulate(MSNet& net, SUMOTime start, SUMOTime stop) {
+    const OptionsCont& oc = OptionsCont::getOptions();
+    const int iterations = oc.getInt("assignment.iterations");
+    MSIterativeAssignment assignment(net, start, string2time(oc.getString("assignment.aggregation")));
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        WRITE_MESSAGE("Assignment iteration " + toString(iteration) + " started with time: " + time2string(start));
+        net.setCurrentTimeStep(start);
+        MSNet::SimulationState state = MSNet::SIMSTATE_RUNNING;
+        while (state == MSNet::SIMSTATE_RUNNING) {
+            net.simulationStep();
+            assignment.sample();
+            state = net.simulationState(stop);
+        }
+        WRITE_MESSAGE("Assignment iteration " + toString(iteration) + " ended at time: " + time2string(net.getCurrentTimeStep()));
+        if (iteration == 0) {
+            // the demand is complete now
+            net.removeVehicleStateListener(&assignment);
+            if (net.hasPersons() || net.hasContainers()) {
+                throw ProcessError("The iterative assignment does not support persons and containers.");
+            }
+        }
+        assignment.storeTravelTimes();
+        net.clearState(start);
+        assignment.rerouteVehicles(iteration);
+    }
+    if (oc.isSet("assignment.route-output")) {
+        assignment.writeRoutes(oc.getString("assignment.route-output"));
+    }
+    return net.simulate(start, stop);
+}
+
+
+SUMOAbstractRouter<MSEdge, SUMOVehicle>*
+MSIterativeAssignment::buildRouter() {
+    return new DijkstraRouter<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> >(
+               MSEdge::getAllEdges(), true, &MSNet::getTravelTime);
+}
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+MSIterativeAssignment::MSIterativeAssignment(MSNet& net, const SUMOTime begin, const SUMOTime aggregation) :
+    myNet(net),
+    myBegin(begin),
+    myAggregation(aggregation),
+    myIntervalBegin(begin),
+    mySampleCounts(MSEdge::dictSize(), 0.),
+    mySpeedSums(MSEdge::dictSize(), 0.),
+    myCalculator(Calculator::getCalculator()),
+    myRouter(0) {
+    // some vehicles were already loaded together with the network
+    MSVehicleControl& vc = net.getVehicleControl();
+    for (MSVehicleControl::constVehIt it = vc.loadedVehBegin(); it != vc.loadedVehEnd(); ++it) {
+        addTrip(*it->second);
+    }
+    net.addVehicleStateListener(this);
+#ifdef HAVE_FOX
+    while (myThreadPool.size() < OptionsCont::getOptions().getInt("device.rerouting.threads")) {
+        new WorkerThread(myThreadPool, buildRouter());
+    }
+    if (myThreadPool.size() == 0) {
+        myRouter = buildRouter();
+    }
+#else
+    myRouter = buildRouter();
+#endif
+}
+
+
+MSIterativeAssignment::~MSIterativeAssignment() {
+    myNet.removeVehicleStateListener(this);
+    for (Trip* const trip : myTrips) {
+        delete trip->pars;
+        trip->route->release();
+        for (Alternative* const alt : trip->alternatives) {
+            delete alt;
+        }
+        delete trip;
+    }
+    delete myRouter;
+    Calculator::cleanup();
+}
+
+
+void
+MSIterativeAssignment::vehicleStateChanged(const SUMOVehicle* const vehicle, MSNet::VehicleState to) {
+    if (to == MSNet::VEHICLE_STATE_BUILT) {
+        addTrip(*vehicle);
+    }
+}
+
+
+void
+MSIterativeAssignment::addTrip(const SUMOVehicle& veh) {
+    const SUMOVehicleParameter& pars = veh.getParameter();
+    if (pars.departProcedure == DEPART_TRIGGERED || pars.departProcedure == DEPART_CONTAINER_TRIGGERED) {
+        throw ProcessError("The iterative assignment does not support the triggered departure of vehicle '" + pars.id + "'.");
+    }
+    Trip* const trip = new Trip();
+    trip->pars = new SUMOVehicleParameter(pars);
+    trip->type = const_cast<MSVehicleType*>(&veh.getVehicleType());
+    trip->route = &veh.getRoute();
+    trip->route->addReference();
+    trip->alternatives.push_back(new Alternative(trip->route->getEdges(), 0., 1.));
+    trip->lastUsed = 0;
+    trip->vehicle = 0;
+    myTrips.push_back(trip);
+}
+
+
+void
+MSIterativeAssignment::sample() {
+    for (const MSEdge* const edge : MSEdge::getAllEdges()) {
+        if (edge->getFunction() != EDGEFUNC_NORMAL) {
+            continue;
+        }
+        const int id = edge->getNumericalID();
+        for (const MSLane* const lane : edge->getLanes()) {
+            if (lane->getVehicleNumber() == 0) {
+                continue;
+            }
+            const MSLane::VehCont& vehs = lane->getVehiclesSecure();
+            for (const MSVehicle* const veh : vehs) {
+                mySpeedSums[id] += veh->getSpeed();
+            }
+            mySampleCounts[id] += (double)vehs.size();
+            lane->releaseVehicles();
+        }
+    }
+    if (myNet.getCurrentTimeStep() >= myIntervalBegin + myAggregation) {
+        closeInterval();
+    }
+}
+
+
+void
+MSIterativeAssignment::closeInterval() {
+    std::vector<double> travelTimes(mySampleCounts.size(), -1.);
+    for (const MSEdge* const edge : MSEdge::getAllEdges()) {
+        const int id = edge->getNumericalID();
+        if (mySampleCounts[id] > 0.) {
+            // edges with stopped traffic get a large but finite travel time
+            const double meanSpeed = MAX2(mySpeedSums[id] / mySampleCounts[id], SUMO_const_haltingSpeed);
+            travelTimes[id] = MAX2(edge->getLength() / meanSpeed, edge->getMinimumTravelTime(0));
+        }
+    }
+    myTravelTimes.push_back(travelTimes);
+    std::fill(mySampleCounts.begin(), mySampleCounts.end(), 0.);
+    std::fill(mySpeedSums.begin(), mySpeedSums.end(), 0.);
+    myIntervalBegin += myAggregation;
+}
+
+
+void
+MSIterativeAssignment::storeTravelTimes() {
+    closeInterval();
+    // edges without measurement fall back to the minimum travel time
+    MSEdgeWeightsStorage& weights = myNet.getWeightsStorage();
+    for (const MSEdge* const edge : MSEdge::getAllEdges()) {
+        if (edge->getFunction() != EDGEFUNC_NORMAL) {
+            continue;
+        }
+        weights.removeTravelTime(edge);
+        for (int i = 0; i < (int)myTravelTimes.size(); i++) {
+            const double travelTime = myTravelTimes[i][edge->getNumericalID()];
+            if (travelTime >= 0.) {
+                const double begin = STEPS2TIME(myBegin + i * myAggregation);
+                weights.addTravelTime(edge, begin, begin + STEPS2TIME(myAggregation), travelTime);
+            }
+        }
+    }
+    myTravelTimes.clear();
+    myIntervalBegin = myBegin;
+}
+
+
+void
+MSIterativeAssignment::rerouteVehicles(const int iteration) {
+    MSVehicleControl& vc = myNet.getVehicleControl();
+    std::set<SUMOVehicleClass> vClasses;
+    for (Trip* const trip : myTrips) {
+        SUMOVehicle* const veh = vc.buildVehicle(new SUMOVehicleParameter(*trip->pars), trip->route, trip->type, !MSGlobals::gCheckRoutes, false);
+        if (!vc.addVehicle(trip->pars->id, veh)) {
+            // the vehicle was rejected when loading as well
+            vc.deleteVehicle(veh, true);
+            continue;
+        }
+        myNet.getInsertionControl().add(veh);
+        trip->vehicle = veh;
+        vClasses.insert(trip->type->getVehicleClass());
+    }
+#ifdef HAVE_FOX
+    if (myThreadPool.size() > 0) {
+        // the edges build their successors lazily, this must not happen in the threads
+        for (const SUMOVehicleClass vClass : vClasses) {
+            for (const MSEdge* const edge : MSEdge::getAllEdges()) {
+                edge->getSuccessors(vClass);
+            }
+        }
+        for (Trip* const trip : myTrips) {
+            if (trip->vehicle != 0) {
+                myThreadPool.add(new RoutingTask(*this, *trip));
+            }
+        }
+        myThreadPool.waitAll();
+    }
+#endif
+    if (myRouter != 0) {
+        for (Trip* const trip : myTrips) {
+            if (trip->vehicle != 0) {
+                computeCosts(*trip, *myRouter);
+            }
+        }
+    }
+    // the choice draws random numbers so it is done in the order of loading with its own generator,
+    //  this way neither the simulation nor the number of routing threads changes the chosen routes
+    const OptionsCont& oc = OptionsCont::getOptions();
+    RandHelper::initRand(&myRNG, oc.getBool("random"), oc.getInt("seed") + iteration);
+    for (Trip* const trip : myTrips) {
+        if (trip->vehicle != 0) {
+            chooseRoute(*trip);
+            trip->vehicle = 0;
+        }
+    }
+}
+
+
+void
+MSIterativeAssignment::computeCosts(Trip& trip, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router) const {
+    const SUMOTime depart = trip.pars->depart;
+    trip.legs.clear();
+    trip.newEdges.clear();
+    trip.costs.clear();
+    trip.vehicle->getRerouteLegs(true, false, trip.legs);
+    if (!myCalculator.skipRouteCalculation()) {
+        trip.vehicle->computeReroute(depart, router, trip.legs, trip.newEdges);
+    }
+    for (const Alternative* const alt : trip.alternatives) {
+        trip.costs.push_back(router.recomputeCosts(alt->getEdgeVector(), trip.vehicle, depart));
+    }
+    if (!trip.newEdges.empty()) {
+        trip.costs.push_back(router.recomputeCosts(trip.newEdges, trip.vehicle, depart));
+    }
+}
+
+
+void
+MSIterativeAssignment::chooseRoute(Trip& trip) {
+    std::vector<Alternative*>& alternatives = trip.alternatives;
+    // add the route when it's new
+    Alternative* current = 0;
+    if (!trip.newEdges.empty()) {
+        bool known = false;
+        for (const Alternative* const alt : alternatives) {
+            if (alt->getEdgeVector() == trip.newEdges) {
+                known = true;
+                break;
+            }
+        }
+        if (known) {
+            trip.costs.pop_back();
+        } else {
+            current = new Alternative(trip.newEdges, 0., 0.);
+            alternatives.push_back(current);
+        }
+    }
+    // recompute the costs and (when a new route was added) scale the probabilities
+    const double scale = double(alternatives.size() - 1) / double(alternatives.size());
+    for (int i = 0; i < (int)alternatives.size(); i++) {
+        Alternative* const alt = alternatives[i];
+        const double newCosts = trip.costs[i];
+        if (newCosts < 0.) {
+            throw ProcessError("Route alternative " + toString(i) + " of vehicle '" + trip.pars->id + "' is not valid.");
+        }
+        if (current != 0) {
+            if (alt == current) {
+                // set initial probability and costs
+                alt->setProbability(1. / (double)alternatives.size());
+                alt->setCosts(newCosts);
+            } else {
+                // rescale probs for all others
+                alt->setProbability(alt->getProbability() * scale);
+            }
+        }
+        myCalculator.setCosts(alt, newCosts, i == trip.lastUsed);
+    }
+    myCalculator.calculateProbabilities(alternatives, trip.vehicle, trip.pars->depart);
+    if (!myCalculator.keepRoutes()) {
+        // remove with probability of 0 (not mentioned in Gawron)
+        for (std::vector<Alternative*>::iterator i = alternatives.begin(); i != alternatives.end();) {
+            if ((*i)->getProbability() == 0) {
+                delete *i;
+                i = alternatives.erase(i);
+            } else {
+                i++;
+            }
+        }
+    }
+    if ((int)alternatives.size() > myCalculator.getMaxRouteNumber()) {
+        // only keep the routes with highest probability
+        std::stable_sort(alternatives.begin(), alternatives.end(), [](const Alternative * a, const Alternative * b) {
+            return a->getProbability() > b->getProbability();
+        });
+        for (std::vector<Alternative*>::iterator i = alternatives.begin() + myCalculator.getMaxRouteNumber(); i != alternatives.end(); i++) {
+            delete *i;
+        }
+        alternatives.erase(alternatives.begin() + myCalculator.getMaxRouteNumber(), alternatives.end());
+        // rescale probabilities
+        double newSum = 0;
+        for (const Alternative* const alt : alternatives) {
+            newSum += alt->getProbability();
+        }
+        for (Alternative* const alt : alternatives) {
+            alt->setProbability(alt->getProbability() / newSum);
+        }
+    }
+    // find the route to use
+    double chosen = RandHelper::rand(&myRNG);
+    int pos = 0;
+    for (; pos < (int)alternatives.size() - 1; pos++) {
+        chosen -= alternatives[pos]->getProbability();
+        if (chosen <= 0) {
+            break;
+        }
+    }
+    trip.lastUsed = pos;
+    ConstMSEdgeVector edges = alternatives[pos]->getEdgeVector();
+    trip.vehicle->applyReroute(edges, trip.legs, true);
+}
+
+
+void
+MSIterativeAssignment::writeRoutes(const std::string& file) const {
+    const OptionsCont& oc = OptionsCont::getOptions();
+    OutputDevice& dev = OutputDevice::getDevice(file);
+    dev.writeXMLHeader("routes", "routes_file.xsd");
+    std::vector<const Trip*> trips(myTrips.begin(), myTrips.end());
+    std::stable_sort(trips.begin(), trips.end(), [](const Trip * a, const Trip * b) {
+        return a->pars->depart < b->pars->depart;
+    });
+    std::set<const MSVehicleType*> writtenTypes;
+    for (const Trip* const trip : trips) {
+        const std::string& typeID = trip->type->getID();
+        if (writtenTypes.insert(trip->type).second && typeID != DEFAULT_VTYPE_ID && typeID != DEFAULT_PEDTYPE_ID) {
+            trip->type->getParameter().write(dev);
+        }
+        trip->pars->write(dev, oc, SUMO_TAG_VEHICLE, typeID);
+        dev.openTag(SUMO_TAG_ROUTE_DISTRIBUTION).writeAttr(SUMO_ATTR_LAST, trip->lastUsed);
+        for (const Alternative* const alt : trip->alternatives) {
+            dev.openTag(SUMO_TAG_ROUTE).writeAttr(SUMO_ATTR_COST, alt->getCosts());
+            dev.setPrecision(8);
+            dev.writeAttr(SUMO_ATTR_PROB, alt->getProbability());
+            dev.setPrecision();
+            dev.writeAttr(SUMO_ATTR_EDGES, alt->getEdgeVector());
+            dev.closeTag();
+        }
+        dev.closeTag();
+        for (const SUMOVehicleParameter::Stop& stop : trip->pars->stops) {
+            stop.write(dev);
+        }
+        trip->pars->writeParams(dev);
+        dev.closeTag();
+    }
+    dev.close();
+}
+
+
+#ifdef HAVE_FOX
+// ---------------------------------------------------------------------------
+// MSIterativeAssignment::RoutingTask-methods
+// ---------------------------------------------------------------------------
+void
+MSIterativeAssignment::RoutingTask::run(FXWorkerThread* context) {
+    myAssignment.computeCosts(myTrip, static_cast<WorkerThread*>(context)->getRouter());
+}
+#endif
+
+
+/****************************************************************************/
+
@@ -0,0 +1,306 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    MSIterativeAssignment.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// Computes a dynamic user assignment by simulating the same period repeatedly
+/****************************************************************************/
+#ifndef MSIterativeAssignment_h
+#define MSIterativeAssignment_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <random>
+#include <string>
+#include <vector>
+#include <utils/common/SUMOTime.h>
+#include <utils/vehicle/SUMOAbstractRouter.h>
+#include <utils/vehicle/RouteCostCalculator.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXWorkerThread.h>
+#endif
+#include "MSEdge.h"
+#include "MSNet.h"
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class MSRoute;
+class MSVehicleType;
+class OptionsCont;
+class SUMOVehicle;
+class SUMOVehicleParameter;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSIterativeAssignment
+ * @brief Computes a dynamic user assignment by simulating the same period repeatedly
+ *
+ * This is the in-process variant of the duaIterate script. Network and demand are
+ *  loaded only once. After each iteration the travel times measured on the edges
+ *  are put into the global MSEdgeWeightsStorage, the simulation is reset to its
+ *  begin and all vehicles are rebuilt from their loaded definitions. Every vehicle
+ *  then computes its fastest route for the measured travel times and chooses among
+ *  its route alternatives using the GawronCalculator or the LogitCalculator like
+ *  duarouter does. The route searches run in parallel (one router per thread).
+ *
+ * Only the final simulation is closed regularly, the outputs written during the
+ *  previous iterations go to the same files.
+ */
+class MSIterativeAssignment : public MSNet::VehicleStateListener {
+public:
+    /**
+     * @class Alternative
+     * @brief A route alternative of a vehicle with its costs and choice probability
+     */
+    class Alternative {
+    public:
+        /// @brief Constructor
+        Alternative(const ConstMSEdgeVector& edges, const double costs, const double prob)
+            : myEdges(edges), myCosts(costs), myProbability(prob) {}
+
+        /// @brief Returns the edges of the route
+        const ConstMSEdgeVector& getEdgeVector() const {
+            return myEdges;
+        }
+
+        /// @brief Returns the (smoothed) costs of the route
+        double getCosts() const {
+            return myCosts;
+        }
+
+        /// @brief Sets the costs of the route
+        void setCosts(const double costs) {
+            myCosts = costs;
+        }
+
+        /// @brief Returns the probability to choose the route
+        double getProbability() const {
+            return myProbability;
+        }
+
+        /// @brief Sets the probability to choose the route
+        void setProbability(const double prob) {
+            myProbability = prob;
+        }
+
+    private:
+        /// @brief The edges of the route
+        const ConstMSEdgeVector myEdges;
+
+        /// @brief The costs of the route
+        double myCosts;
+
+        /// @brief The probability to choose the route
+        double myProbability;
+    };
+
+
+    /** @brief Inserts the options of the assignment into the options container
+     * @param[filled] oc The options container to add the options to
+     */
+    static void insertOptions(OptionsCont& oc);
+
+
+    /** @brief Checks the options of the assignment
+     * @param[in] oc The options container to check
+     * @return Whether the options are valid
+     */
+    static bool checkOptions(OptionsCont& oc);
+
+
+    /** @brief Simulates the assignment iterations followed by the final simulation
+     * @param[in] net The loaded network (including the loaded demand)
+     * @param[in] start The begin time step of the simulation
+     * @param[in] stop The end time step of the simulation
+     * @return The state of the final simulation
+     * @see MSNet::simulate
+     */
+    static MSNet::SimulationState simulate(MSNet& net, SUMOTime start, SUMOTime stop);
+
+
+    /** @brief Records the definition of each vehicle which is built during the first iteration
+     * @param[in] vehicle The vehicle which changed its state
+     * @param[in] to The state the vehicle has changed to
+     */
+    void vehicleStateChanged(const SUMOVehicle* const vehicle, MSNet::VehicleState to);
+
+
+private:
+    /// @brief The definition of a vehicle together with its route alternatives
+    struct Trip {
+        /// @brief The vehicle parameters as loaded (owned)
+        SUMOVehicleParameter* pars;
+        /// @brief The vehicle type (drawn from the distribution while loading)
+        MSVehicleType* type;
+        /// @brief The loaded route (referenced)
+        const MSRoute* route;
+        /// @brief The route alternatives (owned)
+        std::vector<Alternative*> alternatives;
+        /// @brief The index of the alternative chosen last
+        int lastUsed;
+        /// @brief The vehicle of the current iteration
+        SUMOVehicle* vehicle;
+        /// @brief The legs of the route search
+        ConstMSEdgeVector legs;
+        /// @brief The result of the route search (empty if there is none)
+        ConstMSEdgeVector newEdges;
+        /// @brief The current costs of all alternatives (and of the new route)
+        std::vector<double> costs;
+    };
+
+    typedef RouteCostCalculator<Alternative, MSEdge, SUMOVehicle> Calculator;
+
+
+    /// @brief Constructor
+    MSIterativeAssignment(MSNet& net, const SUMOTime begin, const SUMOTime aggregation);
+
+    /// @brief Destructor
+    ~MSIterativeAssignment();
+
+    /// @brief Records the definition of the given vehicle
+    void addTrip(const SUMOVehicle& veh);
+
+    /// @brief Adds the speeds of all vehicles in the network to the current interval
+    void sample();
+
+    /// @brief Computes the travel times of the current interval and starts the next one
+    void closeInterval();
+
+    /// @brief Replaces the travel times in the global weights storage by the ones of the last iteration
+    void storeTravelTimes();
+
+    /** @brief Rebuilds all vehicles and lets them choose their routes for the next iteration
+     * @param[in] iteration The index of the iteration which has just ended (used to reseed the route choice)
+     */
+    void rerouteVehicles(const int iteration);
+
+    /// @brief Computes the new route and the costs of all alternatives (may run in a thread)
+    void computeCosts(Trip& trip, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router) const;
+
+    /// @brief Updates the alternatives and chooses the route of the vehicle
+    void chooseRoute(Trip& trip);
+
+    /// @brief Writes the vehicles with their route alternatives
+    void writeRoutes(const std::string& file) const;
+
+    /// @brief Builds a router for the travel times in the global weights storage
+    static SUMOAbstractRouter<MSEdge, SUMOVehicle>* buildRouter();
+
+
+private:
+#ifdef HAVE_FOX
+    /**
+     * @class WorkerThread
+     * @brief the thread which provides the router instance as context
+     */
+    class WorkerThread : public FXWorkerThread {
+    public:
+        WorkerThread(FXWorkerThread::Pool& pool,
+                     SUMOAbstractRouter<MSEdge, SUMOVehicle>* router)
+            : FXWorkerThread(pool), myRouter(router) {}
+        SUMOAbstractRouter<MSEdge, SUMOVehicle>& getRouter() const {
+            return *myRouter;
+        }
+        virtual ~WorkerThread() {
+            stop();
+            delete myRouter;
+        }
+    private:
+        SUMOAbstractRouter<MSEdge, SUMOVehicle>* myRouter;
+    };
+
+    /**
+     * @class RoutingTask
+     * @brief the routing task which computes the costs of the alternatives of a single trip
+     */
+    class RoutingTask : public FXWorkerThread::Task {
+    public:
+        RoutingTask(const MSIterativeAssignment& assignment, Trip& trip)
+            : myAssignment(assignment), myTrip(trip) {}
+        void run(FXWorkerThread* context);
+    private:
+        const MSIterativeAssignment& myAssignment;
+        Trip& myTrip;
+    private:
+        /// @brief Invalidated assignment operator.
+        RoutingTask& operator=(const RoutingTask&);
+    };
+#endif
+
+
+private:
+    /// @brief The simulated network
+    MSNet& myNet;
+
+    /// @brief The begin of the simulation
+    const SUMOTime myBegin;
+
+    /// @brief The length of the intervals for the travel time aggregation
+    const SUMOTime myAggregation;
+
+    /// @brief The begin of the current interval
+    SUMOTime myIntervalBegin;
+
+    /// @brief The number of sampled vehicles in the current interval (by numerical edge id)
+    std::vector<double> mySampleCounts;
+
+    /// @brief The sum of the sampled speeds in the current interval (by numerical edge id)
+    std::vector<double> mySpeedSums;
+
+    /// @brief The measured travel times by interval and numerical edge id (negative if there were no vehicles)
+    std::vector<std::vector<double> > myTravelTimes;
+
+    /// @brief The definitions of all vehicles
+    std::vector<Trip*> myTrips;
+
+    /// @brief The route choice model
+    Calculator& myCalculator;
+
+    /// @brief The random number generator of the route choice (reseeded before each choice round)
+    std::mt19937 myRNG;
+
+    /// @brief The router for the serial route search (0 if threads are used)
+    SUMOAbstractRouter<MSEdge, SUMOVehicle>* myRouter;
+
+#ifdef HAVE_FOX
+    /// @brief The pool of routing threads
+    FXWorkerThread::Pool myThreadPool;
+#endif
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    MSIterativeAssignment(const MSIterativeAssignment&);
+
+    /// @brief Invalidated assignment operator.
+    MSIterativeAssignment& operator=(const MSIterativeAssignment&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -38,6 +38,7 @@
 #include <iostream>
 #include <cassert>
 #include <functional>
+#include <memory>
 #include <algorithm>
 #include <iterator>
 #include <exception>
@@ -47,6 +48,7 @@
 #include <utils/common/StdDefs.h>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/ToString.h>
+#include <utils/common/RandHelper.h>
 #include <utils/options/OptionsCont.h>
 #include <utils/emissions/HelpersHarmonoise.h>
 #include <utils/geom/GeomHelper.h>
@@ -68,6 +70,10 @@
 #include "MSLeaderInfo.h"
 #include "MSVehicle.h"
 
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXConditionalLock.h>
+#endif
+
 //#define DEBUG_INSERTION
 //#define DEBUG_PLAN_MOVE
 //#define DEBUG_EXEC_MOVE
@@ -91,6 +97,8 @@ MSLane::CollisionAction MSLane::myCollisionAction(MSLane::COLLISION_ACTION_TELEP
 bool MSLane::myCheckJunctionCollisions(false);
 SUMOTime MSLane::myCollisionStopTime(0);
 double  MSLane::myCollisionMinGapFactor(1.0);
+std::vector<std::mt19937> MSLane::myRNGs;
+bool MSLane::myParallelPlanMovements(false);
 
 // ===========================================================================
 // internal class method definitions
@@ -182,7 +190,12 @@ MSLane::MSLane(const std::string& id, double maxSpeed, double length, MSEdge* co
     myLengthGeometryFactor(MAX2(POSITION_EPS, myShape.length()) / myLength), // factor should not be 0
     myIsRampAccel(isRampAccel),
     myRightSideOnEdge(0), // initialized in MSEdge::initialize
-    myRightmostSublane(0) {
+    myRightmostSublane(0),
+    myRNGIndex(myRNGs.empty() ? 0 : numericalID % (int)myRNGs.size())
+#ifdef HAVE_FOX
+    , mySimulationTask(*this, 0)
+#endif
+{
     // initialized in MSEdge::initialize
     initRestrictions();// may be reloaded again from initialized in MSEdge::closeBuilding
 }
@@ -549,6 +562,11 @@ MSLane::insertVehicle(MSVehicle& veh) {
                 break;
         }
     }
+    // skip the full check if the last vehicle is still in the way
+    // (without speed patching the full check may report errors)
+    if (patchSpeed && MSGlobals::gLateralResolution <= 0 && insertionBlockedByLast(veh, pos)) {
+        return false;
+    }
     // try to insert
     return isInsertionSuccess(&veh, speed, pos, posLat, patchSpeed, MSMoveReminder::NOTIFICATION_DEPARTED);
 }
@@ -559,6 +577,22 @@ MSLane::basePos(const MSVehicle& veh) const {
     return MIN2(veh.getVehicleType().getLength() + POSITION_EPS, myLength);
 }
 
+
+bool
+MSLane::insertionBlockedByLast(const MSVehicle& veh, double pos) const {
+    if (pos < 0 || pos > myLength) {
+        // isInsertionSuccess corrects the position and warns
+        return false;
+    }
+    // the same vehicle getLastVehicleInformation starts with
+    const MSVehicle* const last = *anyVehiclesBegin();
+    if (last == 0 || last->getPositionOnLane(this) < pos) {
+        // no leader or the last vehicle is a follower
+        return false;
+    }
+    return last->getBackPositionOnLane(this) - pos - veh.getVehicleType().getMinGap() < 0;
+}
+
 bool
 MSLane::checkFailure(const MSVehicle* aVehicle, double& speed, double& dist, const double nspeed, const bool patchSpeed, const std::string errorMsg) const {
     if (nspeed < speed) {
@@ -963,107 +997,148 @@ MSLane::safeInsertionSpeed(const MSVehicle* veh, double seen, const MSLeaderInfo
 
 
 // ------ Handling vehicles lapping into lanes ------
+MSLeaderInfo&
+MSLane::resetLeaderInfoTmp(const MSVehicle* ego, double latOffset) const {
+#ifdef HAVE_FOX
+    if (MSGlobals::gNumSimThreads > 1) {
+        // the lane may be queried by vehicles on other lanes concurrently
+        static thread_local std::unique_ptr<MSLeaderInfo> threadLeaderInfoTmp;
+        if (threadLeaderInfoTmp == nullptr) {
+            threadLeaderInfoTmp.reset(new MSLeaderInfo(this, ego, latOffset));
+        } else {
+            *threadLeaderInfoTmp = MSLeaderInfo(this, ego, latOffset);
+        }
+        return *threadLeaderInfoTmp;
+    }
+#endif
+    myLeaderInfoTmp = MSLeaderInfo(this, ego, latOffset);
+    return myLeaderInfoTmp;
+}
+
+
 const MSLeaderInfo&
 MSLane::getLastVehicleInformation(const MSVehicle* ego, double latOffset, double minPos, bool allowCached) const {
-    if (myLeaderInfoTime < MSNet::getInstance()->getCurrentTimeStep() || ego != 0 || minPos > 0 || !allowCached) {
-        myLeaderInfoTmp = MSLeaderInfo(this, ego, latOffset);
-        AnyVehicleIterator last = anyVehiclesBegin();
-        int freeSublanes = 1; // number of sublanes for which no leader was found
-        //if (ego->getID() == "disabled" && SIMTIME == 58) {
-        //    std::cout << "DEBUG\n";
-        //}
-        const MSVehicle* veh = *last;
-        while (freeSublanes > 0 && veh != 0) {
+    const SUMOTime now = MSNet::getInstance()->getCurrentTimeStep();
+    if (ego == 0 && minPos <= 0 && allowCached) {
+#ifdef HAVE_FOX
+        FXConditionalLock lock(myLeaderInfoMutex, MSGlobals::gNumSimThreads > 1);
+#endif
+        if (myLeaderInfoTime >= now) {
+            return myLeaderInfo;
+        }
+    }
+    MSLeaderInfo& leaderTmp = resetLeaderInfoTmp(ego, latOffset);
+    AnyVehicleIterator last = anyVehiclesBegin();
+    int freeSublanes = 1; // number of sublanes for which no leader was found
+    //if (ego->getID() == "disabled" && SIMTIME == 58) {
+    //    std::cout << "DEBUG\n";
+    //}
+    const MSVehicle* veh = *last;
+    while (freeSublanes > 0 && veh != 0) {
 #ifdef DEBUG_PLAN_MOVE
-            if (DEBUG_COND2(ego)) {
-                gDebugFlag1 = true;
-                std::cout << "      getLastVehicleInformation lane=" << getID() << " minPos=" << minPos << " veh=" << veh->getID() << " pos=" << veh->getPositionOnLane(this)  << "\n";
-            }
+        if (DEBUG_COND2(ego)) {
+            gDebugFlag1 = true;
+            std::cout << "      getLastVehicleInformation lane=" << getID() << " minPos=" << minPos << " veh=" << veh->getID() << " pos=" << veh->getPositionOnLane(this)  << "\n";
+        }
 #endif
-            if (veh != ego && veh->getPositionOnLane(this) >= minPos) {
-                const double latOffset = veh->getLatOffset(this);
-                freeSublanes = myLeaderInfoTmp.addLeader(veh, true, latOffset);
+        if (veh != ego && veh->getPositionOnLane(this) >= minPos) {
+            const double latOffset = veh->getLatOffset(this);
+            freeSublanes = leaderTmp.addLeader(veh, true, latOffset);
 #ifdef DEBUG_PLAN_MOVE
-                if (DEBUG_COND2(ego)) {
-                    std::cout << "         latOffset=" << latOffset << " newLeaders=" << myLeaderInfoTmp.toString() << "\n";
-                }
-#endif
+            if (DEBUG_COND2(ego)) {
+                std::cout << "         latOffset=" << latOffset << " newLeaders=" << leaderTmp.toString() << "\n";
             }
-            veh = *(++last);
+#endif
         }
-        if (ego == 0 && minPos == 0) {
-            // update cached value
-            myLeaderInfoTime = MSNet::getInstance()->getCurrentTimeStep();
-            myLeaderInfo = myLeaderInfoTmp;
+        veh = *(++last);
+    }
+    if (ego == 0 && minPos == 0) {
+#ifdef HAVE_FOX
+        FXConditionalLock lock(myLeaderInfoMutex, MSGlobals::gNumSimThreads > 1);
+#endif
+        // update cached value (only once per step while it is referenced concurrently)
+        if (!myParallelPlanMovements || myLeaderInfoTime < now) {
+            myLeaderInfoTime = now;
+            myLeaderInfo = leaderTmp;
         }
+    }
 #ifdef DEBUG_PLAN_MOVE
-        //if (DEBUG_COND2(ego)) std::cout << SIMTIME
-        //    << " getLastVehicleInformation lane=" << getID()
-        //        << " ego=" << Named::getIDSecure(ego)
-        //        << "\n"
-        //        << "    vehicles=" << toString(myVehicles)
-        //        << "    partials=" << toString(myPartialVehicles)
-        //        << "\n"
-        //        << "    result=" << myLeaderInfoTmp.toString()
-        //        << "    cached=" << myLeaderInfo.toString()
-        //        << "    myLeaderInfoTime=" << myLeaderInfoTime
-        //        << "\n";
-        gDebugFlag1 = false;
+    //if (DEBUG_COND2(ego)) std::cout << SIMTIME
+    //    << " getLastVehicleInformation lane=" << getID()
+    //        << " ego=" << Named::getIDSecure(ego)
+    //        << "\n"
+    //        << "    vehicles=" << toString(myVehicles)
+    //        << "    partials=" << toString(myPartialVehicles)
+    //        << "\n"
+    //        << "    result=" << leaderTmp.toString()
+    //        << "    cached=" << myLeaderInfo.toString()
+    //        << "    myLeaderInfoTime=" << myLeaderInfoTime
+    //        << "\n";
+    gDebugFlag1 = false;
 #endif
-        return myLeaderInfoTmp;
-    }
-    return myLeaderInfo;
+    return leaderTmp;
 }
 
 
 const MSLeaderInfo&
 MSLane::getFirstVehicleInformation(const MSVehicle* ego, double latOffset, bool onlyFrontOnLane, double maxPos, bool allowCached) const {
-    if (myFollowerInfoTime < MSNet::getInstance()->getCurrentTimeStep() || ego != 0 || maxPos < myLength || !allowCached || onlyFrontOnLane) {
-        // XXX separate cache for onlyFrontOnLane = true
-        myLeaderInfoTmp = MSLeaderInfo(this, ego, latOffset);
-        AnyVehicleIterator first = anyVehiclesUpstreamBegin();
-        int freeSublanes = 1; // number of sublanes for which no leader was found
-        const MSVehicle* veh = *first;
-        while (freeSublanes > 0 && veh != 0) {
-#ifdef DEBUG_PLAN_MOVE
-            if (DEBUG_COND2(ego)) {
-                std::cout << "       veh=" << veh->getID() << " pos=" << veh->getPositionOnLane(this) << " maxPos=" << maxPos << "\n";
-            }
+    const SUMOTime now = MSNet::getInstance()->getCurrentTimeStep();
+    if (ego == 0 && maxPos >= myLength && allowCached && !onlyFrontOnLane) {
+#ifdef HAVE_FOX
+        FXConditionalLock lock(myLeaderInfoMutex, MSGlobals::gNumSimThreads > 1);
 #endif
-            if (veh != ego && veh->getPositionOnLane(this) <= maxPos
-                    && (!onlyFrontOnLane || veh->isFrontOnLane(this))) {
-                //const double latOffset = veh->getLane()->getRightSideOnEdge() - getRightSideOnEdge();
-                const double latOffset = veh->getLatOffset(this);
+        if (myFollowerInfoTime >= now) {
+            return myFollowerInfo;
+        }
+    }
+    // XXX separate cache for onlyFrontOnLane = true
+    MSLeaderInfo& followerTmp = resetLeaderInfoTmp(ego, latOffset);
+    AnyVehicleIterator first = anyVehiclesUpstreamBegin();
+    int freeSublanes = 1; // number of sublanes for which no leader was found
+    const MSVehicle* veh = *first;
+    while (freeSublanes > 0 && veh != 0) {
 #ifdef DEBUG_PLAN_MOVE
-                if (DEBUG_COND2(ego)) {
-                    std::cout << "          veh=" << veh->getID() << " latOffset=" << latOffset << "\n";
-                }
+        if (DEBUG_COND2(ego)) {
+            std::cout << "       veh=" << veh->getID() << " pos=" << veh->getPositionOnLane(this) << " maxPos=" << maxPos << "\n";
+        }
 #endif
-                freeSublanes = myLeaderInfoTmp.addLeader(veh, true, latOffset);
+        if (veh != ego && veh->getPositionOnLane(this) <= maxPos
+                && (!onlyFrontOnLane || veh->isFrontOnLane(this))) {
+            //const double latOffset = veh->getLane()->getRightSideOnEdge() - getRightSideOnEdge();
+            const double latOffset = veh->getLatOffset(this);
+#ifdef DEBUG_PLAN_MOVE
+            if (DEBUG_COND2(ego)) {
+                std::cout << "          veh=" << veh->getID() << " latOffset=" << latOffset << "\n";
             }
-            veh = *(++first);
+#endif
+            freeSublanes = followerTmp.addLeader(veh, true, latOffset);
         }
-        if (ego == 0 && maxPos == std::numeric_limits<double>::max()) {
-            // update cached value
-            myFollowerInfoTime = MSNet::getInstance()->getCurrentTimeStep();
-            myFollowerInfo = myLeaderInfoTmp;
+        veh = *(++first);
+    }
+    if (ego == 0 && maxPos == std::numeric_limits<double>::max()) {
+#ifdef HAVE_FOX
+        FXConditionalLock lock(myLeaderInfoMutex, MSGlobals::gNumSimThreads > 1);
+#endif
+        // update cached value (only once per step while it is referenced concurrently)
+        if (!myParallelPlanMovements || myFollowerInfoTime < now) {
+            myFollowerInfoTime = now;
+            myFollowerInfo = followerTmp;
         }
+    }
 #ifdef DEBUG_PLAN_MOVE
-        //if (DEBUG_COND2(ego)) std::cout << SIMTIME
-        //    << " getFirstVehicleInformation lane=" << getID()
-        //        << " ego=" << Named::getIDSecure(ego)
-        //        << "\n"
-        //        << "    vehicles=" << toString(myVehicles)
-        //        << "    partials=" << toString(myPartialVehicles)
-        //        << "\n"
-        //        << "    result=" << myLeaderInfoTmp.toString()
-        //        //<< "    cached=" << myLeaderInfo.toString()
-        //        << "    myLeaderInfoTime=" << myLeaderInfoTime
-        //        << "\n";
+    //if (DEBUG_COND2(ego)) std::cout << SIMTIME
+    //    << " getFirstVehicleInformation lane=" << getID()
+    //        << " ego=" << Named::getIDSecure(ego)
+    //        << "\n"
+    //        << "    vehicles=" << toString(myVehicles)
+    //        << "    partials=" << toString(myPartialVehicles)
+    //        << "\n"
+    //        << "    result=" << followerTmp.toString()
+    //        //<< "    cached=" << myLeaderInfo.toString()
+    //        << "    myLeaderInfoTime=" << myLeaderInfoTime
+    //        << "\n";
 #endif
-        return myLeaderInfoTmp;
-    }
-    return myFollowerInfo;
+    return followerTmp;
 }
 
 
@@ -1089,6 +1164,9 @@ MSLane::planMovements(SUMOTime t) {
                 << "\n";
 #endif
     assert(MSGlobals::gLateralResolution || myManeuverReservations.size()==0);
+    if (myVehicles.size() > 1) {
+        computeFollowSpeeds(t);
+    }
     for (; veh != myVehicles.rend(); ++veh) {
 #ifdef DEBUG_PLAN_MOVE
         if (DEBUG_COND2((*veh))) {
@@ -1105,6 +1183,72 @@ MSLane::planMovements(SUMOTime t) {
         cumulatedVehLength += (*veh)->getVehicleType().getLengthWithGap();
         leaders.addLeader(*veh, false, 0);
     }
+    myFollowSpeeds.valid = false;
+}
+
+
+void
+MSLane::computeFollowSpeeds(const SUMOTime t) {
+    FollowSpeeds& batch = myFollowSpeeds;
+    const int numLeaders = (int)myVehicles.size() - 1;
+    // only the vehicles in their action step adapt to their leaders
+    batch.slots.clear();
+    for (int i = 0; i < numLeaders; i++) {
+        myVehicles[i]->setFollowSpeedSlot(i);
+        if (myVehicles[i]->isActionStep(t) && myVehicles[i]->getCarFollowModel().hasFollowSpeedBatch()) {
+            batch.slots.push_back(i);
+        }
+    }
+    myVehicles.back()->setFollowSpeedSlot(numLeaders);
+    batch.haveFollowSpeed.assign(numLeaders, false);
+    batch.followSpeed.resize(numLeaders);
+    batch.valid = true;
+    // each car-following model (vehicle type) computes the follow speeds of its vehicles at once
+    const int numSlots = (int)batch.slots.size();
+    for (int first = 0; first < numSlots;) {
+        const MSCFModel& cfModel = myVehicles[batch.slots[first]]->getCarFollowModel();
+        int n = 0;
+        for (int j = first; j < numSlots; j++) {
+            if (&myVehicles[batch.slots[j]]->getCarFollowModel() == &cfModel) {
+                std::swap(batch.slots[first + n], batch.slots[j]);
+                n++;
+            }
+        }
+        batch.vehs.resize(n);
+        batch.preds.resize(n);
+        batch.speed.resize(n);
+        batch.gap.resize(n);
+        batch.predSpeed.resize(n);
+        batch.predDecel.resize(n);
+        batch.result.resize(n);
+        for (int j = 0; j < n; j++) {
+            const int i = batch.slots[first + j];
+            const MSVehicle* const veh = myVehicles[i];
+            const MSVehicle* const pred = myVehicles[i + 1];
+            batch.vehs[j] = veh;
+            batch.preds[j] = pred;
+            batch.speed[j] = veh->getSpeed();
+            batch.gap[j] = pred->getBackPositionOnLane(this) - veh->getPositionOnLane() - veh->getVehicleType().getMinGap();
+            batch.predSpeed[j] = pred->getSpeed();
+            batch.predDecel[j] = pred->getCarFollowModel().getApparentDecel();
+        }
+        cfModel.followSpeedBatch(&batch.vehs[0], &batch.speed[0], &batch.gap[0], &batch.predSpeed[0],
+                                 &batch.predDecel[0], &batch.preds[0], &batch.result[0], n);
+        for (int j = 0; j < n; j++) {
+            const int i = batch.slots[first + j];
+            batch.followSpeed[i] = batch.result[j];
+            batch.haveFollowSpeed[i] = true;
+        }
+        first += n;
+    }
+}
+
+
+void
+MSLane::setJunctionApproaches(const SUMOTime /* t */) {
+    for (MSVehicle* const veh : myVehicles) {
+        veh->setApproachingForAllLinks();
+    }
 }
 
 
@@ -1669,16 +1813,22 @@ MSLane::clear() {
 
 void
 MSLane::insertIDs(std::vector<std::string>& into) {
+    const int offset = (int)into.size();
+    into.reserve(offset + myDict.size());
     for (DictType::iterator i = myDict.begin(); i != myDict.end(); ++i) {
         into.push_back((*i).first);
     }
+    std::sort(into.begin() + offset, into.end());
 }
 
 
 template<class RTREE> void
 MSLane::fill(RTREE& into) {
-    for (DictType::iterator i = myDict.begin(); i != myDict.end(); ++i) {
-        MSLane* l = (*i).second;
+    // insert sorted by id so that the tree does not depend on the hash order
+    std::vector<std::string> ids;
+    insertIDs(ids);
+    for (const std::string& id : ids) {
+        MSLane* l = myDict[id];
         Boundary b = l->getShape().getBoxBoundary();
         b.grow(3.);
         const float cmin[2] = {(float) b.xmin(), (float) b.ymin()};
@@ -2768,6 +2918,14 @@ MSLane::loadState(std::vector<std::string>& vehIds, MSVehicleControl& vc) {
 }
 
 
+void
+MSLane::clearState() {
+    assert(myVehicles.empty() && myPartialVehicles.empty());
+    myLeaderInfoTime = SUMOTime_MIN;
+    myFollowerInfoTime = SUMOTime_MIN;
+}
+
+
 double
 MSLane::getStopOffset(const MSVehicle* veh) const {
     if (myStopOffsets.size()==0) {
@@ -3142,6 +3300,20 @@ MSLane::initCollisionOptions(const OptionsCont& oc) {
 }
 
 
+void
+MSLane::initRNGs(const OptionsCont& oc) {
+    myRNGs.clear();
+    const int numRNGs = oc.getInt("thread-rngs");
+    const bool random = oc.getBool("random");
+    int seed = oc.getInt("seed");
+    myRNGs.reserve(numRNGs); // pointers to the generators must stay valid
+    for (int i = 0; i < numRNGs; i++) {
+        myRNGs.push_back(std::mt19937());
+        RandHelper::initRand(&myRNGs.back(), random, seed++);
+    }
+}
+
+
 void
 MSLane::setPermissions(SVCPermissions permissions, long transientID) {
     if (transientID == CHANGE_PERMISSIONS_PERMANENT) {
@@ -36,18 +36,25 @@
 
 #include <vector>
 #include <deque>
+#include <unordered_map>
 #include <cassert>
+#include <random>
 #include <utils/common/Named.h>
 #include <utils/common/Parameterised.h>
 #include <utils/common/SUMOVehicleClass.h>
 #include <utils/vehicle/SUMOVehicle.h>
 #include <utils/common/NamedRTree.h>
 #include <utils/geom/PositionVector.h>
+#include "MSGlobals.h"
 #include "MSLinkCont.h"
 #include "MSLeaderInfo.h"
 #include "MSMoveReminder.h"
 #include <libsumo/Helper.h>
 
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXWorkerThread.h>
+#endif
+
 
 // ===========================================================================
 // class declarations
@@ -345,6 +352,7 @@ public:
      * @param[in] minPos The minimum position from which to start search for leaders
      * @param[in] allowCached Whether the cached value may be used
      * @return Information about the last vehicles
+     * @note The returned reference is valid until the next uncached call (on the same thread)
      */
     const MSLeaderInfo& getLastVehicleInformation(const MSVehicle* ego, double latOffset, double minPos = 0, bool allowCached = true) const;
 
@@ -536,6 +544,27 @@ public:
      */
     virtual void planMovements(const SUMOTime t);
 
+    /** @brief Register junction approaches for all vehicles after velocities have been planned.
+     *
+     * This method goes through all vehicles calling their "setApproachingForAllLinks" method.
+     * The time parameter is only there to match the signature of the other movement phases.
+     * It is kept separate from planMovements so that all vehicles see the same
+     * approach information of the previous step regardless of the order
+     * (or the thread) in which the lanes are processed.
+     * @see MSVehicle::setApproachingForAllLinks
+     */
+    void setJunctionApproaches(const SUMOTime t);
+
+    /** @brief Computes the follow speeds of the vehicles in their action step with respect to their leader on this lane
+     *
+     * Assigns the vehicles' slots and calls MSCFModel::followSpeedBatch once for each car-following
+     *  model which overrides the batch computation. Called by planMovements, the results are used
+     *  by MSVehicle::adaptToLeaders if the leader is the next vehicle on this lane (slot + 1).
+     *  All other vehicles compute their follow speeds one by one as before.
+     * @param[in] t The current simulation time
+     */
+    void computeFollowSpeeds(const SUMOTime t);
+
     /** @brief This updates the MSLeaderInfo argument with respect to the given MSVehicle.
      *         All leader-vehicles on the same edge, which are relevant for the vehicle
      *         (i.e. with position > vehicle's position) and not already integrated into
@@ -658,7 +687,7 @@ public:
     }
 
 
-    /** @brief Adds the ids of all stored lanes into the given vector
+    /** @brief Adds the ids of all stored lanes into the given vector (sorted)
      * @param[in, filled] into The vector to add the IDs into
      */
     static void insertIDs(std::vector<std::string>& into);
@@ -1055,6 +1084,12 @@ public:
      * @todo What about throwing an error if something else fails (a vehicle can not be referenced)?
      */
     void loadState(std::vector<std::string>& vehIDs, MSVehicleControl& vc);
+
+    /** @brief Discards the cached leader and follower information
+     *
+     * Needs to be called after all vehicles were removed if the simulation is run again from an earlier time.
+     */
+    void clearState();
     /// @}
 
 
@@ -1071,6 +1106,89 @@ public:
 
     static void initCollisionOptions(const OptionsCont& oc);
 
+    /**
+     * @struct FollowSpeeds
+     * @brief The follow speeds of the vehicles on this lane computed in a batch
+     *
+     * followSpeed and haveFollowSpeed are indexed by the vehicles' slots which
+     *  equal their index in myVehicles, so the vehicle furthest downstream has the
+     *  highest slot and its leader on this lane (if any) is found at slot + 1.
+     *  The follow speeds are computed at the begin of planMovements (see
+     *  computeFollowSpeeds) and are only valid until planMovements is finished.
+     *  The other arrays are the input of MSCFModel::followSpeedBatch, they are
+     *  kept with the lane so that they need no allocation in each step.
+     */
+    struct FollowSpeeds {
+        /// @brief the follow speeds with respect to the leader on this lane
+        std::vector<double> followSpeed;
+        /// @brief whether the follow speed of a slot was computed (only for vehicles in their action step)
+        std::vector<bool> haveFollowSpeed;
+        /// @brief whether followSpeed is valid (only during planMovements)
+        bool valid;
+
+        /// @brief the slots of the vehicles in the batch, grouped by their car-following model
+        std::vector<int> slots;
+        /// @brief the vehicles of one car-following model and their leaders
+        std::vector<const MSVehicle*> vehs;
+        std::vector<const MSVehicle*> preds;
+        /// @brief the speeds, gaps, leader speeds and leader decelerations of the vehicles
+        std::vector<double> speed;
+        std::vector<double> gap;
+        std::vector<double> predSpeed;
+        std::vector<double> predDecel;
+        /// @brief the follow speeds of the vehicles of one car-following model
+        std::vector<double> result;
+
+        FollowSpeeds() : valid(false) {}
+    };
+
+    /// @brief returns the follow speeds computed in a batch (see FollowSpeeds)
+    const FollowSpeeds& getFollowSpeeds() const {
+        return myFollowSpeeds;
+    }
+
+    /** @brief initializes the random number generators used during the movement phases
+     *
+     * Each lane uses one of "thread-rngs" generators (determined by its numerical id)
+     * so that the random numbers drawn for the vehicles on a lane do not depend on
+     * the number of threads.
+     */
+    static void initRNGs(const OptionsCont& oc);
+
+    /** @brief return the random number generator associated with this lane
+     * @return The lane's generator
+     */
+    std::mt19937* getRNG() const {
+        return &myRNGs[myRNGIndex];
+    }
+
+    /// @brief return the index of the random number generator associated with this lane
+    int getRNGIndex() const {
+        return myRNGIndex;
+    }
+
+    /// @brief return the number of random number generators
+    static int getNumRNGs() {
+        return (int)myRNGs.size();
+    }
+
+    /** @brief sets whether the movements of the lanes are currently planned in parallel
+     *
+     * While this is set the cached leader and follower information is only computed
+     *  once per step since it is referenced concurrently.
+     */
+    static void setParallelPlanMovements(const bool value) {
+        myParallelPlanMovements = value;
+    }
+
+#ifdef HAVE_FOX
+    /// @brief returns the task which plans the movements of the vehicles on this lane
+    FXWorkerThread::Task* getPlanMoveTask(const SUMOTime time) {
+        mySimulationTask.init(&MSLane::planMovements, time);
+        return &mySimulationTask;
+    }
+#endif
+
     static bool teleportOnCollision() {
         return myCollisionAction == COLLISION_ACTION_TELEPORT;
     }
@@ -1119,6 +1237,9 @@ protected:
     /// @brief compute maximum braking distance on this lane
     double getMaximumBrakeDist() const;
 
+    /// @brief returns the (reinitialized) storage for uncached leader / follower information of the calling thread
+    MSLeaderInfo& resetLeaderInfoTmp(const MSVehicle* ego, double latOffset) const;
+
     /* @brief determine depart speed and whether it may be patched
      * @param[in] veh The departing vehicle
      * @param[out] whether the speed may be patched to account for safety
@@ -1139,6 +1260,20 @@ protected:
     /// @brief departure position where the vehicle fits fully onto the lane (if possible)
     double basePos(const MSVehicle& veh) const;
 
+    /** @brief check whether the last vehicle on this lane leaves no room for inserting veh at pos
+     *
+     * This is the leader check of isInsertionSuccess for the vehicle with
+     *  the smallest position only, so it costs O(1). If it returns true,
+     *  isInsertionSuccess would reject the vehicle as well (as long as the speed
+     *  may be patched). The result only changes when the last vehicle moves or
+     *  leaves the lane, so a lane which is blocked at the insertion position
+     *  does not need the full check for all vehicles waiting to depart there.
+     * @param[in] veh The vehicle to insert
+     * @param[in] pos The position at which it shall be inserted
+     * @return Whether the insertion would collide with the last vehicle
+     */
+    bool insertionBlockedByLast(const MSVehicle& veh, double pos) const;
+
     /// @brief check whether pedestrians on this lane interfere with vehicle insertion
     bool checkForPedestrians(const MSVehicle* aVehicle, double& speed, double& dist, double pos, bool patchSpeed) const;
 
@@ -1192,6 +1327,9 @@ protected:
      *   of this container and the leaving ones leave from the back. */
     VehCont myManeuverReservations;
 
+    /// @brief the follow speeds computed in a batch (read by MSVehicle::adaptToLeaders)
+    FollowSpeeds myFollowSpeeds;
+
     /* @brief list of vehicles that are parking near this lane
      * (not necessarily on the road but having reached their stop on this lane)
      * */
@@ -1253,6 +1391,7 @@ protected:
     /// @brief followers on all sublanes as seen by vehicles on consecutive lanes (cached)
     mutable MSLeaderInfo myFollowerInfo;
 
+    /// @brief storage for uncached leader / follower information (serial simulation only)
     mutable MSLeaderInfo myLeaderInfoTmp;
 
     /// @brief time step for which myLeaderInfo was last updated
@@ -1277,8 +1416,8 @@ protected:
     // @brief transient changes in permissions
     std::map<long, SVCPermissions> myPermissionChanges;
 
-    /// definition of the static dictionary type
-    typedef std::map< std::string, MSLane* > DictType;
+    /// definition of the static dictionary type (unordered, use insertIDs for sorted access)
+    typedef std::unordered_map< std::string, MSLane* > DictType;
 
     /// Static dictionary to associate string-ids with objects.
     static DictType myDict;
@@ -1293,6 +1432,50 @@ private:
     static SUMOTime myCollisionStopTime;
     static double myCollisionMinGapFactor;
 
+    /// @brief the random number generators shared by the lanes (see initRNGs)
+    static std::vector<std::mt19937> myRNGs;
+
+    /// @brief the index of the random number generator used by this lane
+    const int myRNGIndex;
+
+    /// @brief whether planMovements is currently called in parallel (see setParallelPlanMovements)
+    static bool myParallelPlanMovements;
+
+#ifdef HAVE_FOX
+    /**
+     * @class SimulationTask
+     * @brief the task which runs one of the movement phases for all vehicles of the lane
+     */
+    class SimulationTask : public FXWorkerThread::Task {
+    public:
+        SimulationTask(MSLane& l, const SUMOTime time)
+            : myLane(l), myTime(time) {}
+        void init(void (MSLane::*operation)(const SUMOTime), const SUMOTime time) {
+            myOperation = operation;
+            myTime = time;
+        }
+        void run(FXWorkerThread* /*context*/) {
+            (myLane.*(myOperation))(myTime);
+        }
+    private:
+        /// @brief the movement phase to run
+        void (MSLane::*myOperation)(const SUMOTime);
+        /// @brief the lane to work on
+        MSLane& myLane;
+        /// @brief the current simulation time
+        SUMOTime myTime;
+    private:
+        /// @brief Invalidated assignment operator.
+        SimulationTask& operator=(const SimulationTask&);
+    };
+
+    /// @brief the task object for parallel simulation (reused in every step)
+    SimulationTask mySimulationTask;
+
+    /// @brief mutex guarding the cached leader and follower information
+    mutable FXMutex myLeaderInfoMutex;
+#endif
+
     /**
      * @class vehicle_position_sorter
      * @brief Sorts vehicles by their position (descending)
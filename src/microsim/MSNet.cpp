@@ -104,6 +104,8 @@
 #include "MSContainer.h"
 #include "MSEdgeWeightsStorage.h"
 #include "MSStateHandler.h"
+#include "MSStepProfiler.h"
+#include "MSPositionGrid.h"
 #include "MSFrame.h"
 #include "MSParkingArea.h"
 #include "MSStoppingPlace.h"
@@ -189,6 +191,10 @@ MSNet::MSNet(MSVehicleControl* vc, MSEventControl* beginOfTimestepEvents,
     myMaxTeleports = oc.getInt("max-num-teleports");
     myLogExecutionTime = !oc.getBool("no-duration-log");
     myLogStepNumber = !oc.getBool("no-step-log");
+    // the output streams are built after the network, getDevice opens the file already (the header follows later)
+    myStepProfiler = new MSStepProfiler(oc.getBool("duration-log.phases"),
+                                        oc.isSet("step-profile-output") ? &OutputDevice::getDevice(oc.getString("step-profile-output")) : 0,
+                                        string2time(oc.getString("step-profile-output.period")));
     myInserter = new MSInsertionControl(*vc, string2time(oc.getString("max-depart-delay")), oc.getBool("eager-insert"), oc.getInt("max-num-vehicles"));
     myVehicleControl = vc;
     myDetectorControl = new MSDetectorControl();
@@ -199,6 +205,7 @@ MSNet::MSNet(MSVehicleControl* vc, MSEventControl* beginOfTimestepEvents,
     myPersonControl = 0;
     myContainerControl = 0;
     myEdgeWeights = 0;
+    myPositionGrid = 0;
     myShapeContainer = shapeCont == 0 ? new ShapeContainer() : shapeCont;
 
     myBeginOfTimestepEvents = beginOfTimestepEvents;
@@ -276,6 +283,8 @@ MSNet::~MSNet() {
     myInsertionEvents = nullptr;
     delete myShapeContainer;
     delete myEdgeWeights;
+    delete myPositionGrid;
+    delete myStepProfiler;
     delete myRouterTT;
     delete myRouterEffort;
     if (myPedestrianRouter != nullptr) {
@@ -373,6 +382,7 @@ MSNet::closeSimulation(SUMOTime start) {
     if (OptionsCont::getOptions().isSet("chargingstations-output")) {
         writeChargingStationOutput();
     }
+    myStepProfiler->close(myStep);
     if (myLogExecutionTime) {
         long duration = SysUtils::getCurrentMillis() - mySimBeginMillis;
         std::ostringstream msg;
@@ -422,12 +432,51 @@ MSNet::closeSimulation(SUMOTime start) {
         }
         if (OptionsCont::getOptions().getBool("duration-log.statistics")) {
             msg << MSDevice_Tripinfo::printStatistics();
+            msg << MSDevice_Routing::printStatistics();
+        }
+        if (myStepProfiler->isActive()) {
+            msg << myStepProfiler->getSummary();
         }
         WRITE_MESSAGE(msg.str());
     }
 }
 
 
+void
+MSNet::clearState(const SUMOTime step) {
+    std::vector<SUMOVehicle*> vehicles;
+    for (MSVehicleControl::constVehIt it = myVehicleControl->loadedVehBegin(); it != myVehicleControl->loadedVehEnd(); ++it) {
+        vehicles.push_back(it->second);
+    }
+    for (SUMOVehicle* const veh : vehicles) {
+        if (veh->hasDeparted()) {
+            MSVehicle* const microVeh = static_cast<MSVehicle*>(veh);
+            microVeh->onRemovalFromNet(MSMoveReminder::NOTIFICATION_VAPORIZED);
+            if (microVeh->getLane() != 0) {
+                microVeh->getLane()->removeVehicle(microVeh, MSMoveReminder::NOTIFICATION_VAPORIZED, false);
+            }
+        } else {
+            myInserter->alreadyDeparted(veh);
+        }
+        myVehicleControl->deleteVehicle(veh, true);
+    }
+    myVehicleControl->clearState();
+    myInserter->clearState();
+    for (MSEdge* const edge : MSEdge::getAllEdges()) {
+        for (MSLane* const lane : edge->getLanes()) {
+            lane->clearState();
+        }
+    }
+    myBeginOfTimestepEvents->clearState(myStep, step);
+    myEndOfTimestepEvents->clearState(myStep, step);
+    myInsertionEvents->clearState(myStep, step);
+    myLogics->clearState(myStep, step);
+    myDetectorControl->clearState(myStep);
+    invalidatePositionGrid();
+    myStep = step;
+}
+
+
 void
 MSNet::simulationStep() {
 #ifdef DEBUG_SIMSTEP
@@ -435,6 +484,7 @@ MSNet::simulationStep() {
               << ", myStep = " << myStep
               << std::endl;
 #endif
+    myStepProfiler->startStep();
     if (myLogExecutionTime) {
         myTraCIStepDuration = SysUtils::getCurrentMillis();
     }
@@ -450,6 +500,7 @@ MSNet::simulationStep() {
     if (myLogExecutionTime) {
         myTraCIStepDuration = SysUtils::getCurrentMillis() - myTraCIStepDuration;
     }
+    myStepProfiler->endPhase(MSStepProfiler::PHASE_TRACI);
 #ifdef DEBUG_SIMSTEP
     std::cout << SIMTIME << ": TraCI target time: " << t->getTargetTime() << std::endl;
 #endif
@@ -467,30 +518,39 @@ MSNet::simulationStep() {
         MSStateHandler::saveState(myStateDumpPrefix + "_" + time2string(myStep) + myStateDumpSuffix, myStep);
     }
     myBeginOfTimestepEvents->execute(myStep);
+    myStepProfiler->endPhase(MSStepProfiler::PHASE_BEGIN_EVENTS);
 #ifdef HAVE_FOX
     MSDevice_Routing::waitForAll();
+    myStepProfiler->endPhase(MSStepProfiler::PHASE_ROUTING);
 #endif
     if (MSGlobals::gCheck4Accidents) {
         myEdges->detectCollisions(myStep, STAGE_EVENTS);
     }
     // check whether the tls programs need to be switched
     myLogics->check2Switch(myStep);
+    myStepProfiler->endPhase(MSStepProfiler::PHASE_BEGIN_EVENTS);
 
     if (MSGlobals::gUseMesoSim) {
         MSGlobals::gMesoNet->simulate(myStep);
+        myStepProfiler->endPhase(MSStepProfiler::PHASE_EXECUTE_MOVE);
     } else {
         // assure all lanes with vehicles are 'active'
         myEdges->patchActiveLanes();
 
         // compute safe velocities for all vehicles for the next few lanes
-        // also register ApproachingVehicleInformation for all links
         myEdges->planMovements(myStep);
+        myStepProfiler->endPhase(MSStepProfiler::PHASE_PLAN_MOVE);
+
+        // register junction approaches based on planned velocities as basis for right-of-way decision
+        myEdges->setJunctionApproaches(myStep);
+        myStepProfiler->endPhase(MSStepProfiler::PHASE_JUNCTION_APPROACHES);
 
         // decide right-of-way and execute movements
         myEdges->executeMovements(myStep);
         if (MSGlobals::gCheck4Accidents) {
             myEdges->detectCollisions(myStep, STAGE_MOVEMENTS);
         }
+        myStepProfiler->endPhase(MSStepProfiler::PHASE_EXECUTE_MOVE);
 
         // vehicles may change lanes
         myEdges->changeLanes(myStep);
@@ -498,6 +558,7 @@ MSNet::simulationStep() {
         if (MSGlobals::gCheck4Accidents) {
             myEdges->detectCollisions(myStep, STAGE_LANECHANGE);
         }
+        myStepProfiler->endPhase(MSStepProfiler::PHASE_LANE_CHANGE);
     }
     loadRoutes();
 
@@ -512,8 +573,10 @@ MSNet::simulationStep() {
     // insert vehicles
     myInserter->determineCandidates(myStep);
     myInsertionEvents->execute(myStep);
+    myStepProfiler->endPhase(MSStepProfiler::PHASE_INSERTION);
 #ifdef HAVE_FOX
     MSDevice_Routing::waitForAll();
+    myStepProfiler->endPhase(MSStepProfiler::PHASE_ROUTING);
 #endif
     myInserter->emitVehicles(myStep);
     if (MSGlobals::gCheck4Accidents) {
@@ -521,21 +584,30 @@ MSNet::simulationStep() {
         myEdges->detectCollisions(myStep, STAGE_INSERTIONS);
     }
     MSVehicleTransfer::getInstance()->checkInsertions(myStep);
+    myStepProfiler->endPhase(MSStepProfiler::PHASE_INSERTION);
 
+    // the positions are final for this step
+    invalidatePositionGrid();
     // execute endOfTimestepEvents
     myEndOfTimestepEvents->execute(myStep);
+    myStepProfiler->endPhase(MSStepProfiler::PHASE_END_EVENTS);
 
     if (TraCIServer::getInstance() != 0) {
         if (myLogExecutionTime) {
             myTraCIStepDuration -= SysUtils::getCurrentMillis();
         }
         libsumo::Helper::postProcessRemoteControl();
+        // the remote controlled vehicles and persons have been moved
+        invalidatePositionGrid();
         if (myLogExecutionTime) {
             myTraCIStepDuration += SysUtils::getCurrentMillis();
         }
+        myStepProfiler->endPhase(MSStepProfiler::PHASE_TRACI);
     }
     // update and write (if needed) detector values
     writeOutput();
+    myStepProfiler->endPhase(MSStepProfiler::PHASE_OUTPUT);
+    myStepProfiler->finishStep(myStep);
 
     if (myLogExecutionTime) {
         mySimStepDuration = SysUtils::getCurrentMillis() - mySimStepDuration;
@@ -767,12 +839,29 @@ MSNet::getContainerControl() {
 MSEdgeWeightsStorage&
 MSNet::getWeightsStorage() {
     if (myEdgeWeights == 0) {
-        myEdgeWeights = new MSEdgeWeightsStorage();
+        myEdgeWeights = new MSEdgeWeightsStorage(true);
     }
     return *myEdgeWeights;
 }
 
 
+MSPositionGrid&
+MSNet::getPositionGrid() {
+    if (myPositionGrid == 0) {
+        myPositionGrid = new MSPositionGrid(GeoConvHelper::getFinal().getConvBoundary(), MSGlobals::gNumSimThreads);
+    }
+    return *myPositionGrid;
+}
+
+
+void
+MSNet::invalidatePositionGrid() {
+    if (myPositionGrid != 0) {
+        myPositionGrid->invalidate();
+    }
+}
+
+
 void
 MSNet::preSimStepOutput() const {
     std::cout << "Step #" << time2string(myStep);
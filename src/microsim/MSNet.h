@@ -71,6 +71,8 @@ class MSDetectorControl;
 class ShapeContainer;
 class BinaryInputDevice;
 class MSEdgeWeightsStorage;
+class MSStepProfiler;
+class MSPositionGrid;
 class SUMOVehicle;
 template<class E, class L, class N, class V>
 class IntermodalRouter;
@@ -231,6 +233,17 @@ public:
     void closeSimulation(SUMOTime start);
 
 
+    /** @brief Removes all vehicles and resets the simulation to the given time step
+     *
+     * Pending events (including traffic light switches) are moved by the difference
+     *  to the new time and detector intervals are written and restarted. Vehicles are
+     *  deleted without generating output. Used to simulate the same period repeatedly.
+     *
+     * @param[in] step The time step to continue the simulation from
+     */
+    void clearState(const SUMOTime step);
+
+
     /** @brief Called after a simulation step, this method returns the current simulation state
      * @param[in] stopTime The time the simulation shall stop at
      * @return The current simulation state
@@ -379,6 +392,16 @@ public:
     }
 
 
+    /** @brief Returns the step profiler
+     * @return The profiler of the simulation step phases
+     * @see MSStepProfiler
+     * @see myStepProfiler
+     */
+    const MSStepProfiler& getStepProfiler() const {
+        return *myStepProfiler;
+    }
+
+
     /** @brief Returns the junctions control
      * @return The junctions control
      * @see MSJunctionControl
@@ -434,6 +457,22 @@ public:
      * @return The net's knowledge about edge weights
      */
     MSEdgeWeightsStorage& getWeightsStorage();
+
+    /** @brief Returns the grid of the vehicle and person positions
+     *
+     * If the net does not have a grid, it is built. The grid is invalidated
+     *  in each step before the end of timestep events.
+     * @return The grid of the positions
+     */
+    MSPositionGrid& getPositionGrid();
+
+
+    /** @brief Marks the grid of the positions as outdated
+     *
+     * Has to be called whenever vehicles or persons are moved or removed
+     *  outside of the simulation step (e.g. by TraCI).
+     */
+    void invalidatePositionGrid();
     /// @}
 
     /// @name Insertion and retrieval of stopping places
@@ -656,6 +695,8 @@ protected:
     ShapeContainer* myShapeContainer;
     /// @brief The net's knowledge about edge efforts/travel times; @see MSEdgeWeightsStorage
     MSEdgeWeightsStorage* myEdgeWeights;
+    /// @brief The grid of the vehicle and person positions; @see MSPositionGrid
+    MSPositionGrid* myPositionGrid;
     /// @}
 
 
@@ -677,6 +718,9 @@ protected:
 
     /// @brief The overall number of vehicle movements
     long long int myVehiclesMoved;
+
+    /// @brief The profiler of the simulation step phases
+    MSStepProfiler* myStepProfiler;
     //}
 
 
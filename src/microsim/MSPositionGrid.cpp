@@ -0,0 +1,200 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    MSPositionGrid.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// A uniform grid of the positions of all vehicles and persons
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cmath>
+#include <algorithm>
+#include <utils/common/StdDefs.h>
+#include <utils/vehicle/SUMOVehicle.h>
+#include "MSNet.h"
+#include "MSTransportable.h"
+#include "MSTransportableControl.h"
+#include "MSVehicleControl.h"
+#include "MSPositionGrid.h"
+
+
+// ===========================================================================
+// static members
+// ===========================================================================
+/// @brief the minimum size of a cell
+static const double MIN_CELL_SIZE = 100.;
+/// @brief the maximum number of cells (the cells get larger for large networks)
+static const double MAX_CELLS = 1e6;
+/// @brief the minimum number of objects for a single thread
+static const int MIN_CHUNK_SIZE = 256;
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+MSPositionGrid::MSPositionGrid(const Boundary& boundary, const int numThreads) :
+    myBoundary(boundary), myAmValid(false) {
+    const double width = MAX2(myBoundary.getWidth(), 1.);
+    const double height = MAX2(myBoundary.getHeight(), 1.);
+    myCellSize = MAX2(MIN_CELL_SIZE, sqrt(width * height / MAX_CELLS));
+    myColumns = (int)ceil(width / myCellSize);
+    myRows = (int)ceil(height / myCellSize);
+#ifdef HAVE_FOX
+    if (numThreads > 1) {
+        while (myThreadPool.size() < numThreads) {
+            new FXWorkerThread(myThreadPool);
+        }
+    }
+#else
+    UNUSED_PARAMETER(numThreads);
+#endif
+}
+
+
+MSPositionGrid::~MSPositionGrid() {}
+
+
+void
+MSPositionGrid::getVehicles(const Boundary& b, std::vector<VehicleEntry>& into) {
+    if (!myAmValid) {
+        rebuild();
+    }
+    query(myVehicles, b, into);
+}
+
+
+void
+MSPositionGrid::getPersons(const Boundary& b, std::vector<PersonEntry>& into) {
+    if (!myAmValid) {
+        rebuild();
+    }
+    query(myPersons, b, into);
+}
+
+
+void
+MSPositionGrid::rebuild() {
+    MSNet* const net = MSNet::getInstance();
+    std::vector<VehicleEntry> vehicles;
+    const MSVehicleControl& vc = net->getVehicleControl();
+    for (MSVehicleControl::constVehIt i = vc.loadedVehBegin(); i != vc.loadedVehEnd(); ++i) {
+        const SUMOVehicle* const veh = i->second;
+        // parked vehicles are not on the road
+        if (veh->hasDeparted() && !veh->hasArrived() && !veh->isParking()) {
+            vehicles.push_back(VehicleEntry(veh, Position::INVALID));
+        }
+    }
+    fill(myVehicles, vehicles);
+    std::vector<PersonEntry> persons;
+    if (net->hasPersons()) {
+        const MSTransportableControl& pc = net->getPersonControl();
+        for (MSTransportableControl::constVehIt i = pc.loadedBegin(); i != pc.loadedEnd(); ++i) {
+            const MSTransportable* const p = i->second;
+            const MSTransportable::StageType stage = p->getCurrentStageType();
+            if (stage == MSTransportable::WAITING_FOR_DEPART) {
+                continue;
+            }
+            if (stage == MSTransportable::DRIVING && !p->isWaiting4Vehicle()) {
+                // riding persons are found as long as their vehicle is on the road
+                const SUMOVehicle* const veh = p->getVehicle();
+                if (veh == 0 || veh->isParking()) {
+                    continue;
+                }
+            }
+            persons.push_back(PersonEntry(p, Position::INVALID));
+        }
+    }
+    fill(myPersons, persons);
+    myAmValid = true;
+}
+
+
+template<class T> void
+MSPositionGrid::fill(Layer<T>& layer, std::vector<std::pair<const T*, Position> >& entries) {
+    const int numEntries = (int)entries.size();
+#ifdef HAVE_FOX
+    if (myThreadPool.size() > 0 && numEntries >= 2 * MIN_CHUNK_SIZE) {
+        const int numChunks = MIN2(myThreadPool.size(), numEntries / MIN_CHUNK_SIZE);
+        for (int i = 0; i < numChunks; i++) {
+            myThreadPool.add(new PositionTask<T>(entries, numEntries * i / numChunks, numEntries * (i + 1) / numChunks), i);
+        }
+        myThreadPool.waitAll();
+    } else {
+#endif
+        for (typename std::vector<std::pair<const T*, Position> >::iterator i = entries.begin(); i != entries.end(); ++i) {
+            i->second = i->first->getPosition();
+        }
+#ifdef HAVE_FOX
+    }
+#endif
+    // counting sort by cell
+    layer.cellStart.assign(myColumns * myRows + 1, 0);
+    std::vector<int> cells(numEntries, -1);
+    for (int i = 0; i < numEntries; i++) {
+        const Position& pos = entries[i].second;
+        if (pos != Position::INVALID) {
+            cells[i] = getRow(pos.y()) * myColumns + getColumn(pos.x());
+            layer.cellStart[cells[i] + 1]++;
+        }
+    }
+    for (int i = 1; i < (int)layer.cellStart.size(); i++) {
+        layer.cellStart[i] += layer.cellStart[i - 1];
+    }
+    std::vector<int> next(layer.cellStart.begin(), layer.cellStart.end() - 1);
+    layer.entries.resize(layer.cellStart.back());
+    for (int i = 0; i < numEntries; i++) {
+        if (cells[i] >= 0) {
+            layer.entries[next[cells[i]]++] = entries[i];
+        }
+    }
+}
+
+
+template<class T> void
+MSPositionGrid::query(const Layer<T>& layer, const Boundary& b, std::vector<std::pair<const T*, Position> >& into) const {
+    const int firstColumn = getColumn(b.xmin());
+    const int lastColumn = getColumn(b.xmax());
+    for (int row = getRow(b.ymin()); row <= getRow(b.ymax()); row++) {
+        // the cells of a row are contiguous
+        const int end = layer.cellStart[row * myColumns + lastColumn + 1];
+        for (int i = layer.cellStart[row * myColumns + firstColumn]; i < end; i++) {
+            if (b.around(layer.entries[i].second)) {
+                into.push_back(layer.entries[i]);
+            }
+        }
+    }
+}
+
+
+int
+MSPositionGrid::getColumn(const double x) const {
+    return (int)MAX2(0., MIN2((double)(myColumns - 1), floor((x - myBoundary.xmin()) / myCellSize)));
+}
+
+
+int
+MSPositionGrid::getRow(const double y) const {
+    return (int)MAX2(0., MIN2((double)(myRows - 1), floor((y - myBoundary.ymin()) / myCellSize)));
+}
+
+
+/****************************************************************************/
+
@@ -0,0 +1,196 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    MSPositionGrid.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// A uniform grid of the positions of all vehicles and persons
+/****************************************************************************/
+#ifndef MSPositionGrid_h
+#define MSPositionGrid_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+#include <utility>
+#include <utils/geom/Boundary.h>
+#include <utils/geom/Position.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXWorkerThread.h>
+#endif
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class MSTransportable;
+class SUMOVehicle;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSPositionGrid
+ * @brief A uniform grid of the positions of all vehicles and persons
+ *
+ * The grid covers the network boundary (objects outside are put into the
+ *  border cells) and stores the objects sorted by cell, so the objects of
+ *  neighboring cells in a row are contiguous. It is rebuilt with the first
+ *  query after it has been invalidated and is shared by all range queries of
+ *  the step (context subscriptions, bluetooth devices). The network invalidates
+ *  it once per step and whenever TraCI moves or removes a vehicle or a person.
+ *  Parked vehicles (and the persons riding in them) are not contained.
+ *  The positions are computed in parallel if threads are used.
+ */
+class MSPositionGrid {
+public:
+    /// @brief A vehicle together with its position
+    typedef std::pair<const SUMOVehicle*, Position> VehicleEntry;
+
+    /// @brief A person together with its position
+    typedef std::pair<const MSTransportable*, Position> PersonEntry;
+
+
+    /** @brief Constructor
+     * @param[in] boundary The boundary of the network
+     * @param[in] numThreads The number of threads for computing the positions
+     */
+    MSPositionGrid(const Boundary& boundary, const int numThreads);
+
+
+    /// @brief Destructor
+    ~MSPositionGrid();
+
+
+    /// @brief Marks the grid as outdated, it is rebuilt with the next query
+    void invalidate() {
+        myAmValid = false;
+    }
+
+
+    /** @brief Collects the vehicles (on the road, not parking) whose position is within the given boundary
+     * @param[in] b The boundary to search in
+     * @param[filled] into The vector to add the vehicles and their positions to
+     */
+    void getVehicles(const Boundary& b, std::vector<VehicleEntry>& into);
+
+
+    /** @brief Collects the persons (walking, waiting or riding in a vehicle on the road) whose position is within the given boundary
+     * @param[in] b The boundary to search in
+     * @param[filled] into The vector to add the persons and their positions to
+     */
+    void getPersons(const Boundary& b, std::vector<PersonEntry>& into);
+
+
+private:
+    /// @brief The objects of a single type sorted by cell
+    template<class T>
+    struct Layer {
+        /// @brief The objects with their positions, sorted by cell (row by row)
+        std::vector<std::pair<const T*, Position> > entries;
+        /// @brief The index of the first entry of each cell (with an additional end marker)
+        std::vector<int> cellStart;
+    };
+
+    /// @brief Collects all objects and sorts them into the cells
+    void rebuild();
+
+    /// @brief Computes the positions of the given objects (in parallel if possible) and sorts them into the layer
+    template<class T>
+    void fill(Layer<T>& layer, std::vector<std::pair<const T*, Position> >& entries);
+
+    /// @brief Collects the entries of the layer within the given boundary
+    template<class T>
+    void query(const Layer<T>& layer, const Boundary& b, std::vector<std::pair<const T*, Position> >& into) const;
+
+    /// @brief Returns the column of the given x coordinate (clamped to the grid)
+    int getColumn(const double x) const;
+
+    /// @brief Returns the row of the given y coordinate (clamped to the grid)
+    int getRow(const double y) const;
+
+#ifdef HAVE_FOX
+    /**
+     * @class PositionTask
+     * @brief the task which computes the positions of a range of objects
+     */
+    template<class T>
+    class PositionTask : public FXWorkerThread::Task {
+    public:
+        PositionTask(std::vector<std::pair<const T*, Position> >& entries, const int begin, const int end)
+            : myEntries(entries), myBegin(begin), myEnd(end) {}
+        void run(FXWorkerThread* /*context*/) {
+            for (int i = myBegin; i < myEnd; i++) {
+                myEntries[i].second = myEntries[i].first->getPosition();
+            }
+        }
+    private:
+        std::vector<std::pair<const T*, Position> >& myEntries;
+        const int myBegin;
+        const int myEnd;
+    private:
+        /// @brief Invalidated assignment operator.
+        PositionTask& operator=(const PositionTask&);
+    };
+#endif
+
+
+private:
+    /// @brief The covered area
+    const Boundary myBoundary;
+
+    /// @brief The width and height of a cell
+    double myCellSize;
+
+    /// @brief The number of columns
+    int myColumns;
+
+    /// @brief The number of rows
+    int myRows;
+
+    /// @brief Whether the grid is up to date
+    bool myAmValid;
+
+    /// @brief The vehicles on the road
+    Layer<SUMOVehicle> myVehicles;
+
+    /// @brief The persons which have departed and are not riding in a parked vehicle
+    Layer<MSTransportable> myPersons;
+
+#ifdef HAVE_FOX
+    /// @brief The pool of threads computing the positions
+    FXWorkerThread::Pool myThreadPool;
+#endif
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    MSPositionGrid(const MSPositionGrid&);
+
+    /// @brief Invalidated assignment operator.
+    MSPositionGrid& operator=(const MSPositionGrid&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,167 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    MSStepProfiler.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// Measures the wall clock time spent in the phases of a simulation step
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <sstream>
+#include <iomanip>
+#include <utils/iodevices/OutputDevice.h>
+#include "MSStepProfiler.h"
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const std::string MSStepProfiler::myPhaseNames[PHASE_NUMBER] = {
+    "traci", "beginEvents", "routing", "planMovements", "junctionApproaches",
+    "executeMovements", "laneChange", "insertion", "endEvents", "output"
+};
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+MSStepProfiler::MSStepProfiler(bool active, OutputDevice* od, SUMOTime period) :
+    myAmActive(active || od != 0),
+    myOutputDevice(od),
+    myPeriod(period),
+    myIntervalBegin(-1),
+    myIntervalSteps(0) {
+    for (int i = 0; i < PHASE_NUMBER; i++) {
+        myCurrent[i] = 0.;
+        myLast[i] = 0.;
+        myInterval[i] = 0.;
+        myTotal[i] = 0.;
+    }
+}
+
+
+MSStepProfiler::~MSStepProfiler() {}
+
+
+void
+MSStepProfiler::finishStep(SUMOTime step) {
+    if (!myAmActive) {
+        return;
+    }
+    if (myIntervalBegin < 0) {
+        myIntervalBegin = step;
+    }
+    for (int i = 0; i < PHASE_NUMBER; i++) {
+        myLast[i] = myCurrent[i];
+        myInterval[i] += myCurrent[i];
+        myTotal[i] += myCurrent[i];
+        myCurrent[i] = 0.;
+    }
+    myIntervalSteps++;
+    if (step + DELTA_T - myIntervalBegin >= myPeriod) {
+        writeInterval(step + DELTA_T);
+    }
+}
+
+
+void
+MSStepProfiler::close(SUMOTime step) {
+    if (myIntervalSteps > 0) {
+        writeInterval(step);
+    }
+}
+
+
+void
+MSStepProfiler::writeInterval(SUMOTime end) {
+    if (myOutputDevice != 0) {
+        double sum = 0.;
+        for (int i = 0; i < PHASE_NUMBER; i++) {
+            sum += myInterval[i];
+        }
+        myOutputDevice->openTag("interval");
+        myOutputDevice->writeAttr("begin", time2string(myIntervalBegin));
+        myOutputDevice->writeAttr("end", time2string(end));
+        myOutputDevice->writeAttr("steps", myIntervalSteps);
+        myOutputDevice->writeAttr("duration", sum);
+        for (int i = 0; i < PHASE_NUMBER; i++) {
+            myOutputDevice->writeAttr(myPhaseNames[i], myInterval[i]);
+        }
+        myOutputDevice->closeTag();
+    }
+    for (int i = 0; i < PHASE_NUMBER; i++) {
+        myInterval[i] = 0.;
+    }
+    myIntervalBegin = end;
+    myIntervalSteps = 0;
+}
+
+
+double
+MSStepProfiler::getLastStepDuration() const {
+    double sum = 0.;
+    for (int i = 0; i < PHASE_NUMBER; i++) {
+        sum += myLast[i];
+    }
+    return sum;
+}
+
+
+std::string
+MSStepProfiler::getSummary() const {
+    double sum = 0.;
+    for (int i = 0; i < PHASE_NUMBER; i++) {
+        sum += myTotal[i];
+    }
+    std::ostringstream msg;
+    msg.setf(std::ios::fixed, std::ios::floatfield);
+    msg << std::setprecision(2);
+    msg << "Step phases: " << "\n";
+    for (int i = 0; i < PHASE_NUMBER; i++) {
+        msg << " " << myPhaseNames[i] << ": " << myTotal[i] << "ms";
+        if (sum > 0.) {
+            msg << " (" << 100. * myTotal[i] / sum << "%)";
+        }
+        msg << "\n";
+    }
+    return msg.str();
+}
+
+
+const std::string&
+MSStepProfiler::getPhaseName(const Phase phase) {
+    return myPhaseNames[phase];
+}
+
+
+MSStepProfiler::Phase
+MSStepProfiler::getPhase(const std::string& name) {
+    for (int i = 0; i < PHASE_NUMBER; i++) {
+        if (myPhaseNames[i] == name) {
+            return (Phase)i;
+        }
+    }
+    return PHASE_NUMBER;
+}
+
+
+/****************************************************************************/
+
@@ -0,0 +1,204 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    MSStepProfiler.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// Measures the wall clock time spent in the phases of a simulation step
+/****************************************************************************/
+#ifndef MSStepProfiler_h
+#define MSStepProfiler_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <chrono>
+#include <string>
+#include <utils/common/SUMOTime.h>
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class OutputDevice;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSStepProfiler
+ * @brief Measures the wall clock time spent in the phases of a simulation step
+ *
+ * The profiler is driven by MSNet::simulationStep which calls startStep at
+ * the beginning of each step and endPhase after each phase. The time since the
+ * last call is attributed to the given phase. If the profiler is not active
+ * all calls return immediately.
+ *
+ * The durations are aggregated over intervals of the given period and written
+ * to the step profile output (if given).
+ */
+class MSStepProfiler {
+public:
+    /// @brief The phases of a simulation step
+    enum Phase {
+        /// @brief TraCI command processing and remote control
+        PHASE_TRACI = 0,
+        /// @brief state saving, begin of step events and traffic light switching
+        PHASE_BEGIN_EVENTS,
+        /// @brief waiting for the routing threads
+        PHASE_ROUTING,
+        /// @brief MSEdgeControl::planMovements
+        PHASE_PLAN_MOVE,
+        /// @brief MSEdgeControl::setJunctionApproaches
+        PHASE_JUNCTION_APPROACHES,
+        /// @brief MSEdgeControl::executeMovements (or the mesoscopic simulation)
+        PHASE_EXECUTE_MOVE,
+        /// @brief MSEdgeControl::changeLanes
+        PHASE_LANE_CHANGE,
+        /// @brief route loading, transportables and vehicle insertion
+        PHASE_INSERTION,
+        /// @brief end of step events
+        PHASE_END_EVENTS,
+        /// @brief output generation
+        PHASE_OUTPUT,
+        /// @brief the number of phases (no real phase)
+        PHASE_NUMBER
+    };
+
+
+    /** @brief Constructor
+     * @param[in] active Whether time measurement shall take place at all
+     * @param[in] od The device to write the interval data to (may be 0)
+     * @param[in] period The aggregation period
+     */
+    MSStepProfiler(bool active, OutputDevice* od, SUMOTime period);
+
+
+    /// @brief Destructor
+    ~MSStepProfiler();
+
+
+    /// @brief Returns whether time measurement takes place
+    bool isActive() const {
+        return myAmActive;
+    }
+
+
+    /// @brief Starts the measurement of a new step
+    inline void startStep() {
+        if (myAmActive) {
+            myLastTime = Clock::now();
+        }
+    }
+
+
+    /// @brief Attributes the time since the last call to the given phase
+    inline void endPhase(const Phase phase) {
+        if (myAmActive) {
+            const Clock::time_point now = Clock::now();
+            myCurrent[phase] += std::chrono::duration<double, std::milli>(now - myLastTime).count();
+            myLastTime = now;
+        }
+    }
+
+
+    /** @brief Finishes the measurement of the given step and writes the interval if it is complete
+     * @param[in] step The step which has just been simulated
+     */
+    void finishStep(SUMOTime step);
+
+
+    /** @brief Writes the data of the last (incomplete) interval
+     * @param[in] step The end of the simulation
+     */
+    void close(SUMOTime step);
+
+
+    /// @brief Returns the time spent in the given phase during the last step in ms
+    double getLastStepDuration(const Phase phase) const {
+        return myLast[phase];
+    }
+
+
+    /// @brief Returns the time spent for the last step in ms
+    double getLastStepDuration() const;
+
+
+    /// @brief Returns a summary of the time spent in each phase over the whole simulation
+    std::string getSummary() const;
+
+
+    /// @brief Returns the name of the phase
+    static const std::string& getPhaseName(const Phase phase);
+
+
+    /// @brief Returns the phase with the given name or PHASE_NUMBER if there is none
+    static Phase getPhase(const std::string& name);
+
+
+private:
+    /// @brief Writes the aggregated interval and resets it
+    void writeInterval(SUMOTime end);
+
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    /// @brief Whether time measurement takes place
+    const bool myAmActive;
+
+    /// @brief The output device to use (may be 0)
+    OutputDevice* const myOutputDevice;
+
+    /// @brief The aggregation period
+    const SUMOTime myPeriod;
+
+    /// @brief The time of the last call to startStep or endPhase
+    Clock::time_point myLastTime;
+
+    /// @brief The durations of the current, the last step, the current interval and the whole simulation
+    double myCurrent[PHASE_NUMBER];
+    double myLast[PHASE_NUMBER];
+    double myInterval[PHASE_NUMBER];
+    double myTotal[PHASE_NUMBER];
+
+    /// @brief The begin of the current interval
+    SUMOTime myIntervalBegin;
+
+    /// @brief The number of steps in the current interval
+    int myIntervalSteps;
+
+    /// @brief The names of the phases
+    static const std::string myPhaseNames[PHASE_NUMBER];
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    MSStepProfiler(const MSStepProfiler&);
+
+    /// @brief Invalidated assignment operator.
+    MSStepProfiler& operator=(const MSStepProfiler&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
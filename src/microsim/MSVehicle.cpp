@@ -671,6 +671,7 @@ MSVehicle::MSVehicle(SUMOVehicleParameter* pars, const MSRoute* route,
     myAmRegisteredAsWaitingForPerson(false),
     myAmRegisteredAsWaitingForContainer(false),
     myHaveToWaitOnNextLink(false),
+    myFollowSpeedSlot(-1),
     myAngle(0),
     myStopDist(std::numeric_limits<double>::max()),
     myCollisionImmunity(-1),
@@ -1681,9 +1682,9 @@ MSVehicle::planMove(const SUMOTime t, const MSLeaderInfo& ahead, const double le
         std::cout << STEPS2TIME(t) << " vehicle '" << getID() << "' skips action." << std::endl;
         }
 #endif
-        // During non-action passed drive items still need to be removed
+        // During non-action passed drive items still need to be removed,
+        // this is done in setApproachingForAllLinks
         // @todo rather work with updating myCurrentDriveItem (refs #3714)
-        removePassedDriveItems();
         return;
     } else {
 #ifdef DEBUG_ACTIONSTEPS
@@ -1693,6 +1694,9 @@ MSVehicle::planMove(const SUMOTime t, const MSLeaderInfo& ahead, const double le
 #endif
 
 
+        // keep the previous drive items for unregistering the approach information
+        // in setApproachingForAllLinks
+        myLFLinkLanesPrev = myLFLinkLanes;
         planMoveInternal(t, ahead, myLFLinkLanes, myStopDist);
 #ifdef DEBUG_PLAN_MOVE
         if (DEBUG_COND) {
@@ -1736,8 +1740,6 @@ MSVehicle::planMoveInternal(const SUMOTime t, MSLeaderInfo ahead, DriveItemVecto
     if (myDriverState != nullptr) {
         myDriverState->registerEgoVehicleState();
     }
-    // remove information about approaching links, will be reset later in this step
-    removeApproachingInformation(lfLinks);
     lfLinks.clear();
     myStopDist = std::numeric_limits<double>::max();
     //
@@ -2176,7 +2178,17 @@ MSVehicle::adaptToLeaders(const MSLeaderInfo& ahead, double latOffset,
                 std::cout << "     pred=" << pred->getID() << " predLane=" << pred->getLane()->getID() << " predPos=" << pred->getPositionOnLane() << " gap=" << gap << " predBack=" << predBack << " seen=" << seen << " lane=" << lane->getID() << " myLane=" << myLane->getID() << "\n";
             }
 #endif
-            adaptToLeader(std::make_pair(pred, gap), seen, lastLink, lane, v, vLinkPass);
+            const MSLane::FollowSpeeds& batch = myLane->getFollowSpeeds();
+            if (lastLink == 0 && lane == myLane && gap >= 0 && batch.valid
+                    && pred->getLane() == myLane && pred->getFollowSpeedSlot() == myFollowSpeedSlot + 1
+                    && batch.haveFollowSpeed[myFollowSpeedSlot]) {
+                // the follow speed was already computed by MSLane::computeFollowSpeeds for the same values
+                const double vsafeLeader = batch.followSpeed[myFollowSpeedSlot];
+                v = MIN2(v, vsafeLeader);
+                vLinkPass = MIN2(vLinkPass, vsafeLeader);
+            } else {
+                adaptToLeader(std::make_pair(pred, gap), seen, lastLink, lane, v, vLinkPass);
+            }
             // task difficulty interface
             if (myDriverState != nullptr) {
                 myDriverState->registerLeader(pred, gap, getSpeed()-pred->getSpeed());
@@ -3473,7 +3485,20 @@ MSVehicle::checkRewindLinkLanes(const double lengthsInFront, DriveItemVector& lf
             }
         }
     }
-    for (DriveItemVector::iterator i = lfLinks.begin(); i != lfLinks.end(); ++i) {
+}
+
+
+void
+MSVehicle::setApproachingForAllLinks() {
+    if (!myActionStep) {
+        // During non-action passed drive items still need to be removed
+        removePassedDriveItems();
+        return;
+    }
+    // remove information about approaching links, will be reset now
+    removeApproachingInformation(myLFLinkLanesPrev);
+    myLFLinkLanesPrev.clear();
+    for (DriveItemVector::iterator i = myLFLinkLanes.begin(); i != myLFLinkLanes.end(); ++i) {
         if ((*i).myLink != 0) {
             if ((*i).myLink->getState() == LINKSTATE_ALLWAY_STOP) {
                 (*i).myArrivalTime += (SUMOTime)RandHelper::rand((int)2); // tie braker
@@ -3484,7 +3509,7 @@ MSVehicle::checkRewindLinkLanes(const double lengthsInFront, DriveItemVector& lf
     }
     if (getLaneChangeModel().getShadowLane() != 0) {
         // register on all shadow links
-        for (DriveItemVector::iterator i = lfLinks.begin(); i != lfLinks.end(); ++i) {
+        for (DriveItemVector::iterator i = myLFLinkLanes.begin(); i != myLFLinkLanes.end(); ++i) {
             if ((*i).myLink != 0) {
                 MSLink* parallelLink = (*i).myLink->getParallelLink(getLaneChangeModel().getShadowDirection());
                 if (parallelLink != 0) {
@@ -43,6 +43,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <random>
 #include "MSGlobals.h"
 #include "MSVehicleType.h"
 #include "MSBaseVehicle.h"
@@ -361,7 +362,7 @@ public:
      * blocking a junction (checkRewindLinkLanes).
      *
      * Finally the ApproachingVehicleInformation is registered for all links that
-     * shall be passed
+     * shall be passed (this is done afterwards in setApproachingForAllLinks)
      *
      * @param[in] t The current timeStep
      * @param[in] ahead The leaders (may be 0)
@@ -369,6 +370,15 @@ public:
      */
     void planMove(const SUMOTime t, const MSLeaderInfo& ahead, const double lengthsInFront);
 
+    /** @brief Register junction approaches for all link items in the current
+     * plan (replacing the approach information of the previous plan)
+     *
+     * This is called for all vehicles after planMove was finished for all of
+     * them so that the right-of-way decisions in planMove are independent of
+     * the order in which the lanes (and vehicles) are processed.
+     */
+    void setApproachingForAllLinks();
+
 
     /** @brief Executes planned vehicle movements with regards to right-of-way
      *
@@ -501,6 +511,23 @@ public:
     }
 
 
+    /** @brief Returns the index of the vehicle in its lane's follow speeds
+     * @return The slot (-1 if the follow speeds were never computed in a batch)
+     * @see MSLane::FollowSpeeds
+     */
+    int getFollowSpeedSlot() const {
+        return myFollowSpeedSlot;
+    }
+
+
+    /** @brief Sets the index of the vehicle in its lane's follow speeds
+     * @param[in] slot The new slot
+     */
+    void setFollowSpeedSlot(const int slot) {
+        myFollowSpeedSlot = slot;
+    }
+
+
     /** @brief Returns the vehicle's action step length in millisecs,
      *         i.e. the interval between two action points.
      * @return The current action step length in ms.
@@ -566,6 +593,15 @@ public:
     }
 
 
+    /** @brief Returns the random number generator to use in the movement phases
+     * @return The generator of the vehicle's current lane (0, the default generator, if it is not on the network)
+     * @see MSLane::getRNG
+     */
+    std::mt19937* getRNG() const {
+        return myLane == 0 ? 0 : myLane->getRNG();
+    }
+
+
     /** @brief Returns the maximal speed for the vehicle on its current lane (including speed factor and deviation,
      *         i.e., not necessarily the allowed speed limit)
      * @return The vehicle's max speed
@@ -1647,7 +1683,7 @@ protected:
 
     /** @brief Erase passed drive items from myLFLinkLanes (and unregister approaching information for
      *         corresponding links). Further, myNextDriveItem is reset.
-     *  @note  This is called in planMove() if the vehicle has no actionstep. All items until the position
+     *  @note  This is called in setApproachingForAllLinks() if the vehicle has no actionstep. All items until the position
      *         myNextDriveItem are deleted. This can happen if myNextDriveItem was increased in processLaneAdvances()
      *         of the previous step.
      */
@@ -1762,6 +1798,9 @@ protected:
 
     bool myHaveToWaitOnNextLink;
 
+    /// @brief the index in the follow speeds of the lane (see MSLane::FollowSpeeds)
+    int myFollowSpeedSlot;
+
     /// @brief the angle in radians (@todo consider moving this into myState)
     double myAngle;
 
@@ -1834,6 +1873,10 @@ protected:
     // TODO: Consider making LFLinkLanes a std::deque for efficient front removal (needs refactoring in checkRewindLinkLanes()...)
     typedef std::vector< DriveProcessItem > DriveItemVector;
     DriveItemVector myLFLinkLanes;
+
+    /// @brief the drive items of the previous action step (for unregistering their approach information)
+    DriveItemVector myLFLinkLanesPrev;
+
     /** @brief iterator pointing to the next item in myLFLinkLanes
     *   @note  This is updated whenever the vehicle advances to a subsequent lane (see processLaneAdvances())
     *          and used for inter-actionpoint actualization of myLFLinkLanes (i.e. deletion of passed items)
@@ -27,6 +27,7 @@
 #include <config.h>
 #endif
 
+#include <algorithm>
 #include "MSVehicleControl.h"
 #include "MSVehicle.h"
 #include "MSLane.h"
@@ -81,6 +82,7 @@ MSVehicleControl::~MSVehicleControl() {
         delete(*i).second;
     }
     myVehicleDict.clear();
+    myVehicleIndex.clear();
     // delete vehicle type distributions
     for (VTypeDistDictType::iterator i = myVTypeDistDict.begin(); i != myVTypeDistDict.end(); ++i) {
         delete(*i).second;
@@ -167,14 +169,24 @@ MSVehicleControl::saveState(OutputDevice& out) {
     out.writeAttr(SUMO_ATTR_END, myEndedVehNo);
     out.writeAttr(SUMO_ATTR_DEPART, myTotalDepartureDelay);
     out.writeAttr(SUMO_ATTR_TIME, myTotalTravelTime).closeTag();
-    // save vehicle types
+    // save vehicle types (sorted by id)
+    std::vector<std::string> typeIDs;
     for (VTypeDictType::iterator it = myVTypeDict.begin(); it != myVTypeDict.end(); ++it) {
-        it->second->getParameter().write(out);
+        typeIDs.push_back(it->first);
     }
+    std::sort(typeIDs.begin(), typeIDs.end());
+    for (const std::string& id : typeIDs) {
+        myVTypeDict[id]->getParameter().write(out);
+    }
+    typeIDs.clear();
     for (VTypeDistDictType::iterator it = myVTypeDistDict.begin(); it != myVTypeDistDict.end(); ++it) {
-        out.openTag(SUMO_TAG_VTYPE_DISTRIBUTION).writeAttr(SUMO_ATTR_ID, it->first);
-        out.writeAttr(SUMO_ATTR_VTYPES, (*it).second->getVals());
-        out.writeAttr(SUMO_ATTR_PROBS, (*it).second->getProbs());
+        typeIDs.push_back(it->first);
+    }
+    std::sort(typeIDs.begin(), typeIDs.end());
+    for (const std::string& id : typeIDs) {
+        out.openTag(SUMO_TAG_VTYPE_DISTRIBUTION).writeAttr(SUMO_ATTR_ID, id);
+        out.writeAttr(SUMO_ATTR_VTYPES, myVTypeDistDict[id]->getVals());
+        out.writeAttr(SUMO_ATTR_PROBS, myVTypeDistDict[id]->getProbs());
         out.closeTag();
     }
     for (VehicleDictType::iterator it = myVehicleDict.begin(); it != myVehicleDict.end(); ++it) {
@@ -183,10 +195,30 @@ MSVehicleControl::saveState(OutputDevice& out) {
 }
 
 
+void
+MSVehicleControl::clearState() {
+    assert(myVehicleDict.empty());
+    myLoadedVehNo = 0;
+    myRunningVehNo = 0;
+    myEndedVehNo = 0;
+    myDiscarded = 0;
+    myCollisions = 0;
+    myTeleportsJam = 0;
+    myTeleportsYield = 0;
+    myTeleportsWrongLane = 0;
+    myEmergencyStops = 0;
+    myTotalDepartureDelay = 0;
+    myTotalTravelTime = 0;
+    myWaiting.clear();
+    myWaitingForPerson = 0;
+    myWaitingForContainer = 0;
+    myPTVehicles.clear();
+}
+
+
 bool
 MSVehicleControl::addVehicle(const std::string& id, SUMOVehicle* v) {
-    VehicleDictType::iterator it = myVehicleDict.find(id);
-    if (it == myVehicleDict.end()) {
+    if (myVehicleIndex.insert(std::make_pair(id, v)).second) {
         // id not in myVehicleDict.
         myVehicleDict[id] = v;
         const SUMOVehicleParameter& pars = v->getParameter();
@@ -210,8 +242,8 @@ MSVehicleControl::addVehicle(const std::string& id, SUMOVehicle* v) {
 
 SUMOVehicle*
 MSVehicleControl::getVehicle(const std::string& id) const {
-    VehicleDictType::const_iterator it = myVehicleDict.find(id);
-    if (it == myVehicleDict.end()) {
+    std::unordered_map<std::string, SUMOVehicle*>::const_iterator it = myVehicleIndex.find(id);
+    if (it == myVehicleIndex.end()) {
         return 0;
     }
     return it->second;
@@ -226,6 +258,7 @@ MSVehicleControl::deleteVehicle(SUMOVehicle* veh, bool discard) {
     }
     if (veh != 0) {
         myVehicleDict.erase(veh->getID());
+        myVehicleIndex.erase(veh->getID());
     }
     delete veh;
 }
@@ -320,12 +353,16 @@ MSVehicleControl::getVType(const std::string& id, std::mt19937* rng) {
 void
 MSVehicleControl::insertVTypeIDs(std::vector<std::string>& into) const {
     into.reserve(into.size() + myVTypeDict.size() + myVTypeDistDict.size());
+    const int typeOffset = (int)into.size();
     for (VTypeDictType::const_iterator i = myVTypeDict.begin(); i != myVTypeDict.end(); ++i) {
         into.push_back((*i).first);
     }
+    std::sort(into.begin() + typeOffset, into.end());
+    const int distOffset = (int)into.size();
     for (VTypeDistDictType::const_iterator i = myVTypeDistDict.begin(); i != myVTypeDistDict.end(); ++i) {
         into.push_back((*i).first);
     }
+    std::sort(into.begin() + distOffset, into.end());
 }
 
 
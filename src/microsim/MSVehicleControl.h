@@ -32,6 +32,7 @@
 #include <cmath>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <set>
 #include <utils/distribution/RandomDistributor.h>
 #include <utils/common/SUMOTime.h>
@@ -460,6 +461,12 @@ public:
     /** @brief Saves the current state into the given stream
      */
     void saveState(OutputDevice& out);
+
+    /** @brief Resets all statistics and the lists of waiting and public transport vehicles
+     *
+     * All vehicles need to be deleted before.
+     */
+    void clearState();
     /// @}
 
     /// @brief avoid counting a vehicle twice if it was loaded from state and route input
@@ -554,8 +561,10 @@ protected:
 
     /// @brief Vehicle dictionary type
     typedef std::map< std::string, SUMOVehicle* > VehicleDictType;
-    /// @brief Dictionary of vehicles
+    /// @brief Dictionary of vehicles (sorted by id for deterministic iteration)
     VehicleDictType myVehicleDict;
+    /// @brief Hash index of the vehicles for the lookup by id
+    std::unordered_map<std::string, SUMOVehicle*> myVehicleIndex;
     /// @}
 
 
@@ -563,13 +572,13 @@ private:
     /// @name Vehicle type container
     /// @{
 
-    /// @brief Vehicle type dictionary type
-    typedef std::map< std::string, MSVehicleType* > VTypeDictType;
+    /// @brief Vehicle type dictionary type (unordered, sort the ids for iteration)
+    typedef std::unordered_map< std::string, MSVehicleType* > VTypeDictType;
     /// @brief Dictionary of vehicle types
     VTypeDictType myVTypeDict;
 
     /// @brief Vehicle type distribution dictionary type
-    typedef std::map< std::string, RandomDistributor<MSVehicleType*>* > VTypeDistDictType;
+    typedef std::unordered_map< std::string, RandomDistributor<MSVehicleType*>* > VTypeDistDictType;
     /// @brief A distribution of vehicle types (probability->vehicle type)
     VTypeDistDictType myVTypeDistDict;
 
@@ -225,6 +225,16 @@ MSCFModel::interactionGap(const MSVehicle* const veh, double vL) const {
 }
 
 
+void
+MSCFModel::followSpeedBatch(const MSVehicle* const* vehs, const double* speeds, const double* gaps,
+                            const double* predSpeeds, const double* predMaxDecels,
+                            const MSVehicle* const* preds, double* result, const int n) const {
+    for (int i = 0; i < n; i++) {
+        result[i] = followSpeed(vehs[i], speeds[i], gaps[i], predSpeeds[i], predMaxDecels[i], preds[i]);
+    }
+}
+
+
 double
 MSCFModel::maxNextSpeed(double speed, const MSVehicle* const /*veh*/) const {
     return MIN2(speed + (double) ACCEL2SPEED(getMaxAccel()), myType->getMaxSpeed());
@@ -123,6 +123,35 @@ public:
     virtual double followSpeed(const MSVehicle* const veh, double speed, double gap2pred, double predSpeed, double predMaxDecel, const MSVehicle* const pred = 0) const = 0;
 
 
+    /** @brief Computes the follow speeds (no dawdling) for a batch of vehicles using this model
+     *
+     * The result for each index equals the result of followSpeed for the same values.
+     *  The default implementation just calls followSpeed for each index. Models may
+     *  override it with a loop over the plain arrays which the compiler can vectorize.
+     * @param[in] vehs The vehicles (EGO)
+     * @param[in] speeds The vehicles' speeds
+     * @param[in] gaps The (netto) distances to the LEADERs
+     * @param[in] predSpeeds The speeds of the LEADERs
+     * @param[in] predMaxDecels The maximum decelerations of the LEADERs
+     * @param[in] preds The LEADERs
+     * @param[out] result The EGOs' safe speeds
+     * @param[in] n The number of vehicles
+     */
+    virtual void followSpeedBatch(const MSVehicle* const* vehs, const double* speeds, const double* gaps,
+                                  const double* predSpeeds, const double* predMaxDecels,
+                                  const MSVehicle* const* preds, double* result, const int n) const;
+
+
+    /** @brief Returns whether the model overrides followSpeedBatch with a faster computation
+     *
+     * Only then the lanes compute the follow speeds of their vehicles in a batch.
+     * @return Whether followSpeedBatch shall be used
+     */
+    virtual bool hasFollowSpeedBatch() const {
+        return false;
+    }
+
+
     /** @brief Computes the vehicle's safe speed (no dawdling)
      * This method is used during the insertion stage. Whereas the method
      * followSpeed returns the desired speed which may be lower than the safe
@@ -80,6 +80,22 @@ MSCFModel_IDM::followSpeed(const MSVehicle* const veh, double speed, double gap2
 }
 
 
+void
+MSCFModel_IDM::followSpeedBatch(const MSVehicle* const* vehs, const double* speeds, const double* gaps,
+                                const double* predSpeeds, const double* predMaxDecels,
+                                const MSVehicle* const* preds, double* result, const int n) const {
+    if (myAdaptationFactor != 1.) {
+        MSCFModel::followSpeedBatch(vehs, speeds, gaps, predSpeeds, predMaxDecels, preds, result, n);
+        return;
+    }
+    // collect the desired speeds first to keep the pointer chasing out of the main loop
+    for (int i = 0; i < n; i++) {
+        result[i] = vehs[i]->getLane()->getVehicleMaxSpeed(vehs[i]);
+    }
+    _vBatch(speeds, gaps, predSpeeds, result, result, n);
+}
+
+
 double
 MSCFModel_IDM::stopSpeed(const MSVehicle* const veh, const double speed, double gap2pred) const {
     if (gap2pred < 0.01) {
@@ -133,6 +149,48 @@ MSCFModel_IDM::_v(const MSVehicle* const veh, const double gap2pred, const doubl
 }
 
 
+void
+MSCFModel_IDM::_vBatch(const double* speeds, const double* gaps, const double* predSpeeds,
+                       const double* desSpeeds, double* result, const int n) const {
+    // same computation as in _v with the loops interchanged, the iterations are
+    // independent of the data so the inner loops run over all vehicles at once
+    static thread_local std::vector<double> newSpeeds;
+    static thread_local std::vector<double> gapsLeft;
+    static thread_local std::vector<double> powers;
+    newSpeeds.assign(speeds, speeds + n);
+    gapsLeft.assign(gaps, gaps + n);
+    powers.resize(n);
+    double* const newSpeed = &newSpeeds[0];
+    double* const gap = &gapsLeft[0];
+    double* const power = &powers[0];
+    // local copies so the compiler need not reload them after each store
+    const double minGap = myType->getMinGap();
+    const double headwayTime = myHeadwayTime;
+    const double twoSqrtAccelDecel = myTwoSqrtAccelDecel;
+    const double accel = myAccel;
+    const double delta = myDelta;
+    const int iterations = myIterations;
+    const double ts = TS;
+    for (int j = 0; j < iterations; j++) {
+        // pow is a library call which is not vectorized, keep it out of the loop below
+        for (int i = 0; i < n; i++) {
+            power[i] = pow(newSpeed[i] / desSpeeds[i], delta);
+        }
+        for (int i = 0; i < n; i++) {
+            const double delta_v = newSpeed[i] - predSpeeds[i];
+            double s = MAX2(0., newSpeed[i] * headwayTime + newSpeed[i] * delta_v / twoSqrtAccelDecel);
+            s += minGap;
+            const double acc = accel * (1. - power[i] - (s * s) / (gap[i] * gap[i]));
+            newSpeed[i] += (acc * ts) / iterations;
+            gap[i] -= MAX2(0., ((newSpeed[i] - predSpeeds[i]) * ts) / iterations);
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        result[i] = MAX2(0., newSpeed[i]);
+    }
+}
+
+
 MSCFModel*
 MSCFModel_IDM::duplicate(const MSVehicleType* vtype) const {
     return new MSCFModel_IDM(vtype, myAccel, myDecel, myEmergencyDecel, myApparentDecel, myHeadwayTime, myDelta, TS / myIterations);
@@ -98,6 +98,22 @@ public:
     double followSpeed(const MSVehicle* const veh, double speed, double gap2pred, double predSpeed, double predMaxDecel, const MSVehicle* const pred = 0) const;
 
 
+    /** @brief Computes the safe speeds (no dawdling) for a batch of vehicles
+     * @see MSCFModel::followSpeedBatch
+     */
+    void followSpeedBatch(const MSVehicle* const* vehs, const double* speeds, const double* gaps,
+                          const double* predSpeeds, const double* predMaxDecels,
+                          const MSVehicle* const* preds, double* result, const int n) const;
+
+
+    /** @brief Returns whether followSpeedBatch is faster than followSpeed (not for IDMM)
+     * @see MSCFModel::hasFollowSpeedBatch
+     */
+    bool hasFollowSpeedBatch() const {
+        return myAdaptationFactor == 1.;
+    }
+
+
     /** @brief Computes the vehicle's safe speed for approaching a non-moving obstacle (no dawdling)
      * @param[in] veh The vehicle (EGO)
      * @param[in] gap2pred The (netto) distance to the the obstacle
@@ -155,10 +171,17 @@ private:
     };
 
 
-private:
+protected:
     double _v(const MSVehicle* const veh, const double gap2pred, const double mySpeed,
               const double predSpeed, const double desSpeed, const bool respectMinGap = true) const;
 
+    /** @brief Computes _v (respecting the minGap) for a batch of vehicles without adaptation
+     * @param[in] desSpeeds The desired speeds of the vehicles
+     * @param[in, out] result The follow speeds, may be the same array as desSpeeds
+     */
+    void _vBatch(const double* speeds, const double* gaps, const double* predSpeeds,
+                 const double* desSpeeds, double* result, const int n) const;
+
 
 private:
     /// @brief The IDM delta exponent
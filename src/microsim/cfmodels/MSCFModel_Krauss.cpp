@@ -91,6 +91,60 @@ MSCFModel_Krauss::followSpeed(const MSVehicle* const veh, double speed, double g
 }
 
 
+void
+MSCFModel_Krauss::followSpeedBatch(const MSVehicle* const* vehs, const double* speeds, const double* gaps,
+                                   const double* predSpeeds, const double* predMaxDecels,
+                                   const MSVehicle* const* preds, double* result, const int n) const {
+    if (!MSGlobals::gSemiImplicitEulerUpdate || getModelID() != SUMO_TAG_CF_KRAUSS) {
+        // derived models may redefine maxNextSpeed
+        MSCFModel::followSpeedBatch(vehs, speeds, gaps, predSpeeds, predMaxDecels, preds, result, n);
+        return;
+    }
+    // this is maximumSafeFollowSpeed (using brakeGapEuler and maximumSafeStopSpeedEuler)
+    // and maxNextSpeed with all branches replaced by selections, split into loops
+    // which the compiler can vectorize (check with -fopt-info-vec). Only sqrt
+    // remains scalar since it is a library call which may set errno
+    static thread_local std::vector<double> gapBuffer;
+    static thread_local std::vector<double> candidateBuffer;
+    gapBuffer.resize(n);
+    candidateBuffer.resize(2 * n);
+    double* const g = &gapBuffer[0];
+    double* const candidates = &candidateBuffer[0];
+    const double decel = myDecel;
+    const double b = ACCEL2SPEED(decel);
+    const double t = myHeadwayTime;
+    const double s = TS;
+    const double accel = ACCEL2SPEED(getMaxAccel());
+    const double maxSpeed = myType->getMaxSpeed();
+    // g is the gap plus the brake gap of the leader minus the slack of maximumSafeStopSpeedEuler,
+    // result holds the radicand of maximumSafeStopSpeedEuler and then its root
+    for (int i = 0; i < n; i++) {
+        // equals ACCEL2SPEED(MAX2(decel, predDecel)) without a conditional multiplication
+        const double speedReduction = MAX2(decel * s, predMaxDecels[i] * s);
+        // speeds are not negative so the conversion equals the one in brakeGapEuler
+        const double steps = (double)(int)(predSpeeds[i] / speedReduction);
+        g[i] = gaps[i] + (steps * predSpeeds[i] - speedReduction * steps * (steps + 1) / 2) * s - NUMERICAL_EPS;
+        result[i] = MAX2(0., (s * s) + (4.0 * ((s * (2.0 * g[i] / b - t)) + (t * t))));
+    }
+    for (int i = 0; i < n; i++) {
+        result[i] = sqrt(result[i]);
+    }
+    for (int i = 0; i < n; i++) {
+        // the operand is positive whenever x is used (g > b), so the conversion equals floor
+        const double nSteps = (double)(int)(.5 - ((t + (result[i] * -0.5)) / s));
+        const double h = 0.5 * nSteps * (nSteps - 1) * b * s + nSteps * b * t;
+        const double x = nSteps * b + (g[i] - h) / (nSteps * s + t);
+        const double gapSpeed = g[i] / s;
+        const double vsafe = g[i] <= 0 ? 0 : (g[i] <= b ? MIN2(b, gapSpeed) : x);
+        // storing both candidates keeps the compiler from moving their divisions into
+        // the branches, which would prevent the vectorization
+        candidates[2 * i] = x;
+        candidates[2 * i + 1] = gapSpeed;
+        result[i] = MIN2(vsafe, MIN2(speeds[i] + accel, maxSpeed));
+    }
+}
+
+
 double
 MSCFModel_Krauss::dawdle2(double speed, double sigma) const {
     if (!MSGlobals::gSemiImplicitEulerUpdate) {
@@ -83,6 +83,24 @@ public:
     double followSpeed(const MSVehicle* const veh, double speed, double gap2pred, double predSpeed, double predMaxDecel, const MSVehicle* const pred = 0) const;
 
 
+    /** @brief Computes the safe speeds (no dawdling) for a batch of vehicles
+     * For the Euler update this is a branch free loop over the arrays which
+     *  the compiler can vectorize, otherwise followSpeed is called for each vehicle.
+     * @see MSCFModel::followSpeedBatch
+     */
+    void followSpeedBatch(const MSVehicle* const* vehs, const double* speeds, const double* gaps,
+                          const double* predSpeeds, const double* predMaxDecels,
+                          const MSVehicle* const* preds, double* result, const int n) const;
+
+
+    /** @brief Returns whether followSpeedBatch is faster than followSpeed (Euler update, no derived model)
+     * @see MSCFModel::hasFollowSpeedBatch
+     */
+    bool hasFollowSpeedBatch() const {
+        return MSGlobals::gSemiImplicitEulerUpdate && getModelID() == SUMO_TAG_CF_KRAUSS;
+    }
+
+
     /** @brief Returns the model's name
      * @return The model's name
      * @see MSCFModel::getModelName
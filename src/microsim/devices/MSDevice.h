@@ -36,6 +36,7 @@
 #include <random>
 #include <microsim/MSMoveReminder.h>
 #include <utils/common/Named.h>
+#include <utils/common/MemoryPool.h>
 #include <utils/common/UtilExceptions.h>
 
 
@@ -110,6 +111,18 @@ public:
     virtual ~MSDevice() { }
 
 
+    /// @brief Allocates the memory for a device from the memory pool
+    static void* operator new(std::size_t size) {
+        return MemoryPool<MSDevice>::allocate(size);
+    }
+
+
+    /// @brief Gives the memory of a device back to the memory pool
+    static void operator delete(void* p, std::size_t size) {
+        MemoryPool<MSDevice>::deallocate(p, size);
+    }
+
+
     /** @brief Returns the vehicle that holds this device
      *
      * @return The vehicle that holds this device
@@ -37,6 +37,8 @@
 #include <microsim/MSEdge.h>
 #include <microsim/MSVehicle.h>
 #include <microsim/MSEventControl.h>
+#include <microsim/MSPositionGrid.h>
+#include <microsim/MSVehicleControl.h>
 #include "MSDevice_Tripinfo.h"
 #include "MSDevice_BTreceiver.h"
 #include "MSDevice_BTsender.h"
@@ -115,16 +117,26 @@ MSDevice_BTreceiver::BTreceiverUpdate::~BTreceiverUpdate() {
 
 SUMOTime
 MSDevice_BTreceiver::BTreceiverUpdate::execute(SUMOTime /*currentTime*/) {
-    // build rtree with senders
-    NamedRTree rt;
+    // the senders on the network are found using the (shared) grid of the vehicle positions,
+    //  the search is extended by the movement during the step and the distance between
+    //  the last recorded and the current position; the senders which left the network,
+    //  are parking (and thus not in the grid) or jumped (more than 100m) are checked directly
+    double maxMove = 0.;
+    std::vector<MSDevice_BTsender::VehicleInformation*> directSenders;
+    const MSVehicleControl& vc = MSNet::getInstance()->getVehicleControl();
     for (std::map<std::string, MSDevice_BTsender::VehicleInformation*>::const_iterator i = MSDevice_BTsender::sVehicles.begin(); i != MSDevice_BTsender::sVehicles.end(); ++i) {
         MSDevice_BTsender::VehicleInformation* vi = (*i).second;
-        Boundary b = vi->getBoxBoundary();
-        b.grow(POSITION_EPS);
-        const float cmin[2] = {(float) b.xmin(), (float) b.ymin()};
-        const float cmax[2] = {(float) b.xmax(), (float) b.ymax()};
-        rt.Insert(cmin, cmax, vi);
+        const SUMOVehicle* const veh = vi->amOnNet && !vi->haveArrived ? vc.getVehicle((*i).first) : 0;
+        const Position pos = veh != 0 ? veh->getPosition() : Position::INVALID;
+        const Boundary b = vi->getBoxBoundary();
+        const double move = pos == Position::INVALID ? 0. : MAX3(b.getWidth(), b.getHeight(), pos.distanceTo2D(vi->updates.back().position));
+        if (pos == Position::INVALID || move > 100. || veh->isParking()) {
+            directSenders.push_back(vi);
+        } else {
+            maxMove = MAX2(maxMove, move);
+        }
     }
+    MSPositionGrid& grid = MSNet::getInstance()->getPositionGrid();
 
     // check visibility for all receivers
     OptionsCont& oc = OptionsCont::getOptions();
@@ -135,11 +147,22 @@ MSDevice_BTreceiver::BTreceiverUpdate::execute(SUMOTime /*currentTime*/) {
         MSDevice_BTreceiver::VehicleInformation* vi = (*i).second;
         Boundary b = vi->getBoxBoundary();
         b.grow(vi->range);
-        const float cmin[2] = {(float) b.xmin(), (float) b.ymin()};
-        const float cmax[2] = {(float) b.xmax(), (float) b.ymax()};
+        Boundary searchBoundary(b);
+        searchBoundary.grow(maxMove + POSITION_EPS);
+        std::vector<MSPositionGrid::VehicleEntry> candidates;
+        grid.getVehicles(searchBoundary, candidates);
         std::set<std::string> surroundingVehicles;
-        Named::StoringVisitor sv(surroundingVehicles);
-        rt.Search(cmin, cmax, sv);
+        for (std::vector<MSPositionGrid::VehicleEntry>::const_iterator j = candidates.begin(); j != candidates.end(); ++j) {
+            std::map<std::string, MSDevice_BTsender::VehicleInformation*>::const_iterator sender = MSDevice_BTsender::sVehicles.find(j->first->getID());
+            if (sender != MSDevice_BTsender::sVehicles.end() && sender->second->getBoxBoundary().grow(POSITION_EPS).distanceTo2D(b) == 0.) {
+                surroundingVehicles.insert(sender->first);
+            }
+        }
+        for (std::vector<MSDevice_BTsender::VehicleInformation*>::const_iterator j = directSenders.begin(); j != directSenders.end(); ++j) {
+            if ((*j)->getBoxBoundary().grow(POSITION_EPS).distanceTo2D(b) == 0.) {
+                surroundingVehicles.insert((*j)->getID());
+            }
+        }
 
         // loop over surrounding vehicles, check visibility status
         for (std::set<std::string>::const_iterator j = surroundingVehicles.begin(); j != surroundingVehicles.end(); ++j) {
@@ -28,6 +28,7 @@
 #include <config.h>
 #endif
 
+#include <sstream>
 #include "MSDevice_Routing.h"
 #include <microsim/MSNet.h>
 #include <microsim/MSLane.h>
@@ -41,6 +42,7 @@
 #include <utils/common/StaticCommand.h>
 #include <utils/common/StringUtils.h>
 #include <utils/vehicle/DijkstraRouter.h>
+#include <utils/vehicle/BidirectionalDijkstraRouter.h>
 #include <utils/vehicle/AStarRouter.h>
 #include <utils/vehicle/CHRouter.h>
 #include <utils/vehicle/CHRouterWrapper.h>
@@ -58,12 +60,19 @@ int MSDevice_Routing::myAdaptationStepsIndex = 0;
 SUMOTime MSDevice_Routing::myAdaptationInterval = -1;
 SUMOTime MSDevice_Routing::myLastAdaptation = -1;
 bool MSDevice_Routing::myWithTaz;
-std::map<std::pair<const MSEdge*, const MSEdge*>, const MSRoute*> MSDevice_Routing::myCachedRoutes;
+RouteCache<MSEdge>* MSDevice_Routing::myRouteCache = 0;
+bool MSDevice_Routing::myShareRoutes = false;
+SUMOTime MSDevice_Routing::myCacheStaleness = 0;
 SUMOAbstractRouter<MSEdge, SUMOVehicle>* MSDevice_Routing::myRouter = 0;
 AStarRouter<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> >* MSDevice_Routing::myRouterWithProhibited = 0;
+SUMOAbstractRouter<MSEdge, SUMOVehicle>* MSDevice_Routing::myCustomizableRouter = 0;
+const AbstractLookupTable<MSEdge, SUMOVehicle>* MSDevice_Routing::myLookupTable = 0;
 double MSDevice_Routing::myRandomizeWeightsFactor = 0;
 #ifdef HAVE_FOX
 FXWorkerThread::Pool MSDevice_Routing::myThreadPool;
+SUMOTime MSDevice_Routing::myLookahead = 0;
+std::shared_ptr<const std::vector<double> > MSDevice_Routing::myEdgeSpeedsSnapshot;
+FXWorkerThread::Pool MSDevice_Routing::myLookaheadPool;
 #endif
 
 
@@ -108,6 +117,18 @@ MSDevice_Routing::insertOptions(OptionsCont& oc) {
     oc.doRegister("device.rerouting.threads", new Option_Integer(0));
     oc.addDescription("device.rerouting.threads", "Routing", "The number of parallel execution threads used for rerouting");
 
+    oc.doRegister("device.rerouting.lookahead", new Option_String("0", "TIME"));
+    oc.addDescription("device.rerouting.lookahead", "Routing", "Start the parallel pre-insertion routing TIME before the departure");
+
+    oc.doRegister("device.rerouting.cache-size", new Option_Integer(10000));
+    oc.addDescription("device.rerouting.cache-size", "Routing", "The maximum number of routes kept for reuse by other vehicles (0 disables the cache)");
+
+    oc.doRegister("device.rerouting.cache-shared", new Option_Bool(false));
+    oc.addDescription("device.rerouting.cache-shared", "Routing", "Reuse the routes of vehicles of the same class between the same edges (not only between taz)");
+
+    oc.doRegister("device.rerouting.cache-staleness", new Option_String("0", "TIME"));
+    oc.addDescription("device.rerouting.cache-staleness", "Routing", "Reuse cached routes computed with edge weights up to TIME older than the current ones");
+
     oc.doRegister("device.rerouting.output", new Option_FileName());
     oc.addDescription("device.rerouting.output", "Routing", "Save adapting weights to FILE");
 
@@ -145,6 +166,25 @@ MSDevice_Routing::checkOptions(OptionsCont& oc) {
         ok = false;
     }
 #endif
+    if (oc.getInt("device.rerouting.cache-size") < 0) {
+        WRITE_ERROR("Negative value for device.rerouting.cache-size!");
+        ok = false;
+    }
+    if (string2time(oc.getString("device.rerouting.cache-staleness")) < 0) {
+        WRITE_ERROR("Negative value for device.rerouting.cache-staleness!");
+        ok = false;
+    }
+    if (string2time(oc.getString("device.rerouting.lookahead")) < 0) {
+        WRITE_ERROR("Negative value for device.rerouting.lookahead!");
+        ok = false;
+    } else if (string2time(oc.getString("device.rerouting.lookahead")) > 0) {
+        if (oc.getInt("device.rerouting.threads") == 0) {
+            WRITE_ERROR("The option device.rerouting.lookahead needs parallel routing (device.rerouting.threads).");
+            ok = false;
+        } else if (oc.getFloat("weights.random-factor") != 1 || oc.getString("routing-algorithm").find("CH") != std::string::npos) {
+            WRITE_WARNING("The option device.rerouting.lookahead is ignored for randomized weights and contraction hierarchies.");
+        }
+    }
     return ok;
 }
 
@@ -168,6 +208,18 @@ MSDevice_Routing::buildVehicleDevices(SUMOVehicle& v, std::vector<MSDevice*>& in
                 WRITE_WARNING("Rerouting is useless if the edge weights do not get updated!");
             }
             OutputDevice::createDeviceByOption("device.rerouting.output", "weights", "meandata_file.xsd");
+            if (oc.getInt("device.rerouting.cache-size") > 0) {
+                myRouteCache = new RouteCache<MSEdge>(oc.getInt("device.rerouting.cache-size"));
+                myShareRoutes = oc.getBool("device.rerouting.cache-shared");
+                myCacheStaleness = string2time(oc.getString("device.rerouting.cache-staleness"));
+            }
+#ifdef HAVE_FOX
+            // the look-ahead routes must not depend on the order of the threads
+            if (oc.getInt("device.rerouting.threads") > 0 && oc.getFloat("weights.random-factor") == 1
+                    && oc.getString("routing-algorithm").find("CH") == std::string::npos) {
+                myLookahead = string2time(oc.getString("device.rerouting.lookahead"));
+            }
+#endif
         }
         // build the device
         into.push_back(new MSDevice_Routing(v, "routing_" + v.getID(), period, prePeriod));
@@ -181,11 +233,23 @@ MSDevice_Routing::buildVehicleDevices(SUMOVehicle& v, std::vector<MSDevice*>& in
 MSDevice_Routing::MSDevice_Routing(SUMOVehicle& holder, const std::string& id,
                                    SUMOTime period, SUMOTime preInsertionPeriod)
     : MSDevice(holder, id), myPeriod(period), myPreInsertionPeriod(preInsertionPeriod), myLastRouting(-1), mySkipRouting(-1), myRerouteCommand(0) {
+#ifdef HAVE_FOX
+    myLookaheadCommand = nullptr;
+    myLookaheadTask = nullptr;
+#endif
     if (myPreInsertionPeriod > 0 || holder.getParameter().wasSet(VEHPARS_FORCE_REROUTE)) {
         // we do always a pre insertion reroute for trips to fill the best lanes of the vehicle with somehow meaningful values (especially for deaprtLane="best")
         myRerouteCommand = new WrappingCommand<MSDevice_Routing>(this, &MSDevice_Routing::preInsertionReroute);
         // if we don't update the edge weights, we might as well reroute now and hopefully use our threads better
         const SUMOTime execTime = myEdgeWeightSettingCommand == nullptr ? -1 : holder.getParameter().depart;
+#ifdef HAVE_FOX
+        const SUMOTime now = MSNet::getInstance()->getCurrentTimeStep();
+        if (myLookahead > 0 && execTime >= now + DELTA_T) {
+            // added first so it runs before the rerouting if both fall into the same step
+            myLookaheadCommand = new WrappingCommand<MSDevice_Routing>(this, &MSDevice_Routing::lookaheadReroute);
+            MSNet::getInstance()->getInsertionEvents()->addEvent(myLookaheadCommand, MAX2(execTime - myLookahead, now));
+        }
+#endif
         MSNet::getInstance()->getInsertionEvents()->addEvent(myRerouteCommand, execTime);
         if (myPreInsertionPeriod == 0) {
             // the event will deschedule and destroy itself so it does not need to be stored
@@ -200,6 +264,10 @@ MSDevice_Routing::~MSDevice_Routing() {
     if (myRerouteCommand != nullptr) {
         myRerouteCommand->deschedule();
     }
+#ifdef HAVE_FOX
+    // the look-ahead task reads the vehicle
+    clearLookahead();
+#endif
 }
 
 
@@ -211,6 +279,9 @@ MSDevice_Routing::notifyEnter(SUMOVehicle& /*veh*/, MSMoveReminder::Notification
             myRerouteCommand->deschedule();
         }
         myRerouteCommand = nullptr;
+#ifdef HAVE_FOX
+        clearLookahead();
+#endif
         // build repetition trigger if routing shall be done more often
         if (myPeriod > 0) {
             myRerouteCommand = new WrappingCommand<MSDevice_Routing>(this, &MSDevice_Routing::wrappedRerouteCommandExecute);
@@ -256,22 +327,66 @@ MSDevice_Routing::preInsertionReroute(const SUMOTime currentTime) {
     if (mySkipRouting == currentTime) {
         return DELTA_T;
     }
-    const MSEdge* source = *myHolder.getRoute().begin();
-    const MSEdge* dest = myHolder.getRoute().getLastEdge();
-    if (source->isTazConnector() && dest->isTazConnector()) {
-        const std::pair<const MSEdge*, const MSEdge*> key = std::make_pair(source, dest);
-        if (myCachedRoutes.find(key) != myCachedRoutes.end()) {
-            if (myCachedRoutes[key]->size() > 2) {
-                myHolder.replaceRoute(myCachedRoutes[key], true);
-                return myPreInsertionPeriod;
-            }
+#ifdef HAVE_FOX
+    if (myLookaheadTask != nullptr) {
+        myLookaheadPool.waitFor(myLookaheadTask);
+        ConstMSEdgeVector legs;
+        myHolder.getRerouteLegs(true, myWithTaz, legs);
+        // the result is only valid if the stops did not change in the meantime
+        const bool valid = legs == myLookaheadTask->getLegs();
+        if (valid) {
+            initEdgeWeights();
+            myLastRouting = currentTime;
+            myHolder.applyReroute(myLookaheadTask->getEdges(), legs, true);
+        }
+        delete myLookaheadTask;
+        myLookaheadTask = nullptr;
+        if (valid) {
+            return myPreInsertionPeriod;
         }
     }
+#endif
     reroute(currentTime, true);
     return myPreInsertionPeriod;
 }
 
 
+#ifdef HAVE_FOX
+SUMOTime
+MSDevice_Routing::lookaheadReroute(const SUMOTime /* currentTime */) {
+    // the event will deschedule and destroy itself
+    myLookaheadCommand = nullptr;
+    initEdgeWeights();
+    const int numThreads = OptionsCont::getOptions().getInt("device.rerouting.threads");
+    while (myLookaheadPool.size() < numThreads) {
+        new WorkerThread(myLookaheadPool, buildRouter(&MSDevice_Routing::getLookaheadEffort));
+    }
+    if (myEdgeSpeedsSnapshot == nullptr) {
+        myEdgeSpeedsSnapshot = std::make_shared<const std::vector<double> >(myEdgeSpeeds);
+    }
+    ConstMSEdgeVector legs;
+    myHolder.getRerouteLegs(true, myWithTaz, legs);
+    myLookaheadTask = new LookaheadTask(myHolder, myHolder.getParameter().depart, legs, myEdgeSpeedsSnapshot);
+    myLookaheadPool.add(myLookaheadTask);
+    return 0;
+}
+
+
+void
+MSDevice_Routing::clearLookahead() {
+    if (myLookaheadCommand != nullptr) {
+        myLookaheadCommand->deschedule();
+        myLookaheadCommand = nullptr;
+    }
+    if (myLookaheadTask != nullptr) {
+        myLookaheadPool.waitFor(myLookaheadTask);
+        delete myLookaheadTask;
+        myLookaheadTask = nullptr;
+    }
+}
+#endif
+
+
 SUMOTime
 MSDevice_Routing::wrappedRerouteCommandExecute(SUMOTime currentTime) {
     reroute(currentTime);
@@ -293,6 +408,19 @@ MSDevice_Routing::getEffort(const MSEdge* const e, const SUMOVehicle* const v, d
 }
 
 
+#ifdef HAVE_FOX
+double
+MSDevice_Routing::getLookaheadEffort(const MSEdge* const e, const SUMOVehicle* const v, double) {
+    const std::vector<double>& edgeSpeeds = static_cast<WorkerThread*>(FXThread::self())->getEdgeSpeeds();
+    const int id = e->getNumericalID();
+    if (id < (int)edgeSpeeds.size()) {
+        return MAX2(e->getLength() / MAX2(edgeSpeeds[id], NUMERICAL_EPS), e->getMinimumTravelTime(v));
+    }
+    return 0;
+}
+#endif
+
+
 double
 MSDevice_Routing::getAssumedSpeed(const MSEdge* edge) {
     return edge->getLength() / getEffort(edge, 0, 0);
@@ -305,11 +433,6 @@ MSDevice_Routing::adaptEdgeEfforts(SUMOTime currentTime) {
     if (MSNet::getInstance()->getVehicleControl().getDepartedVehicleNo() == 0) {
         return myAdaptationInterval;
     }
-    std::map<std::pair<const MSEdge*, const MSEdge*>, const MSRoute*>::iterator it = myCachedRoutes.begin();
-    for (; it != myCachedRoutes.end(); ++it) {
-        it->second->release();
-    }
-    myCachedRoutes.clear();
     const MSEdgeVector& edges = MSNet::getInstance()->getEdgeControl().getEdges();
     if (myAdaptationSteps > 0) {
         // moving average
@@ -332,6 +455,10 @@ MSDevice_Routing::adaptEdgeEfforts(SUMOTime currentTime) {
         }
     }
     myLastAdaptation = currentTime + DELTA_T; // because we run at the end of the time step
+#ifdef HAVE_FOX
+    // running look-ahead tasks keep their snapshot
+    myEdgeSpeedsSnapshot.reset();
+#endif
     if (OptionsCont::getOptions().isSet("device.rerouting.output")) {
         OutputDevice& dev = OutputDevice::getDeviceByOption("device.rerouting.output");
         dev.openTag(SUMO_TAG_INTERVAL);
@@ -351,6 +478,93 @@ MSDevice_Routing::adaptEdgeEfforts(SUMOTime currentTime) {
 }
 
 
+SUMOAbstractRouter<MSEdge, SUMOVehicle>*
+MSDevice_Routing::buildRouter(SUMOAbstractRouter<MSEdge, SUMOVehicle>::Operation operation) {
+    OptionsCont& oc = OptionsCont::getOptions();
+    const std::string routingAlgorithm = oc.getString("routing-algorithm");
+    const bool mayHaveRestrictions = MSNet::getInstance()->hasPermissions() || oc.getInt("remote-port") != 0 || oc.isSet("remote-shm");
+    if (routingAlgorithm == "dijkstra") {
+        if (mayHaveRestrictions) {
+            return new DijkstraRouter<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> >(
+                MSEdge::getAllEdges(), true, operation);
+        } else {
+            return new DijkstraRouter<MSEdge, SUMOVehicle, noProhibitions<MSEdge, SUMOVehicle> >(
+                MSEdge::getAllEdges(), true, operation);
+        }
+    } else if (routingAlgorithm == "bidijkstra") {
+        if (mayHaveRestrictions) {
+            return new BidirectionalDijkstraRouter<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> >(
+                MSEdge::getAllEdges(), true, operation);
+        } else {
+            return new BidirectionalDijkstraRouter<MSEdge, SUMOVehicle, noProhibitions<MSEdge, SUMOVehicle> >(
+                MSEdge::getAllEdges(), true, operation);
+        }
+    } else if (routingAlgorithm == "astar") {
+        if (myLookupTable == 0) {
+            if (oc.isSet("astar.all-distances")) {
+                myLookupTable = new FullLookupTable<MSEdge, SUMOVehicle>(oc.getString("astar.all-distances"), (int)MSEdge::getAllEdges().size());
+            } else if (oc.isSet("astar.landmark-distances") || oc.getInt("astar.landmark-count") > 0) {
+                const double speedFactor = myHolder.getChosenSpeedFactor();
+                // we need an exemplary vehicle with speedFactor 1
+                myHolder.setChosenSpeedFactor(1);
+                const std::string filename = oc.isSet("astar.landmark-distances") ? oc.getString("astar.landmark-distances") : "";
+                if (mayHaveRestrictions) {
+                    CHRouterWrapper<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> > router(
+                        MSEdge::getAllEdges(), true, &MSNet::getTravelTime,
+                        string2time(oc.getString("begin")), string2time(oc.getString("end")), std::numeric_limits<int>::max(), 1);
+                    myLookupTable = new LandmarkLookupTable<MSEdge, SUMOVehicle>(filename, MSEdge::getAllEdges(), &router, &myHolder, "",
+                            oc.getInt("device.rerouting.threads"), oc.getInt("astar.landmark-count"));
+                } else {
+                    CHRouterWrapper<MSEdge, SUMOVehicle, noProhibitions<MSEdge, SUMOVehicle> > router(
+                        MSEdge::getAllEdges(), true, &MSNet::getTravelTime,
+                        string2time(oc.getString("begin")), string2time(oc.getString("end")), std::numeric_limits<int>::max(), 1);
+                    myLookupTable = new LandmarkLookupTable<MSEdge, SUMOVehicle>(filename, MSEdge::getAllEdges(), &router, &myHolder, "",
+                            oc.getInt("device.rerouting.threads"), oc.getInt("astar.landmark-count"));
+                }
+                myHolder.setChosenSpeedFactor(speedFactor);
+            }
+        }
+        // the lookup table is shared by the routers of all threads
+        if (mayHaveRestrictions) {
+            return new AStarRouter<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> >(
+                MSEdge::getAllEdges(), true, operation, myLookupTable);
+        } else {
+            return new AStarRouter<MSEdge, SUMOVehicle, noProhibitions<MSEdge, SUMOVehicle> >(
+                MSEdge::getAllEdges(), true, operation, myLookupTable);
+        }
+    } else if (routingAlgorithm == "CH") {
+        const SUMOTime weightPeriod = myAdaptationInterval > 0 ? myAdaptationInterval : std::numeric_limits<int>::max();
+        if (mayHaveRestrictions) {
+            return new CHRouter<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> >(
+                MSEdge::getAllEdges(), true, operation, myHolder.getVClass(), weightPeriod, true);
+        } else {
+            return new CHRouter<MSEdge, SUMOVehicle, noProhibitions<MSEdge, SUMOVehicle> >(
+                MSEdge::getAllEdges(), true, operation, myHolder.getVClass(), weightPeriod, false);
+        }
+    } else if (routingAlgorithm == "CCH") {
+        // all routers share the topology and the customization, so we clone the first one
+        const SUMOTime weightPeriod = myAdaptationInterval > 0 ? myAdaptationInterval : std::numeric_limits<int>::max();
+        if (myCustomizableRouter == 0) {
+            if (mayHaveRestrictions) {
+                myCustomizableRouter = new CHRouter<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> >(
+                    MSEdge::getAllEdges(), true, operation, weightPeriod, oc.getInt("device.rerouting.threads"));
+            } else {
+                myCustomizableRouter = new CHRouter<MSEdge, SUMOVehicle, noProhibitions<MSEdge, SUMOVehicle> >(
+                    MSEdge::getAllEdges(), true, operation, weightPeriod, oc.getInt("device.rerouting.threads"));
+            }
+        }
+        return myCustomizableRouter->clone();
+    } else if (routingAlgorithm == "CHWrapper") {
+        const SUMOTime weightPeriod = myAdaptationInterval > 0 ? myAdaptationInterval : std::numeric_limits<int>::max();
+        return new CHRouterWrapper<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> >(
+            MSEdge::getAllEdges(), true, operation,
+            string2time(oc.getString("begin")), string2time(oc.getString("end")), weightPeriod, oc.getInt("device.rerouting.threads"));
+    } else {
+        throw ProcessError("Unknown routing algorithm '" + routingAlgorithm + "'!");
+    }
+}
+
+
 void
 MSDevice_Routing::reroute(const SUMOTime currentTime, const bool onInit) {
     initEdgeWeights();
@@ -365,68 +579,7 @@ MSDevice_Routing::reroute(const SUMOTime currentTime, const bool onInit) {
     const bool needThread = true;
 #endif
     if (needThread && myRouter == 0) {
-        OptionsCont& oc = OptionsCont::getOptions();
-        const std::string routingAlgorithm = oc.getString("routing-algorithm");
-        const bool mayHaveRestrictions = MSNet::getInstance()->hasPermissions() || oc.getInt("remote-port") != 0;
-        if (routingAlgorithm == "dijkstra") {
-            if (mayHaveRestrictions) {
-                myRouter = new DijkstraRouter<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> >(
-                    MSEdge::getAllEdges(), true, &MSDevice_Routing::getEffort);
-            } else {
-                myRouter = new DijkstraRouter<MSEdge, SUMOVehicle, noProhibitions<MSEdge, SUMOVehicle> >(
-                    MSEdge::getAllEdges(), true, &MSDevice_Routing::getEffort);
-            }
-        } else if (routingAlgorithm == "astar") {
-            if (mayHaveRestrictions) {
-                typedef AStarRouter<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> > AStar;
-                const AStar::LookupTable* lookup = 0;
-                if (oc.isSet("astar.all-distances")) {
-                    lookup = new AStar::FLT(oc.getString("astar.all-distances"), (int)MSEdge::getAllEdges().size());
-                } else if (oc.isSet("astar.landmark-distances")) {
-                    const double speedFactor = myHolder.getChosenSpeedFactor();
-                    // we need an exemplary vehicle with speedFactor 1
-                    myHolder.setChosenSpeedFactor(1);
-                    CHRouterWrapper<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> > router(
-                        MSEdge::getAllEdges(), true, &MSNet::getTravelTime,
-                        string2time(oc.getString("begin")), string2time(oc.getString("end")), std::numeric_limits<int>::max(), 1);
-                    lookup = new AStar::LMLT(oc.getString("astar.landmark-distances"), MSEdge::getAllEdges(), &router, &myHolder, "", oc.getInt("device.rerouting.threads"));
-                    myHolder.setChosenSpeedFactor(speedFactor);
-                }
-                myRouter = new AStar(MSEdge::getAllEdges(), true, &MSDevice_Routing::getEffort, lookup);
-            } else {
-                typedef AStarRouter<MSEdge, SUMOVehicle, noProhibitions<MSEdge, SUMOVehicle> > AStar;
-                const AStar::LookupTable* lookup = 0;
-                if (oc.isSet("astar.all-distances")) {
-                    lookup = new AStar::FLT(oc.getString("astar.all-distances"), (int)MSEdge::getAllEdges().size());
-                } else if (oc.isSet("astar.landmark-distances")) {
-                    const double speedFactor = myHolder.getChosenSpeedFactor();
-                    // we need an exemplary vehicle with speedFactor 1
-                    myHolder.setChosenSpeedFactor(1);
-                    CHRouterWrapper<MSEdge, SUMOVehicle, noProhibitions<MSEdge, SUMOVehicle> > router(
-                        MSEdge::getAllEdges(), true, &MSNet::getTravelTime,
-                        string2time(oc.getString("begin")), string2time(oc.getString("end")), std::numeric_limits<int>::max(), 1);
-                    lookup = new AStar::LMLT(oc.getString("astar.landmark-distances"), MSEdge::getAllEdges(), &router, &myHolder, "", oc.getInt("device.rerouting.threads"));
-                    myHolder.setChosenSpeedFactor(speedFactor);
-                }
-                myRouter = new AStar(MSEdge::getAllEdges(), true, &MSDevice_Routing::getEffort, lookup);
-            }
-        } else if (routingAlgorithm == "CH") {
-            const SUMOTime weightPeriod = myAdaptationInterval > 0 ? myAdaptationInterval : std::numeric_limits<int>::max();
-            if (mayHaveRestrictions) {
-                myRouter = new CHRouter<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> >(
-                    MSEdge::getAllEdges(), true, &MSDevice_Routing::getEffort, myHolder.getVClass(), weightPeriod, true);
-            } else {
-                myRouter = new CHRouter<MSEdge, SUMOVehicle, noProhibitions<MSEdge, SUMOVehicle> >(
-                    MSEdge::getAllEdges(), true, &MSDevice_Routing::getEffort, myHolder.getVClass(), weightPeriod, false);
-            }
-        } else if (routingAlgorithm == "CHWrapper") {
-            const SUMOTime weightPeriod = myAdaptationInterval > 0 ? myAdaptationInterval : std::numeric_limits<int>::max();
-            myRouter = new CHRouterWrapper<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> >(
-                MSEdge::getAllEdges(), true, &MSDevice_Routing::getEffort,
-                string2time(oc.getString("begin")), string2time(oc.getString("end")), weightPeriod, oc.getInt("device.rerouting.threads"));
-        } else {
-            throw ProcessError("Unknown routing algorithm '" + routingAlgorithm + "'!");
-        }
+        myRouter = buildRouter(&MSDevice_Routing::getEffort);
     }
 #ifdef HAVE_FOX
     if (needThread) {
@@ -443,7 +596,25 @@ MSDevice_Routing::reroute(const SUMOTime currentTime, const bool onInit) {
         return;
     }
 #endif
-    myHolder.reroute(currentTime, *myRouter, onInit, myWithTaz);
+    routeVehicle(myHolder, currentTime, *myRouter, onInit);
+}
+
+
+void
+MSDevice_Routing::routeVehicle(SUMOVehicle& v, const SUMOTime t, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, const bool onInit) {
+    ConstMSEdgeVector legs;
+    v.getRerouteLegs(onInit, myWithTaz, legs);
+    ConstMSEdgeVector edges;
+    const bool useCache = myRouteCache != 0 && legs.size() == 2
+                          && (myShareRoutes || (legs.front()->isTazConnector() && legs.back()->isTazConnector()));
+    // the cache is keyed by the time of the last weight adaptation which does not change while routing
+    if (!useCache || !myRouteCache->get(legs.front(), legs.back(), v.getVClass(), myLastAdaptation - myCacheStaleness, edges)) {
+        v.computeReroute(t, router, legs, edges);
+        if (useCache && !edges.empty()) {
+            myRouteCache->put(legs.front(), legs.back(), v.getVClass(), myLastAdaptation, edges);
+        }
+    }
+    v.applyReroute(edges, legs, onInit);
 }
 
 
@@ -489,6 +660,12 @@ MSDevice_Routing::setParameter(const std::string& key, const std::string& value)
             throw InvalidArgument("Edge '" + edgeID + "' is invalid for parameter setting of '" + deviceName() + "'");
         }
         myEdgeSpeeds[edge->getNumericalID()] = edge->getLength() / doubleValue;
+        if (myRouteCache != 0) {
+            myRouteCache->clear();
+        }
+#ifdef HAVE_FOX
+        myEdgeSpeedsSnapshot.reset();
+#endif
     } else if (key == "period") {
         const SUMOTime oldPeriod = myPeriod;
         myPeriod = TIME2STEPS(doubleValue);
@@ -505,22 +682,44 @@ MSDevice_Routing::setParameter(const std::string& key, const std::string& value)
 
 
 
+std::string
+MSDevice_Routing::printStatistics() {
+    std::ostringstream msg;
+    if (myRouteCache != 0 && myRouteCache->getHits() + myRouteCache->getMisses() > 0) {
+        msg << "Route cache:\n"
+            << " Hits: " << myRouteCache->getHits() << "\n"
+            << " Misses: " << myRouteCache->getMisses() << "\n";
+    }
+    return msg.str();
+}
+
+
 void
 MSDevice_Routing::cleanup() {
     delete myRouterWithProhibited;
     myRouterWithProhibited = 0;
+    delete myCustomizableRouter;
+    myCustomizableRouter = 0;
+    delete myRouteCache;
+    myRouteCache = 0;
 #ifdef HAVE_FOX
+    // router deletion is done in thread destructor
+    myLookaheadPool.clear();
+    myEdgeSpeedsSnapshot.reset();
+    myLookahead = 0;
     if (myThreadPool.size() > 0) {
         // we cannot wait for the static destructor to do the cleanup
         // because the output devices are gone by then
         myThreadPool.clear();
         // router deletion is done in thread destructor
         myRouter = 0;
-        return;
     }
 #endif
     delete myRouter;
     myRouter = 0;
+    // the routers do not own the lookup table
+    delete myLookupTable;
+    myLookupTable = 0;
 }
 
 
@@ -533,23 +732,354 @@ MSDevice_Routing::waitForAll() {
 }
 
 
+void
+MSDevice_Routing::waitForLookahead() {
+    if (myLookaheadPool.size() > 0) {
+        // the devices collect (and delete) their tasks later on
+        myLookaheadPool.waitAll(false);
+    }
+}
+
+
 // ---------------------------------------------------------------------------
 // MSDevice_Routing::RoutingTask-methods
 // ---------------------------------------------------------------------------
 void
 MSDevice_Routing::RoutingTask::run(FXWorkerThread* context) {
-    myVehicle.reroute(myTime, static_cast<WorkerThread*>(context)->getRouter(), myOnInit, myWithTaz);
-    const MSEdge* source = *myVehicle.getRoute().begin();
-    const MSEdge* dest = myVehicle.getRoute().getLastEdge();
-    if (source->isTazConnector() && dest->isTazConnector()) {
-        const std::pair<const MSEdge*, const MSEdge*> key = std::make_pair(source, dest);
-        lock();
-        if (MSDevice_Routing::myCachedRoutes.find(key) == MSDevice_Routing::myCachedRoutes.end()) {
-            MSDevice_Routing::myCachedRoutes[key] = &myVehicle.getRoute();
-            myVehicle.getRoute().addReference();
-        }
-        unlock();
-    }
+    routeVehicle(myVehicle, myTime, static_cast<WorkerThread*>(context)->getRouter(), myOnInit);
+}
+
+
+// ---------------------------------------------------------------------------
+// MSDevice_Routing::LookaheadTask-methods
+// ---------------------------------------------------------------------------
+void
+MSDevice_Routing::LookaheadTask::run(FXWorkerThread* context) {
+    WorkerThread* const thread = static_cast<WorkerThread*>(context);
+    thread->setEdgeSpeeds(myEdgeSpeeds);
+    myVehicle.computeReroute(myTime, thread->getRouter(), myLegs, myEdges);
+}
+
+
+// ---------------------------------------------------------------------------
+// MSDevice_Routing::VehicleSnapshot-methods
+// ---------------------------------------------------------------------------
+ProcessError
+MSDevice_Routing::VehicleSnapshot::unsupported(const std::string& method) const {
+    return ProcessError("The routing snapshot of vehicle '" + myID + "' does not support " + method + ".");
+}
+
+
+double
+MSDevice_Routing::VehicleSnapshot::getPreviousSpeed() const {
+    throw unsupported("getPreviousSpeed");
+}
+
+
+double
+MSDevice_Routing::VehicleSnapshot::getPositionOnLane() const {
+    throw unsupported("getPositionOnLane");
+}
+
+
+double
+MSDevice_Routing::VehicleSnapshot::getBackPositionOnLane(const MSLane* /* lane */) const {
+    throw unsupported("getBackPositionOnLane");
+}
+
+
+double
+MSDevice_Routing::VehicleSnapshot::getLateralPositionOnLane() const {
+    throw unsupported("getLateralPositionOnLane");
+}
+
+
+double
+MSDevice_Routing::VehicleSnapshot::getAngle() const {
+    throw unsupported("getAngle");
+}
+
+
+Position
+MSDevice_Routing::VehicleSnapshot::getPosition(const double /* offset */) const {
+    throw unsupported("getPosition");
+}
+
+
+double
+MSDevice_Routing::VehicleSnapshot::getSpeed() const {
+    throw unsupported("getSpeed");
+}
+
+
+MSLane*
+MSDevice_Routing::VehicleSnapshot::getLane() const {
+    throw unsupported("getLane");
+}
+
+
+const MSVehicleType&
+MSDevice_Routing::VehicleSnapshot::getVehicleType() const {
+    throw unsupported("getVehicleType");
+}
+
+
+const MSRoute&
+MSDevice_Routing::VehicleSnapshot::getRoute() const {
+    throw unsupported("getRoute");
+}
+
+
+const MSEdge*
+MSDevice_Routing::VehicleSnapshot::succEdge(int /* nSuccs */) const {
+    throw unsupported("succEdge");
+}
+
+
+bool
+MSDevice_Routing::VehicleSnapshot::replaceRouteEdges(ConstMSEdgeVector& /* edges */, bool /* onInit */, bool /* check */, bool /* removeStops */) {
+    throw unsupported("replaceRouteEdges");
+}
+
+
+bool
+MSDevice_Routing::VehicleSnapshot::replaceRoute(const MSRoute* /* route */, bool /* onInit */, int /* offset */, bool /* addStops */, bool /* removeStops */) {
+    throw unsupported("replaceRoute");
+}
+
+
+void
+MSDevice_Routing::VehicleSnapshot::reroute(SUMOTime /* t */, SUMOAbstractRouter<MSEdge, SUMOVehicle>& /* router */, const bool /* onInit */, const bool /* withTaz */) {
+    throw unsupported("reroute");
+}
+
+
+void
+MSDevice_Routing::VehicleSnapshot::getRerouteLegs(const bool /* onInit */, const bool /* withTaz */, ConstMSEdgeVector& /* legs */) const {
+    throw unsupported("getRerouteLegs");
+}
+
+
+void
+MSDevice_Routing::VehicleSnapshot::applyReroute(ConstMSEdgeVector& /* edges */, const ConstMSEdgeVector& /* legs */, const bool /* onInit */) {
+    throw unsupported("applyReroute");
+}
+
+
+bool
+MSDevice_Routing::VehicleSnapshot::hasValidRoute(std::string& /* msg */, const MSRoute* /* route */) const {
+    throw unsupported("hasValidRoute");
+}
+
+
+const ConstMSEdgeVector::const_iterator&
+MSDevice_Routing::VehicleSnapshot::getCurrentRouteEdge() const {
+    throw unsupported("getCurrentRouteEdge");
+}
+
+
+double
+MSDevice_Routing::VehicleSnapshot::getAcceleration() const {
+    throw unsupported("getAcceleration");
+}
+
+
+double
+MSDevice_Routing::VehicleSnapshot::getSlope() const {
+    throw unsupported("getSlope");
+}
+
+
+const MSEdge*
+MSDevice_Routing::VehicleSnapshot::getEdge() const {
+    throw unsupported("getEdge");
+}
+
+
+const SUMOVehicleParameter&
+MSDevice_Routing::VehicleSnapshot::getParameter() const {
+    throw unsupported("getParameter");
+}
+
+
+void
+MSDevice_Routing::VehicleSnapshot::onDepart() {
+    throw unsupported("onDepart");
+}
+
+
+bool
+MSDevice_Routing::VehicleSnapshot::isOnRoad() const {
+    throw unsupported("isOnRoad");
+}
+
+
+bool
+MSDevice_Routing::VehicleSnapshot::isFrontOnLane(const MSLane*) const {
+    throw unsupported("isFrontOnLane");
+}
+
+
+bool
+MSDevice_Routing::VehicleSnapshot::isParking() const {
+    throw unsupported("isParking");
+}
+
+
+bool
+MSDevice_Routing::VehicleSnapshot::isRemoteControlled() const {
+    throw unsupported("isRemoteControlled");
+}
+
+
+SUMOTime
+MSDevice_Routing::VehicleSnapshot::getDeparture() const {
+    throw unsupported("getDeparture");
+}
+
+
+double
+MSDevice_Routing::VehicleSnapshot::getDepartPos() const {
+    throw unsupported("getDepartPos");
+}
+
+
+double
+MSDevice_Routing::VehicleSnapshot::getArrivalPos() const {
+    throw unsupported("getArrivalPos");
+}
+
+
+void
+MSDevice_Routing::VehicleSnapshot::setArrivalPos(double /* arrivalPos */) {
+    throw unsupported("setArrivalPos");
+}
+
+
+bool
+MSDevice_Routing::VehicleSnapshot::hasDeparted() const {
+    throw unsupported("hasDeparted");
+}
+
+
+bool
+MSDevice_Routing::VehicleSnapshot::hasArrived() const {
+    throw unsupported("hasArrived");
+}
+
+
+int
+MSDevice_Routing::VehicleSnapshot::getNumberReroutes() const {
+    throw unsupported("getNumberReroutes");
+}
+
+
+const std::vector<MSDevice*>&
+MSDevice_Routing::VehicleSnapshot::getDevices() const {
+    throw unsupported("getDevices");
+}
+
+
+void
+MSDevice_Routing::VehicleSnapshot::addPerson(MSTransportable* /* person */) {
+    throw unsupported("addPerson");
+}
+
+
+void
+MSDevice_Routing::VehicleSnapshot::addContainer(MSTransportable* /* container */) {
+    throw unsupported("addContainer");
+}
+
+
+bool
+MSDevice_Routing::VehicleSnapshot::addStop(const SUMOVehicleParameter::Stop& /* stopPar */, std::string& /* errorMsg */, SUMOTime /* untilOffset */, bool /* collision */,
+                                           ConstMSEdgeVector::const_iterator* /* searchStart */) {
+    throw unsupported("addStop");
+}
+
+
+MSParkingArea*
+MSDevice_Routing::VehicleSnapshot::getNextParkingArea() {
+    throw unsupported("getNextParkingArea");
+}
+
+
+bool
+MSDevice_Routing::VehicleSnapshot::replaceParkingArea(MSParkingArea* /* parkingArea */, std::string& /* errorMsg */) {
+    throw unsupported("replaceParkingArea");
+}
+
+
+bool
+MSDevice_Routing::VehicleSnapshot::isStopped() const {
+    throw unsupported("isStopped");
+}
+
+
+bool
+MSDevice_Routing::VehicleSnapshot::isStoppedTriggered() const {
+    throw unsupported("isStoppedTriggered");
+}
+
+
+bool
+MSDevice_Routing::VehicleSnapshot::isStoppedInRange(double /* pos */) const {
+    throw unsupported("isStoppedInRange");
+}
+
+
+MSDevice*
+MSDevice_Routing::VehicleSnapshot::getDevice(const std::type_info& /* type */) const {
+    throw unsupported("getDevice");
+}
+
+
+void
+MSDevice_Routing::VehicleSnapshot::setChosenSpeedFactor(const double /* factor */) {
+    throw unsupported("setChosenSpeedFactor");
+}
+
+
+SUMOTime
+MSDevice_Routing::VehicleSnapshot::getWaitingTime() const {
+    throw unsupported("getWaitingTime");
+}
+
+
+SUMOTime
+MSDevice_Routing::VehicleSnapshot::getAccumulatedWaitingTime() const {
+    throw unsupported("getAccumulatedWaitingTime");
+}
+
+
+SUMOTime
+MSDevice_Routing::VehicleSnapshot::getDepartDelay() const {
+    throw unsupported("getDepartDelay");
+}
+
+
+double
+MSDevice_Routing::VehicleSnapshot::getImpatience() const {
+    throw unsupported("getImpatience");
+}
+
+
+bool
+MSDevice_Routing::VehicleSnapshot::isSelected() const {
+    throw unsupported("isSelected");
+}
+
+
+void
+MSDevice_Routing::VehicleSnapshot::saveState(OutputDevice& /* out */) {
+    throw unsupported("saveState");
+}
+
+
+void
+MSDevice_Routing::VehicleSnapshot::loadState(const SUMOSAXAttributes& /* attrs */, const SUMOTime /* offset */) {
+    throw unsupported("loadState");
 }
 #endif
 
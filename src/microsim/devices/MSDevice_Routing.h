@@ -38,8 +38,10 @@
 #include <utils/vehicle/AStarRouter.h>
 #include <microsim/MSVehicle.h>
 #include "MSDevice.h"
+#include <utils/vehicle/RouteCache.h>
 
 #ifdef HAVE_FOX
+#include <memory>
 #include <utils/foxtools/FXWorkerThread.h>
 #endif
 
@@ -69,6 +71,12 @@ class MSLane;
  *  (within "enterLaneAtInsertion") - and, if the given period is larger than 0 - each
  *  x time steps where x is the period. This is triggered by an event that executes
  *  "wrappedRerouteCommandExecute".
+ *
+ * If parallel routing is enabled, the pre-insertion route may be computed
+ *  "device.rerouting.lookahead" seconds before the departure by a separate
+ *  thread pool which is not waited for at each simulation step. The route is
+ *  computed with a snapshot of the edge weights taken when the computation
+ *  started and is only applied to the vehicle at its departure.
  */
 class MSDevice_Routing : public MSDevice {
 public:
@@ -124,8 +132,10 @@ public:
         myThreadPool.unlock();
     }
     static bool isParallel() {
-        return myThreadPool.size() > 0;
+        return myThreadPool.size() > 0 || myLookaheadPool.size() > 0;
     }
+    /// @brief waits for all look-ahead routing tasks (before the network is changed)
+    static void waitForLookahead();
 #endif
 
 
@@ -185,6 +195,9 @@ public:
     /// @brief return current travel speed assumption
     static double getAssumedSpeed(const MSEdge* edge);
 
+    /// @brief return the route cache statistics for the summary (empty if the cache was not used)
+    static std::string printStatistics();
+
     /// @brief try to retrieve the given parameter from this device. Throw exception for unsupported key
     std::string getParameter(const std::string& key) const;
 
@@ -206,12 +219,21 @@ private:
         SUMOAbstractRouter<MSEdge, SUMOVehicle>& getRouter() const {
             return *myRouter;
         }
+        /// @brief sets the edge speeds used by getLookaheadEffort
+        void setEdgeSpeeds(const std::shared_ptr<const std::vector<double> >& edgeSpeeds) {
+            myEdgeSpeeds = edgeSpeeds;
+        }
+        const std::vector<double>& getEdgeSpeeds() const {
+            return *myEdgeSpeeds;
+        }
         virtual ~WorkerThread() {
             stop();
             delete myRouter;
         }
     private:
         SUMOAbstractRouter<MSEdge, SUMOVehicle>* myRouter;
+        /// @brief the snapshot of the edge speeds for the current look-ahead task
+        std::shared_ptr<const std::vector<double> > myEdgeSpeeds;
     };
 
     /**
@@ -231,6 +253,133 @@ private:
         /// @brief Invalidated assignment operator.
         RoutingTask& operator=(const RoutingTask&);
     };
+
+    /**
+     * @class VehicleSnapshot
+     * @brief the routing related parameters of a vehicle at the time a look-ahead task was created
+     *
+     * The routers only ask for the id, the vehicle class and the speeds of the
+     *  vehicle. Using a copy of these the look-ahead routing thread does not
+     *  need to access the vehicle itself which may be changed (type, speed factor)
+     *  by the simulation in the meantime. All other methods throw a ProcessError.
+     */
+    class VehicleSnapshot : public SUMOVehicle {
+    public:
+        VehicleSnapshot(const SUMOVehicle& v)
+            : myID(v.getID()), myVClass(v.getVClass()), myMaxSpeed(v.getMaxSpeed()), mySpeedFactor(v.getChosenSpeedFactor()) {}
+        const std::string& getID() const {
+            return myID;
+        }
+        SUMOVehicleClass getVClass() const {
+            return myVClass;
+        }
+        double getMaxSpeed() const {
+            return myMaxSpeed;
+        }
+        double getChosenSpeedFactor() const {
+            return mySpeedFactor;
+        }
+        void computeReroute(SUMOTime t, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, const ConstMSEdgeVector& legs, ConstMSEdgeVector& edges) const {
+            MSBaseVehicle::computeRoute(*this, t, router, legs, edges);
+        }
+        /// @name unsupported methods
+        /// @{
+        double getPreviousSpeed() const;
+        double getPositionOnLane() const;
+        double getBackPositionOnLane(const MSLane* lane) const;
+        double getLateralPositionOnLane() const;
+        double getAngle() const;
+        Position getPosition(const double offset = 0) const;
+        double getSpeed() const;
+        MSLane* getLane() const;
+        const MSVehicleType& getVehicleType() const;
+        const MSRoute& getRoute() const;
+        const MSEdge* succEdge(int nSuccs) const;
+        bool replaceRouteEdges(ConstMSEdgeVector& edges, bool onInit = false, bool check = false, bool removeStops = true);
+        bool replaceRoute(const MSRoute* route, bool onInit = false, int offset = 0, bool addStops = true, bool removeStops = true);
+        void reroute(SUMOTime t, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, const bool onInit = false, const bool withTaz = false);
+        void getRerouteLegs(const bool onInit, const bool withTaz, ConstMSEdgeVector& legs) const;
+        void applyReroute(ConstMSEdgeVector& edges, const ConstMSEdgeVector& legs, const bool onInit);
+        bool hasValidRoute(std::string& msg, const MSRoute* route = 0) const;
+        const ConstMSEdgeVector::const_iterator& getCurrentRouteEdge() const;
+        double getAcceleration() const;
+        double getSlope() const;
+        const MSEdge* getEdge() const;
+        const SUMOVehicleParameter& getParameter() const;
+        void onDepart();
+        bool isOnRoad() const;
+        bool isFrontOnLane(const MSLane*) const;
+        bool isParking() const;
+        bool isRemoteControlled() const;
+        SUMOTime getDeparture() const;
+        double getDepartPos() const;
+        double getArrivalPos() const;
+        void setArrivalPos(double arrivalPos);
+        bool hasDeparted() const;
+        bool hasArrived() const;
+        int getNumberReroutes() const;
+        const std::vector<MSDevice*>& getDevices() const;
+        void addPerson(MSTransportable* person);
+        void addContainer(MSTransportable* container);
+        bool addStop(const SUMOVehicleParameter::Stop& stopPar, std::string& errorMsg, SUMOTime untilOffset = 0, bool collision = false,
+                     ConstMSEdgeVector::const_iterator* searchStart = 0);
+        MSParkingArea* getNextParkingArea();
+        bool replaceParkingArea(MSParkingArea* parkingArea, std::string& errorMsg);
+        bool isStopped() const;
+        bool isStoppedTriggered() const;
+        bool isStoppedInRange(double pos) const;
+        MSDevice* getDevice(const std::type_info& type) const;
+        void setChosenSpeedFactor(const double factor);
+        SUMOTime getWaitingTime() const;
+        SUMOTime getAccumulatedWaitingTime() const;
+        SUMOTime getDepartDelay() const;
+        double getImpatience() const;
+        bool isSelected() const;
+        void saveState(OutputDevice& out);
+        void loadState(const SUMOSAXAttributes& attrs, const SUMOTime offset);
+        /// @}
+    private:
+        /// @brief builds the error for calling an unsupported method
+        ProcessError unsupported(const std::string& method) const;
+    private:
+        const std::string myID;
+        const SUMOVehicleClass myVClass;
+        const double myMaxSpeed;
+        const double mySpeedFactor;
+    private:
+        /// @brief Invalidated assignment operator.
+        VehicleSnapshot& operator=(const VehicleSnapshot&);
+    };
+
+    /**
+     * @class LookaheadTask
+     * @brief the routing task computing a pre-insertion route without changing the vehicle
+     */
+    class LookaheadTask : public FXWorkerThread::Task {
+    public:
+        LookaheadTask(const SUMOVehicle& v, const SUMOTime time, const ConstMSEdgeVector& legs,
+                      const std::shared_ptr<const std::vector<double> >& edgeSpeeds)
+            : myVehicle(v), myTime(time), myLegs(legs), myEdgeSpeeds(edgeSpeeds) {}
+        void run(FXWorkerThread* context);
+        /// @brief the edges the route is computed along
+        const ConstMSEdgeVector& getLegs() const {
+            return myLegs;
+        }
+        /// @brief the computed route (valid after the task was waited for)
+        ConstMSEdgeVector& getEdges() {
+            return myEdges;
+        }
+    private:
+        /// @brief the copy of the routing parameters of the vehicle
+        const VehicleSnapshot myVehicle;
+        const SUMOTime myTime;
+        const ConstMSEdgeVector myLegs;
+        const std::shared_ptr<const std::vector<double> > myEdgeSpeeds;
+        ConstMSEdgeVector myEdges;
+    private:
+        /// @brief Invalidated assignment operator.
+        LookaheadTask& operator=(const LookaheadTask&);
+    };
 #endif
 
     /** @brief Constructor
@@ -245,6 +394,24 @@ private:
     /// @brief initialize the edge weights if not done before
     static void initEdgeWeights();
 
+    /** @brief Reroutes the vehicle using the route cache if possible
+     *
+     * Routes between two taz (and with "device.rerouting.cache-shared" all
+     *  routes without stops) are taken from the cache if they were computed
+     *  with edge weights which are at most "device.rerouting.cache-staleness" older
+     *  than the current ones. This may be called from the routing threads.
+     *
+     * @param[in] v The vehicle to reroute
+     * @param[in] t The time for which the route is computed
+     * @param[in] router The router to use on a cache miss
+     * @param[in] onInit Whether the vehicle starts with the new route
+     * @see SUMOVehicle::reroute
+     */
+    static void routeVehicle(SUMOVehicle& v, const SUMOTime t, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, const bool onInit);
+
+    /// @brief builds a router of the configured type using the given effort function
+    SUMOAbstractRouter<MSEdge, SUMOVehicle>* buildRouter(SUMOAbstractRouter<MSEdge, SUMOVehicle>::Operation operation);
+
     /** @brief Performs rerouting before insertion into the network
      *
      * A new route is computed by calling the reroute method. If the routing
@@ -258,6 +425,20 @@ private:
      */
     SUMOTime preInsertionReroute(const SUMOTime currentTime);
 
+#ifdef HAVE_FOX
+    /** @brief Starts the computation of the pre-insertion route in the look-ahead thread pool
+     *
+     * The result is collected by preInsertionReroute at the departure.
+     *
+     * @param[in] currentTime The current simulation time
+     * @return Always 0 (the command is executed only once)
+     */
+    SUMOTime lookaheadReroute(const SUMOTime currentTime);
+
+    /// @brief deschedules the look-ahead command and discards a computed route
+    void clearLookahead();
+#endif
+
     /** @brief Performs rerouting after a period
      *
      * A new route is computed by calling the vehicle's "reroute" method, supplying
@@ -291,6 +472,13 @@ private:
      */
     static double getEffort(const MSEdge* const e, const SUMOVehicle* const v, double t);
 
+#ifdef HAVE_FOX
+    /** @brief Returns the effort to pass an edge using the edge speeds snapshot of the calling look-ahead thread
+     * @see getEffort
+     */
+    static double getLookaheadEffort(const MSEdge* const e, const SUMOVehicle* const v, double t);
+#endif
+
 
 
     /// @name Network state adaptation
@@ -327,6 +515,14 @@ private:
     /// @brief The (optional) command responsible for rerouting
     WrappingCommand< MSDevice_Routing >* myRerouteCommand;
 
+#ifdef HAVE_FOX
+    /// @brief The (optional) command starting the look-ahead routing
+    WrappingCommand< MSDevice_Routing >* myLookaheadCommand;
+
+    /// @brief The pending look-ahead routing
+    LookaheadTask* myLookaheadTask;
+#endif
+
     /// @brief The weights adaptation/overwriting command
     static Command* myEdgeWeightSettingCommand;
 
@@ -354,8 +550,14 @@ private:
     /// @brief whether taz shall be used at initial rerouting
     static bool myWithTaz;
 
-    /// @brief The container of pre-calculated routes
-    static std::map<std::pair<const MSEdge*, const MSEdge*>, const MSRoute*> myCachedRoutes;
+    /// @brief The cache of routes shared between vehicles (0 if disabled)
+    static RouteCache<MSEdge>* myRouteCache;
+
+    /// @brief Whether all routes without stops are shared (not only those between taz)
+    static bool myShareRoutes;
+
+    /// @brief How much older than the current edge weights cached routes may be
+    static SUMOTime myCacheStaleness;
 
     /// @brief The router to use
     static SUMOAbstractRouter<MSEdge, SUMOVehicle>* myRouter;
@@ -363,11 +565,26 @@ private:
     /// @brief The router to use by rerouter elements
     static AStarRouter<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> >* myRouterWithProhibited;
 
+    /// @brief The prototype of the customizable CH routers (which share topology and customization)
+    static SUMOAbstractRouter<MSEdge, SUMOVehicle>* myCustomizableRouter;
+
+    /// @brief The lookup table for the astar router (shared by the routers of all threads)
+    static const AbstractLookupTable<MSEdge, SUMOVehicle>* myLookupTable;
+
     /// @brief Whether to disturb edge weights dynamically
     static double myRandomizeWeightsFactor;
 
 #ifdef HAVE_FOX
     static FXWorkerThread::Pool myThreadPool;
+
+    /// @brief How long before the departure the pre-insertion routing starts (0 if disabled)
+    static SUMOTime myLookahead;
+
+    /// @brief The snapshot of the edge speeds for the look-ahead routing (taken on demand)
+    static std::shared_ptr<const std::vector<double> > myEdgeSpeedsSnapshot;
+
+    /// @brief The thread pool for the look-ahead routing (not synchronized with the simulation step)
+    static FXWorkerThread::Pool myLookaheadPool;
 #endif
 
 private:
@@ -32,6 +32,7 @@
 #endif
 
 #include <microsim/MSGlobals.h>
+#include <utils/common/MemoryPool.h>
 #include <microsim/MSVehicle.h>
 
 class MSLane;
@@ -176,6 +177,18 @@ public:
     /// @brief Destructor
     virtual ~MSAbstractLaneChangeModel();
 
+
+    /// @brief Allocates the memory for a lane change model from the memory pool
+    static void* operator new(std::size_t size) {
+        return MemoryPool<MSAbstractLaneChangeModel>::allocate(size);
+    }
+
+
+    /// @brief Gives the memory of a lane change model back to the memory pool
+    static void operator delete(void* p, std::size_t size) {
+        MemoryPool<MSAbstractLaneChangeModel>::deallocate(p, size);
+    }
+
     inline int getOwnState() const {
         return myOwnState;
     }
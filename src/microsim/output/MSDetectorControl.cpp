@@ -64,6 +64,16 @@ MSDetectorControl::close(SUMOTime step) {
 }
 
 
+void
+MSDetectorControl::clearState(SUMOTime step) {
+    // flush the last values
+    writeOutput(step, true);
+    for (std::map<IntervalsKey, SUMOTime>::iterator i = myLastCalls.begin(); i != myLastCalls.end(); ++i) {
+        i->second = i->first.second;
+    }
+}
+
+
 void
 MSDetectorControl::add(SumoXMLTag type, MSDetectorFileOutput* d, const std::string& device, SUMOTime splInterval, SUMOTime begin) {
     if (!myDetectors[type].add(d->getID(), d)) {
@@ -78,6 +78,12 @@ public:
     void close(SUMOTime step);
 
 
+    /** @brief Writes the pending output and restarts all intervals at their begin to run the simulation again
+     * @param[in] step The current simulation time
+     */
+    void clearState(SUMOTime step);
+
+
     /** @brief Adds a detector/output combination into the containers
      *
      * The detector is tried to be added into "myDetectors". If the detector
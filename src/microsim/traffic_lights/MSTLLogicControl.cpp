@@ -566,6 +566,16 @@ MSTLLogicControl::setTrafficLightSignals(SUMOTime t) const {
 }
 
 
+void
+MSTLLogicControl::clearState(const SUMOTime currentTime, const SUMOTime newTime) {
+    for (MSTrafficLightLogic* const logic : getAllLogics()) {
+        for (MSPhaseDefinition* const phase : logic->getPhases()) {
+            phase->myLastSwitch += newTime - currentTime;
+        }
+    }
+}
+
+
 std::vector<MSTrafficLightLogic*>
 MSTLLogicControl::getAllLogics() const {
     std::vector<MSTrafficLightLogic*> ret;
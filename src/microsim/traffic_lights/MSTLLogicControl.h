@@ -204,6 +204,14 @@ public:
     void setTrafficLightSignals(SUMOTime t) const;
 
 
+    /** @brief Moves the switch times of all programs to run the simulation again from an earlier time
+     * @param[in] currentTime The current simulation time
+     * @param[in] newTime The time the simulation continues with
+     * @see MSEventControl::clearState
+     */
+    void clearState(const SUMOTime currentTime, const SUMOTime newTime);
+
+
     /** @brief Returns a vector which contains all logics
      *
      * All logics are included, active (current) and non-active
@@ -48,6 +48,8 @@
 // static member definitions
 // ===========================================================================
 bool ROEdge::myInterpolate = false;
+ValueTimeMatrix ROEdge::myTravelTimeMatrix;
+ValueTimeMatrix ROEdge::myEffortMatrix;
 bool ROEdge::myHaveTTWarned = false;
 bool ROEdge::myHaveEWarned = false;
 ROEdgeVector ROEdge::myEdges;
@@ -126,6 +128,7 @@ ROEdge::addSuccessor(ROEdge* s, std::string) {
 void
 ROEdge::addEffort(double value, double timeBegin, double timeEnd) {
     myEfforts.add(timeBegin, timeEnd, value);
+    myEffortMatrix.add(myIndex, timeBegin, timeEnd, value);
     myUsingETimeLine = true;
 }
 
@@ -133,6 +136,7 @@ ROEdge::addEffort(double value, double timeBegin, double timeEnd) {
 void
 ROEdge::addTravelTime(double value, double timeBegin, double timeEnd) {
     myTravelTimes.add(timeBegin, timeEnd, value);
+    myTravelTimeMatrix.add(myIndex, timeBegin, timeEnd, value);
     myUsingTTTimeLine = true;
 }
 
@@ -164,22 +168,16 @@ ROEdge::getDistanceTo(const ROEdge* other) const {
 
 bool
 ROEdge::hasLoadedTravelTime(double time) const {
-    return myUsingTTTimeLine && myTravelTimes.describesTime(time);
+    double value = 0.;
+    return myUsingTTTimeLine && getStoredTravelTime(time, value);
 }
 
 
 double
 ROEdge::getTravelTime(const ROVehicle* const veh, double time) const {
     if (myUsingTTTimeLine) {
-        if (myTravelTimes.describesTime(time)) {
-            double lineTT = myTravelTimes.getValue(time);
-            if (myInterpolate) {
-                const double inTT = lineTT;
-                const double split = (double)(myTravelTimes.getSplitTime(time, time + inTT) - time);
-                if (split >= 0) {
-                    lineTT = myTravelTimes.getValue(time + inTT) * ((double)1. - split / inTT) + split;
-                }
-            }
+        double lineTT = 0.;
+        if (getStoredTravelTime(time, lineTT)) {
             return MAX2(getMinimumTravelTime(veh), lineTT);
         } else {
             if (!myHaveTTWarned) {
@@ -203,26 +201,49 @@ ROEdge::getNoiseEffort(const ROEdge* const edge, const ROVehicle* const veh, dou
 }
 
 
+bool
+ROEdge::getStoredTravelTime(double time, double& ret) const {
+    if (!myInterpolate && myTravelTimeMatrix.isDense()) {
+        return myTravelTimeMatrix.retrieve(myIndex, time, ret);
+    }
+    if (!myTravelTimes.describesTime(time)) {
+        return false;
+    }
+    ret = myTravelTimes.getValue(time);
+    if (myInterpolate) {
+        const double inTT = ret;
+        const double split = (double)(myTravelTimes.getSplitTime(time, time + inTT) - time);
+        if (split >= 0) {
+            ret = myTravelTimes.getValue(time + inTT) * ((double)1. - split / inTT) + split;
+        }
+    }
+    return true;
+}
+
+
 bool
 ROEdge::getStoredEffort(double time, double& ret) const {
     if (myUsingETimeLine) {
-        if (!myEfforts.describesTime(time)) {
-            if (!myHaveEWarned) {
-                WRITE_WARNING("No interval matches passed time " + toString(time)  + " in edge '" + myID + "'.\n Using edge's length / edge's speed.");
-                myHaveEWarned = true;
-            }
-            return false;
-        }
-        if (myInterpolate) {
-            const double inTT = myTravelTimes.getValue(time);
-            const double ratio = (myEfforts.getSplitTime(time, time + inTT) - time) / inTT;
-            if (ratio >= 0.) {
-                ret = ratio * myEfforts.getValue(time) + (1. - ratio) * myEfforts.getValue(time + inTT);
+        if (!myInterpolate && myEffortMatrix.isDense()) {
+            if (myEffortMatrix.retrieve(myIndex, time, ret)) {
                 return true;
             }
+        } else if (myEfforts.describesTime(time)) {
+            if (myInterpolate) {
+                const double inTT = myTravelTimes.getValue(time);
+                const double ratio = (myEfforts.getSplitTime(time, time + inTT) - time) / inTT;
+                if (ratio >= 0.) {
+                    ret = ratio * myEfforts.getValue(time) + (1. - ratio) * myEfforts.getValue(time + inTT);
+                    return true;
+                }
+            }
+            ret = myEfforts.getValue(time);
+            return true;
+        }
+        if (!myHaveEWarned) {
+            WRITE_WARNING("No interval matches passed time " + toString(time)  + " in edge '" + myID + "'.\n Using edge's length / edge's speed.");
+            myHaveEWarned = true;
         }
-        ret = myEfforts.getValue(time);
-        return true;
     }
     return false;
 }
@@ -299,6 +320,8 @@ ROEdge::buildTimeLines(const std::string& measure, const bool boundariesOverride
     if (myUsingTTTimeLine) {
         myTravelTimes.fillGaps(myLength / mySpeed, boundariesOverride);
     }
+    myTravelTimeMatrix.setExtendOverEnd(boundariesOverride);
+    myEffortMatrix.setExtendOverEnd(boundariesOverride);
 }
 
 
@@ -39,6 +39,7 @@
 #include <utils/common/Named.h>
 #include <utils/common/StdDefs.h>
 #include <utils/common/ValueTimeLine.h>
+#include <utils/common/ValueTimeMatrix.h>
 #include <utils/common/SUMOVehicleClass.h>
 #include <utils/emissions/PollutantsInterface.h>
 #include <utils/geom/Boundary.h>
@@ -483,6 +484,13 @@ protected:
      */
     bool getStoredEffort(double time, double& ret) const;
 
+    /** @brief Retrieves the stored travel time
+     *
+     * @param[in] time The time for which the travel time shall be returned
+     * @return Whether the travel time is given
+     */
+    bool getStoredTravelTime(double time, double& ret) const;
+
 
 
 protected:
@@ -517,6 +525,11 @@ protected:
     /// @brief Information whether to interpolate at interval boundaries
     static bool myInterpolate;
 
+    /// @brief The travel times of all edges if they were given for equidistant intervals
+    static ValueTimeMatrix myTravelTimeMatrix;
+    /// @brief The efforts of all edges if they were given for equidistant intervals
+    static ValueTimeMatrix myEffortMatrix;
+
     /// @brief Information whether the edge has reported missing weights
     static bool myHaveEWarned;
     /// @brief Information whether the edge has reported missing weights
@@ -37,6 +37,7 @@
 #include <string>
 #include <iostream>
 #include <netload/NLBuilder.h>
+#include <microsim/MSIterativeAssignment.h>
 #include <utils/options/OptionsCont.h>
 #include <utils/options/OptionsIO.h>
 #include <utils/common/MsgHandler.h>
@@ -69,7 +70,13 @@ main(int argc, char** argv) {
         while (state == MSNet::SIMSTATE_LOADING) {
             MSNet* net = NLBuilder::init();
             if (net != nullptr) {
-                state = net->simulate(string2time(oc.getString("begin")), string2time(oc.getString("end")));
+                const SUMOTime begin = string2time(oc.getString("begin"));
+                const SUMOTime end = string2time(oc.getString("end"));
+                if (oc.getInt("assignment.iterations") > 0) {
+                    state = MSIterativeAssignment::simulate(*net, begin, end);
+                } else {
+                    state = net->simulate(begin, end);
+                }
                 delete net;
             } else {
                 break;
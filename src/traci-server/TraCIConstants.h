@@ -289,6 +289,16 @@
 #define RESPONSE_SUBSCRIBE_PERSON_VARIABLE 0xee
 
 
+// command: subscribe numeric variables of all objects of a domain (columnar response)
+#define CMD_SUBSCRIBE_DOMAIN_VARIABLES 0x60
+// response: subscribe numeric variables of all objects of a domain (columnar response)
+#define RESPONSE_SUBSCRIBE_DOMAIN_VARIABLES 0x70
+
+// command: subscribe object variables, sending only the changed values (wraps a subscribe variable command)
+// unchanged objects get no response, a response with zero variables means that the subscription has ended
+#define CMD_SUBSCRIBE_ON_CHANGE 0x61
+
+
 // ****************************************
 // POSITION REPRESENTATIONS
 // ****************************************
@@ -804,6 +814,9 @@
 // minimum number of expected vehicles (get: simulation)
 #define VAR_MIN_EXPECTED_VEHICLES 0x7d
 
+// duration of a phase of the last simulation step (get: simulation)
+#define VAR_STEP_PROFILE 0x7f
+
 // number of vehicles starting to park (get: simulation)
 #define VAR_STOP_STARTING_VEHICLES_NUMBER 0x68
 
@@ -103,10 +103,10 @@ bool TraCIServer::myDoCloseConnection = false;
 // ===========================================================================
 // method definitions
 // ===========================================================================
-TraCIServer::TraCIServer(const SUMOTime begin, const int port, const int numClients)
+TraCIServer::TraCIServer(const SUMOTime begin, const int port, const int numClients, const std::string& shmName)
     : myServerSocket(0),
       myTargetTime(begin),
-      myAmEmbedded(port == 0) {
+      myAmEmbedded(port == 0 && shmName == "") {
 #ifdef DEBUG_MULTI_CLIENTS
     std::cout << "Creating new TraCIServer for " << numClients << " clients on port " << port << "." << std::endl;
 #endif
@@ -161,8 +161,13 @@ TraCIServer::TraCIServer(const SUMOTime begin, const int port, const int numClie
 
     if (!myAmEmbedded) {
         try {
-            WRITE_MESSAGE("***Starting server on port " + toString(port) + " ***");
-            myServerSocket = new tcpip::Socket(port);
+            if (shmName != "") {
+                WRITE_MESSAGE("***Starting server on shared memory '" + shmName + "' ***");
+                myServerSocket = new tcpip::Socket(shmName, true);
+            } else {
+                WRITE_MESSAGE("***Starting server on port " + toString(port) + " ***");
+                myServerSocket = new tcpip::Socket(port);
+            }
             while ((int)mySockets.size() < numClients) {
                 int index = (int)mySockets.size() + MAX_ORDER + 1;
                 mySockets[index] = new SocketInfo(myServerSocket->accept(true), begin);
@@ -204,13 +209,15 @@ TraCIServer::~TraCIServer() {
 void
 TraCIServer::openSocket(const std::map<int, CmdExecutor>& execs) {
     if (myInstance == 0 && !myDoCloseConnection && (OptionsCont::getOptions().getInt("remote-port") != 0
+            || OptionsCont::getOptions().isSet("remote-shm")
 #ifdef HAVE_PYTHON
             || OptionsCont::getOptions().isSet("python-script")
 #endif
                                                    )) {
         myInstance = new TraCIServer(string2time(OptionsCont::getOptions().getString("begin")),
                                      OptionsCont::getOptions().getInt("remote-port"),
-                                     OptionsCont::getOptions().getInt("num-clients"));
+                                     OptionsCont::getOptions().getInt("num-clients"),
+                                     OptionsCont::getOptions().getString("remote-shm"));
         for (std::map<int, CmdExecutor>::const_iterator i = execs.begin(); i != execs.end(); ++i) {
             myInstance->myExecutors[i->first] = i->second;
         }
@@ -823,7 +830,7 @@ TraCIServer::dispatchCommand() {
             case CMD_SUBSCRIBE_EDGE_VARIABLE:
             case CMD_SUBSCRIBE_SIM_VARIABLE:
             case CMD_SUBSCRIBE_GUI_VARIABLE:
-                success = addObjectVariableSubscription(commandId, false);
+                success = addObjectVariableSubscription(commandId, false, false);
                 break;
             case CMD_SUBSCRIBE_INDUCTIONLOOP_CONTEXT:
             case CMD_SUBSCRIBE_LANEAREA_CONTEXT:
@@ -840,7 +847,19 @@ TraCIServer::dispatchCommand() {
             case CMD_SUBSCRIBE_EDGE_CONTEXT:
             case CMD_SUBSCRIBE_SIM_CONTEXT:
             case CMD_SUBSCRIBE_GUI_CONTEXT:
-                success = addObjectVariableSubscription(commandId, true);
+                success = addObjectVariableSubscription(commandId, true, false);
+                break;
+            case CMD_SUBSCRIBE_ON_CHANGE: {
+                const int subscribeId = myInputStorage.readUnsignedByte();
+                if (subscribeId < CMD_SUBSCRIBE_INDUCTIONLOOP_VARIABLE || subscribeId > CMD_SUBSCRIBE_PERSON_VARIABLE) {
+                    success = writeErrorStatusCmd(commandId, "On-change subscriptions are only available for variable subscriptions.", myOutputStorage);
+                } else {
+                    success = addObjectVariableSubscription(subscribeId, false, true);
+                }
+                break;
+            }
+            case CMD_SUBSCRIBE_DOMAIN_VARIABLES:
+                success = addDomainVariableSubscription();
                 break;
             default:
                 writeStatusCmd(commandId, RTYPE_NOTIMPLEMENTED, "Command not implemented in sumo");
@@ -891,32 +910,25 @@ TraCIServer::postProcessSimulationStep() {
 #endif
     writeStatusCmd(CMD_SIMSTEP, RTYPE_OK, "");
     int noActive = 0;
+    tcpip::Storage responses;
     for (std::vector<Subscription>::iterator i = mySubscriptions.begin(); i != mySubscriptions.end();) {
         const Subscription& s = *i;
         bool isArrivedVehicle = (s.commandId == CMD_SUBSCRIBE_VEHICLE_VARIABLE || s.commandId == CMD_SUBSCRIBE_VEHICLE_CONTEXT)
                                 && (find(myVehicleStateChanges[MSNet::VEHICLE_STATE_ARRIVED].begin(), myVehicleStateChanges[MSNet::VEHICLE_STATE_ARRIVED].end(), s.id) != myVehicleStateChanges[MSNet::VEHICLE_STATE_ARRIVED].end());
         bool isArrivedPerson = (s.commandId == CMD_SUBSCRIBE_PERSON_VARIABLE || s.commandId == CMD_SUBSCRIBE_PERSON_CONTEXT) && MSNet::getInstance()->getPersonControl().get(s.id) == 0;
         if ((s.endTime < t) || isArrivedVehicle || isArrivedPerson) {
+            if (s.onChange) {
+                // the client does not get a response for unchanged objects either, so it needs to be told
+                writeSubscriptionEnd(s, responses);
+                ++noActive;
+            }
             i = mySubscriptions.erase(i);
             continue;
         }
         ++i;
-        if (s.beginTime > t) {
-            continue;
-        }
-        ++noActive;
     }
-    mySubscriptionCache.reset();
-#ifdef DEBUG_SUBSCRIPTIONS
-    std::cout << "   Initial size of mySubscriptionCache is " << mySubscriptionCache.size()
-              << "\n   Nr. of active subscriptions = " << noActive << std::endl;
-#endif
-    mySubscriptionCache.writeInt(noActive);
-#ifdef DEBUG_SUBSCRIPTIONS
-    std::cout << "   Size after writing an int is " << mySubscriptionCache.size() << std::endl;
-#endif
     for (std::vector<Subscription>::iterator i = mySubscriptions.begin(); i != mySubscriptions.end();) {
-        const Subscription& s = *i;
+        Subscription& s = *i;
         if (s.beginTime > t) {
             ++i;
             continue;
@@ -924,17 +936,31 @@ TraCIServer::postProcessSimulationStep() {
         tcpip::Storage into;
         std::string errors;
         bool ok = processSingleSubscription(s, into, errors);
+        if (!ok && s.onChange) {
+            into.reset();
+            writeSubscriptionEnd(s, into);
+        }
 #ifdef DEBUG_SUBSCRIPTIONS
         std::cout << "   Size of into-store for subscription " << s.id
                   << ": " << into.size() << std::endl;
 #endif
-        mySubscriptionCache.writeStorage(into);
+        if (into.size() > 0) {
+            // on-change subscriptions without changes do not send anything
+            responses.writeStorage(into);
+            ++noActive;
+        }
         if (ok) {
             ++i;
         } else {
             i = mySubscriptions.erase(i);
         }
     }
+    mySubscriptionCache.reset();
+#ifdef DEBUG_SUBSCRIPTIONS
+    std::cout << "   Nr. of subscription responses = " << noActive << std::endl;
+#endif
+    mySubscriptionCache.writeInt(noActive);
+    mySubscriptionCache.writeStorage(responses);
     myOutputStorage.writeStorage(mySubscriptionCache);
 #ifdef DEBUG_SUBSCRIPTIONS
     std::cout << "   Size after writing subscriptions is " << mySubscriptionCache.size() << std::endl;
@@ -991,7 +1017,7 @@ TraCIServer::writeErrorStatusCmd(int commandId, const std::string& description,
 
 
 void
-TraCIServer::initialiseSubscription(const TraCIServer::Subscription& s) {
+TraCIServer::initialiseSubscription(TraCIServer::Subscription& s) {
     tcpip::Storage writeInto;
     std::string errors;
     if (processSingleSubscription(s, writeInto, errors)) {
@@ -1002,7 +1028,8 @@ TraCIServer::initialiseSubscription(const TraCIServer::Subscription& s) {
             for (std::vector<Subscription>::iterator i = mySubscriptions.begin(); i != mySubscriptions.end(); ++i) {
                 if (s.commandId == i->commandId && s.id == i->id &&
                         s.beginTime == i->beginTime && s.endTime == i->endTime &&
-                        s.contextVars == i->contextVars && s.contextDomain == i->contextDomain && s.range == i->range) {
+                        s.contextVars == i->contextVars && s.contextDomain == i->contextDomain && s.range == i->range &&
+                        s.onChange == i->onChange) {
                     std::vector<std::vector<unsigned char> >::const_iterator k = s.parameters.begin();
                     for (std::vector<int>::const_iterator j = s.variables.begin(); j != s.variables.end(); ++j, ++k) {
                         const int offset = (int)(std::find(i->variables.begin(), i->variables.end(), *j) - i->variables.begin());
@@ -1011,6 +1038,12 @@ TraCIServer::initialiseSubscription(const TraCIServer::Subscription& s) {
                             i->parameters.push_back(*k);
                         }
                     }
+                    if (s.commandId == CMD_SUBSCRIBE_DOMAIN_VARIABLES) {
+                        // the client got the full id list with the answer
+                        i->objectIDs = s.objectIDs;
+                        i->lastTime = s.lastTime;
+                        i->idDelta = s.idDelta;
+                    }
                     needNewSubscription = false;
                     break;
                 }
@@ -1137,8 +1170,11 @@ TraCIServer::findObjectShape(int domain, const std::string& id, PositionVector&
 }
 
 bool
-TraCIServer::processSingleSubscription(const Subscription& s, tcpip::Storage& writeInto,
+TraCIServer::processSingleSubscription(Subscription& s, tcpip::Storage& writeInto,
                                        std::string& errors) {
+    if (s.commandId == CMD_SUBSCRIBE_DOMAIN_VARIABLES) {
+        return processDomainSubscription(s, writeInto, errors);
+    }
     bool ok = true;
     tcpip::Storage outputStorage;
     const int getCommandId = s.contextVars ? s.contextDomain : s.commandId - 0x30;
@@ -1152,14 +1188,19 @@ TraCIServer::processSingleSubscription(const Subscription& s, tcpip::Storage& wr
     } else {
         objIDs.insert(s.id);
     }
-    const int numVars = s.contextVars && s.variables.size() == 1 && s.variables[0] == ID_LIST ? 0 : (int)s.variables.size();
+    int numVars = s.contextVars && s.variables.size() == 1 && s.variables[0] == ID_LIST ? 0 : (int)s.variables.size();
+    if (s.onChange) {
+        s.lastValues.resize(s.variables.size());
+    }
     for (std::set<std::string>::iterator j = objIDs.begin(); j != objIDs.end(); ++j) {
         if (s.contextVars) {
             outputStorage.writeString(*j);
         }
         if (numVars > 0) {
             std::vector<std::vector<unsigned char> >::const_iterator k = s.parameters.begin();
+            std::vector<std::vector<unsigned char> >::iterator last = s.lastValues.begin();
             for (std::vector<int>::const_iterator i = s.variables.begin(); i != s.variables.end(); ++i, ++k) {
+                tcpip::Storage varOutput;
                 tcpip::Storage message;
                 message.writeUnsignedByte(*i);
                 message.writeString(*j);
@@ -1187,11 +1228,11 @@ TraCIServer::processSingleSubscription(const Subscription& s, tcpip::Storage& wr
                     tmpOutput.readUnsignedByte();
                     int variable = tmpOutput.readUnsignedByte();
                     std::string id = tmpOutput.readString();
-                    outputStorage.writeUnsignedByte(variable);
-                    outputStorage.writeUnsignedByte(RTYPE_OK);
+                    varOutput.writeUnsignedByte(variable);
+                    varOutput.writeUnsignedByte(RTYPE_OK);
                     length -= (lengthLength + 1 + 4 + (int)id.length());
                     while (--length > 0) {
-                        outputStorage.writeUnsignedByte(tmpOutput.readUnsignedByte());
+                        varOutput.writeUnsignedByte(tmpOutput.readUnsignedByte());
                     }
                 } else {
                     //read length
@@ -1201,15 +1242,31 @@ TraCIServer::processSingleSubscription(const Subscription& s, tcpip::Storage& wr
                     //read status
                     tmpOutput.readUnsignedByte();
                     std::string msg = tmpOutput.readString();
-                    outputStorage.writeUnsignedByte(*i);
-                    outputStorage.writeUnsignedByte(RTYPE_ERR);
-                    outputStorage.writeUnsignedByte(TYPE_STRING);
-                    outputStorage.writeString(msg);
+                    varOutput.writeUnsignedByte(*i);
+                    varOutput.writeUnsignedByte(RTYPE_ERR);
+                    varOutput.writeUnsignedByte(TYPE_STRING);
+                    varOutput.writeString(msg);
                     errors = errors + msg;
                 }
+                if (s.onChange) {
+                    // send only the answers which differ from the ones of the last step
+                    std::vector<unsigned char> value(varOutput.begin(), varOutput.end());
+                    if (value == *last) {
+                        --numVars;
+                        ++last;
+                        continue;
+                    }
+                    last->swap(value);
+                    ++last;
+                }
+                outputStorage.writeStorage(varOutput);
             }
         }
     }
+    if (s.onChange && ok && numVars == 0) {
+        // nothing changed since the last step
+        return true;
+    }
     int length = (1 + 4) + 1 + (4 + (int)(s.id.length())) + 1 + (int)outputStorage.size();
     if (s.contextVars) {
         length += 4;
@@ -1232,8 +1289,18 @@ TraCIServer::processSingleSubscription(const Subscription& s, tcpip::Storage& wr
 }
 
 
+void
+TraCIServer::writeSubscriptionEnd(const Subscription& s, tcpip::Storage& writeInto) {
+    writeInto.writeUnsignedByte(0); // command length -> extended
+    writeInto.writeInt((1 + 4) + 1 + (4 + (int)(s.id.length())) + 1);
+    writeInto.writeUnsignedByte(s.commandId + 0x10);
+    writeInto.writeString(s.id);
+    writeInto.writeUnsignedByte(0);
+}
+
+
 bool
-TraCIServer::addObjectVariableSubscription(const int commandId, const bool hasContext) {
+TraCIServer::addObjectVariableSubscription(const int commandId, const bool hasContext, const bool onChange) {
     const SUMOTime beginTime = myInputStorage.readInt();
     const SUMOTime endTime = myInputStorage.readInt();
     const std::string id = myInputStorage.readString();
@@ -1257,6 +1324,191 @@ TraCIServer::addObjectVariableSubscription(const int commandId, const bool hasCo
     }
     // process subscription
     Subscription s(commandId, id, variables, parameters, beginTime, endTime, hasContext, domain, range);
+    s.onChange = onChange;
+    initialiseSubscription(s);
+    return true;
+}
+
+
+bool
+TraCIServer::retrieveVariable(int domain, int variable, const std::string& id, tcpip::Storage& response, std::string& error) {
+    if (myExecutors.find(domain) == myExecutors.end()) {
+        error = "Unsupported domain " + toHex(domain, 2) + " specified";
+        return false;
+    }
+    tcpip::Storage message;
+    message.writeUnsignedByte(variable);
+    message.writeString(id);
+    const bool ok = myExecutors[domain](*this, message, response);
+    // read status (always short)
+    response.readUnsignedByte();
+    response.readUnsignedByte();
+    response.readUnsignedByte();
+    error = response.readString();
+    if (!ok) {
+        return false;
+    }
+    // read header of the response
+    if (response.readUnsignedByte() == 0) {
+        response.readInt();
+    }
+    response.readUnsignedByte();
+    response.readUnsignedByte();
+    response.readString();
+    return true;
+}
+
+
+bool
+TraCIServer::processDomainSubscription(Subscription& s, tcpip::Storage& writeInto,
+                                       std::string& errors) {
+    const SUMOTime t = MSNet::getInstance()->getCurrentTimeStep();
+    tcpip::Storage outputStorage;
+    outputStorage.writeInt((int)t);
+    // retrieve the ids and keep the order of the ones which were already sent
+    std::string idError;
+    std::vector<std::string> ids;
+    tcpip::Storage idResponse;
+    bool ok = retrieveVariable(s.contextDomain, ID_LIST, "", idResponse, idError);
+    if (ok && idResponse.readUnsignedByte() == TYPE_STRINGLIST) {
+        ids = idResponse.readStringList();
+    } else {
+        idError = "Could not retrieve the ids of domain " + toHex(s.contextDomain, 2) + " (" + idError + ")";
+        ok = false;
+    }
+    const std::set<std::string> current(ids.begin(), ids.end());
+    const std::set<std::string> previous(s.objectIDs.begin(), s.objectIDs.end());
+    std::vector<std::string> objectIDs;
+    std::vector<std::string> removed;
+    std::vector<std::string> added;
+    for (std::vector<std::string>::const_iterator i = s.objectIDs.begin(); i != s.objectIDs.end(); ++i) {
+        if (current.count(*i) != 0) {
+            objectIDs.push_back(*i);
+        } else {
+            removed.push_back(*i);
+        }
+    }
+    for (std::vector<std::string>::const_iterator i = ids.begin(); i != ids.end(); ++i) {
+        if (previous.count(*i) == 0) {
+            objectIDs.push_back(*i);
+            added.push_back(*i);
+        }
+    }
+    if (s.idDelta && s.lastTime >= 0) {
+        outputStorage.writeUnsignedByte(1);
+        outputStorage.writeInt((int)s.lastTime);
+        outputStorage.writeStringList(removed);
+        outputStorage.writeStringList(added);
+    } else {
+        outputStorage.writeUnsignedByte(0);
+        outputStorage.writeStringList(objectIDs);
+    }
+    outputStorage.writeInt((int)objectIDs.size());
+    s.objectIDs = objectIDs;
+    s.lastTime = t;
+    // retrieve the values column by column
+    for (std::vector<int>::const_iterator i = s.variables.begin(); i != s.variables.end(); ++i) {
+        std::string error = idError;
+        int type = TYPE_DOUBLE;
+        std::vector<double> column;
+        column.reserve(objectIDs.size());
+        for (std::vector<std::string>::const_iterator j = objectIDs.begin(); j != objectIDs.end() && error == ""; ++j) {
+            tcpip::Storage response;
+            if (!retrieveVariable(s.contextDomain, *i, *j, response, error)) {
+                break;
+            }
+            const int valueType = response.readUnsignedByte();
+            int components = 0;
+            switch (valueType) {
+                case TYPE_DOUBLE:
+                case TYPE_INTEGER:
+                case TYPE_UBYTE:
+                case TYPE_BYTE:
+                    components = 1;
+                    break;
+                case POSITION_2D:
+                    components = 2;
+                    break;
+                case POSITION_3D:
+                    components = 3;
+                    break;
+                default:
+                    break;
+            }
+            if (components == 0 || (j != objectIDs.begin() && valueType != type)) {
+                error = "Variable " + toHex(*i, 2) + " of object '" + *j + "' is not numeric";
+                break;
+            }
+            type = valueType;
+            for (int k = 0; k < components; ++k) {
+                switch (valueType) {
+                    case TYPE_INTEGER:
+                        column.push_back(response.readInt());
+                        break;
+                    case TYPE_UBYTE:
+                        column.push_back(response.readUnsignedByte());
+                        break;
+                    case TYPE_BYTE:
+                        column.push_back(response.readByte());
+                        break;
+                    default:
+                        column.push_back(response.readDouble());
+                        break;
+                }
+            }
+        }
+        outputStorage.writeUnsignedByte(*i);
+        if (error == "") {
+            outputStorage.writeUnsignedByte(RTYPE_OK);
+            outputStorage.writeUnsignedByte(type);
+            for (std::vector<double>::const_iterator k = column.begin(); k != column.end(); ++k) {
+                outputStorage.writeDouble(*k);
+            }
+        } else {
+            outputStorage.writeUnsignedByte(RTYPE_ERR);
+            outputStorage.writeUnsignedByte(TYPE_STRING);
+            outputStorage.writeString(error);
+            errors = errors + error;
+            ok = false;
+        }
+    }
+    writeInto.writeUnsignedByte(0); // command length -> extended
+    writeInto.writeInt((1 + 4) + 1 + 1 + 1 + (int)outputStorage.size());
+    writeInto.writeUnsignedByte(RESPONSE_SUBSCRIBE_DOMAIN_VARIABLES);
+    writeInto.writeUnsignedByte(s.contextDomain);
+    writeInto.writeUnsignedByte((int)s.variables.size());
+    writeInto.writeStorage(outputStorage);
+    return ok;
+}
+
+
+bool
+TraCIServer::addDomainVariableSubscription() {
+    const SUMOTime beginTime = myInputStorage.readInt();
+    const SUMOTime endTime = myInputStorage.readInt();
+    const int domain = myInputStorage.readUnsignedByte();
+    const int flags = myInputStorage.readUnsignedByte();
+    const int num = myInputStorage.readUnsignedByte();
+    std::vector<int> variables;
+    std::vector<std::vector<unsigned char> > parameters;
+    bool hasParameters = false;
+    for (int i = 0; i < num; ++i) {
+        const int varID = myInputStorage.readUnsignedByte();
+        variables.push_back(varID);
+        parameters.push_back(std::vector<unsigned char>());
+        hasParameters |= myParameterSizes[varID] > 0;
+    }
+    if (hasParameters) {
+        return writeErrorStatusCmd(CMD_SUBSCRIBE_DOMAIN_VARIABLES, "Domain subscriptions do not support variables with parameters.", myOutputStorage);
+    }
+    // check subscribe/unsubscribe
+    if (variables.size() == 0) {
+        removeSubscription(CMD_SUBSCRIBE_DOMAIN_VARIABLES, "", domain);
+        return true;
+    }
+    // process subscription
+    Subscription s(CMD_SUBSCRIBE_DOMAIN_VARIABLES, "", variables, parameters, beginTime, endTime, false, domain, 0.);
+    s.idDelta = (flags & 1) != 0;
     initialiseSubscription(s);
     return true;
 }
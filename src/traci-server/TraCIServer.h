@@ -270,8 +270,9 @@ public:
 private:
     /** @brief Constructor
      * @param[in] port The port to listen to (to open)
+     * @param[in] shmName The name of the shared memory segment to use instead of the port (if not empty)
      */
-    TraCIServer(const SUMOTime begin, const int port, const int numClients);
+    TraCIServer(const SUMOTime begin, const int port, const int numClients, const std::string& shmName);
 
 
     /// @brief Destructor
@@ -403,7 +404,7 @@ private:
                      const std::vector<int>& variablesArg, const std::vector<std::vector<unsigned char> >& paramsArg,
                      SUMOTime beginTimeArg, SUMOTime endTimeArg, bool contextVarsArg, int contextDomainArg, double rangeArg)
             : commandId(commandIdArg), id(idArg), variables(variablesArg), parameters(paramsArg), beginTime(beginTimeArg), endTime(endTimeArg),
-              contextVars(contextVarsArg), contextDomain(contextDomainArg), range(rangeArg) {}
+              contextVars(contextVarsArg), contextDomain(contextDomainArg), range(rangeArg), lastTime(-1), idDelta(false), onChange(false) {}
 
         /// @brief commandIdArg The command id of the subscription
         int commandId;
@@ -423,6 +424,16 @@ private:
         int contextDomain;
         /// @brief The range of the context
         double range;
+        /// @brief The ids of the objects sent last (domain subscriptions only)
+        std::vector<std::string> objectIDs;
+        /// @brief The time the ids were sent last (domain subscriptions only, -1 if never)
+        SUMOTime lastTime;
+        /// @brief Whether only the changes of the ids since the last step are sent (domain subscriptions only)
+        bool idDelta;
+        /// @brief Whether only the variables which changed since the last step are sent, unchanged objects are omitted (variable subscriptions only)
+        bool onChange;
+        /// @brief The answers sent last for each variable (on-change subscriptions only)
+        std::vector<std::vector<unsigned char> > lastValues;
 
     };
 
@@ -439,12 +450,38 @@ private:
     std::map<MSNet::VehicleState, std::vector<std::string> > myVehicleStateChanges;
 
 private:
-    bool addObjectVariableSubscription(const int commandId, const bool hasContext);
-    void initialiseSubscription(const Subscription& s);
+    bool addObjectVariableSubscription(const int commandId, const bool hasContext, const bool onChange);
+    bool addDomainVariableSubscription();
+    void initialiseSubscription(TraCIServer::Subscription& s);
     void removeSubscription(int commandId, const std::string& identity, int domain);
-    bool processSingleSubscription(const TraCIServer::Subscription& s, tcpip::Storage& writeInto,
+    bool processSingleSubscription(TraCIServer::Subscription& s, tcpip::Storage& writeInto,
                                    std::string& errors);
 
+    /** @brief Writes the response which tells the client that an on-change subscription has ended
+     *
+     * On-change subscriptions send nothing for objects whose values did not change,
+     *  so a response without variables means that the object is gone or the end time was reached.
+     */
+    void writeSubscriptionEnd(const Subscription& s, tcpip::Storage& writeInto);
+
+    /** @brief Writes the values of all objects of the subscribed domain as columns
+     *
+     * The ids are written once (or as a delta to the ones of the last step),
+     *  followed by one array of doubles for each (numeric) variable.
+     */
+    bool processDomainSubscription(TraCIServer::Subscription& s, tcpip::Storage& writeInto,
+                                   std::string& errors);
+
+    /** @brief Retrieves a single variable of a single object using the executor of the domain
+     * @param[in] domain The get command id of the domain
+     * @param[in] variable The variable to retrieve
+     * @param[in] id The id of the object
+     * @param[out] response The storage positioned at the type of the value
+     * @param[out] error The error message if the value could not be retrieved
+     * @return Whether the value could be retrieved
+     */
+    bool retrieveVariable(int domain, int variable, const std::string& id, tcpip::Storage& response, std::string& error);
+
 
     bool findObjectShape(int domain, const std::string& id, PositionVector& shape);
 
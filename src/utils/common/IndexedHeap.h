@@ -0,0 +1,208 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    IndexedHeap.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// A d-ary heap of pointers which knows the position of each element
+/****************************************************************************/
+#ifndef IndexedHeap_h
+#define IndexedHeap_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+#include <cassert>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class IndexedHeap
+ * @brief A d-ary heap of pointers which knows the position of each element
+ *
+ * The elements need a public int member heapIndex which is maintained by the
+ *  heap and is -1 for elements which are not in the heap. This allows to
+ *  change the key of an element (usually decreasing the effort of an edge in
+ *  a shortest path search) in logarithmic time without searching it.
+ *
+ * The comparator has the same semantics as for std::push_heap, the front is
+ *  the element which is not less than any other element. If the comparator
+ *  is a strict total order, the sequence of popped elements is the same as
+ *  for std::push_heap / std::pop_heap.
+ *
+ * The template parameters are:
+ * @param T The element class (with member heapIndex)
+ * @param C The comparator
+ * @param D The number of children of each node
+ */
+template<class T, class C, int D = 4>
+class IndexedHeap {
+public:
+    typedef typename std::vector<T*>::const_iterator const_iterator;
+
+    /// @brief Constructor
+    IndexedHeap() {}
+
+
+    /// @brief Returns whether the heap is empty
+    bool empty() const {
+        return myElements.empty();
+    }
+
+
+    /// @brief Returns the number of elements
+    int size() const {
+        return (int)myElements.size();
+    }
+
+
+    /// @brief Returns the front element
+    T* front() const {
+        return myElements.front();
+    }
+
+
+    /// @brief Returns whether the given element is in the heap
+    bool contains(const T* const t) const {
+        return t->heapIndex >= 0;
+    }
+
+
+    /// @brief Adds an element which is not in the heap yet
+    void push(T* const t) {
+        assert(t->heapIndex < 0);
+        t->heapIndex = (int)myElements.size();
+        myElements.push_back(t);
+        siftUp(t->heapIndex);
+    }
+
+
+    /// @brief Removes the front element
+    void pop() {
+        T* const last = myElements.back();
+        myElements.front()->heapIndex = -1;
+        myElements.pop_back();
+        if (!myElements.empty()) {
+            myElements.front() = last;
+            last->heapIndex = 0;
+            siftDown(0);
+        }
+    }
+
+
+    /** @brief Restores the heap after an element moved towards the front (e.g. its effort decreased)
+     * and adds the element if it is not in the heap
+     */
+    void update(T* const t) {
+        if (t->heapIndex < 0) {
+            push(t);
+        } else {
+            siftUp(t->heapIndex);
+        }
+    }
+
+
+    /// @brief Removes all elements
+    void clear() {
+        for (T* const t : myElements) {
+            t->heapIndex = -1;
+        }
+        myElements.clear();
+    }
+
+
+    /// @brief Iteration over the elements (in no particular order)
+    const_iterator begin() const {
+        return myElements.begin();
+    }
+
+    const_iterator end() const {
+        return myElements.end();
+    }
+
+
+private:
+    /// @brief moves the element at the given position towards the front
+    void siftUp(int pos) {
+        T* const t = myElements[pos];
+        while (pos > 0) {
+            const int parent = (pos - 1) / D;
+            if (!myCmp(myElements[parent], t)) {
+                break;
+            }
+            myElements[pos] = myElements[parent];
+            myElements[pos]->heapIndex = pos;
+            pos = parent;
+        }
+        myElements[pos] = t;
+        t->heapIndex = pos;
+    }
+
+
+    /// @brief moves the element at the given position away from the front
+    void siftDown(int pos) {
+        T* const t = myElements[pos];
+        const int num = (int)myElements.size();
+        while (true) {
+            const int first = D * pos + 1;
+            if (first >= num) {
+                break;
+            }
+            int best = first;
+            const int last = first + D < num ? first + D : num;
+            for (int child = first + 1; child < last; child++) {
+                if (myCmp(myElements[best], myElements[child])) {
+                    best = child;
+                }
+            }
+            if (!myCmp(t, myElements[best])) {
+                break;
+            }
+            myElements[pos] = myElements[best];
+            myElements[pos]->heapIndex = pos;
+            pos = best;
+        }
+        myElements[pos] = t;
+        t->heapIndex = pos;
+    }
+
+
+private:
+    /// @brief the heap
+    std::vector<T*> myElements;
+
+    /// @brief the comparator
+    C myCmp;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    IndexedHeap(const IndexedHeap& src);
+
+    /// @brief Invalidated assignment operator.
+    IndexedHeap& operator=(const IndexedHeap& src);
+
+};
+
+
+#endif
+
+/****************************************************************************/
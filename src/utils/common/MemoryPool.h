@@ -0,0 +1,208 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    MemoryPool.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// A free list allocator for the objects of a class hierarchy
+/****************************************************************************/
+#ifndef MemoryPool_h
+#define MemoryPool_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include <utils/common/StdDefs.h>
+
+// the sanitizers need to see every allocation and deallocation
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define NO_MEMORY_POOL
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) || __has_feature(memory_sanitizer)
+#define NO_MEMORY_POOL
+#endif
+#endif
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MemoryPool
+ * @brief A free list allocator for the objects of a class hierarchy
+ *
+ * The base class of the hierarchy defines operator new and operator delete
+ *  using allocate and deallocate. The memory of deleted objects is kept in a free
+ *  list per (rounded) object size and handed out again for the next object of
+ *  the same size, so objects which are created and deleted frequently (like
+ *  vehicles and their devices) do not stress the system allocator.
+ *
+ * The free lists belong to the calling thread, so no locking is needed. Memory
+ *  freed by one thread and allocated by another simply changes the list. The
+ *  lists are never handed over between threads, so if one thread only frees
+ *  what another one allocates (a producer / consumer pattern) the pool does not
+ *  help: the freeing thread's list fills up and the allocating thread always
+ *  gets new memory. This is safe but not what the pool is meant for, the
+ *  simulation creates and deletes vehicles in the main thread. Each list keeps
+ *  at most MAX_FREE blocks, further blocks are given back to the system
+ *  immediately as are all blocks of a thread's lists when the thread ends (for
+ *  the main thread at program exit). So the memory kept by a thread is bounded
+ *  no matter which thread allocated it. Objects deleted after that (e.g. by
+ *  static destructors) bypass the pool.
+ *
+ * Defining NO_MEMORY_POOL (cmake -DNO_MEMORY_POOL=ON or configure
+ *  --disable-memory-pool, e.g. for valgrind) bypasses the pool completely,
+ *  builds with address, thread or memory sanitizer do so automatically.
+ *  The template parameter only serves to give each hierarchy its own pool.
+ */
+template<class T>
+class MemoryPool {
+public:
+    /** @brief Returns memory for an object of the given size
+     * @param[in] size The size of the object in bytes
+     * @return Memory suitably aligned for the object
+     */
+    static void* allocate(const std::size_t size) {
+#ifndef NO_MEMORY_POOL
+        const std::size_t index = (size + ALIGNMENT - 1) / ALIGNMENT;
+        FreeLists* const lists = getFreeLists();
+        if (lists != nullptr && index < lists->heads.size() && lists->heads[index] != nullptr) {
+            Block* const block = lists->heads[index];
+            lists->heads[index] = block->next;
+            lists->sizes[index]--;
+            return block;
+        }
+        // the rounded size lets all blocks of a list serve all objects of the list
+        return ::operator new(index * ALIGNMENT);
+#else
+        return ::operator new(size);
+#endif
+    }
+
+
+    /** @brief Gives the memory of an object back to the pool
+     * @param[in] p The memory of the object (as returned by allocate)
+     * @param[in] size The size of the object in bytes (the same as for allocate)
+     */
+    static void deallocate(void* p, const std::size_t size) {
+        if (p == nullptr) {
+            return;
+        }
+#ifndef NO_MEMORY_POOL
+        const std::size_t index = (size + ALIGNMENT - 1) / ALIGNMENT;
+        FreeLists* const lists = getFreeLists();
+        if (lists != nullptr) {
+            if (index >= lists->heads.size()) {
+                lists->heads.resize(index + 1, nullptr);
+                lists->sizes.resize(index + 1, 0);
+            }
+            if (lists->sizes[index] < MAX_FREE) {
+                Block* const block = static_cast<Block*>(p);
+                block->next = lists->heads[index];
+                lists->heads[index] = block;
+                lists->sizes[index]++;
+                return;
+            }
+        }
+#else
+        UNUSED_PARAMETER(size);
+#endif
+        ::operator delete(p);
+    }
+
+
+    /** @brief Returns the number of free blocks the calling thread keeps for objects of the given size
+     * @param[in] size The size of the object in bytes
+     * @return The length of the free list (always 0 if the pool is disabled)
+     */
+    static int getNumFree(const std::size_t size) {
+#ifndef NO_MEMORY_POOL
+        const std::size_t index = (size + ALIGNMENT - 1) / ALIGNMENT;
+        FreeLists* const lists = getFreeLists();
+        if (lists != nullptr && index < lists->sizes.size()) {
+            return lists->sizes[index];
+        }
+#else
+        UNUSED_PARAMETER(size);
+#endif
+        return 0;
+    }
+
+
+    /// @brief the maximum number of free blocks kept per object size and thread
+    static const int MAX_FREE = 4096;
+
+
+private:
+    /// @brief a free block of memory, linking to the next free block of the same size
+    struct Block {
+        Block* next;
+    };
+
+    /// @brief the free lists of a single thread
+    struct FreeLists {
+        /// @brief gives all blocks back to the system (at the end of the thread)
+        ~FreeLists() {
+            for (Block* block : heads) {
+                while (block != nullptr) {
+                    Block* const next = block->next;
+                    ::operator delete(block);
+                    block = next;
+                }
+            }
+            isDestroyed() = true;
+        }
+        /// @brief the first free block indexed by the object size divided by ALIGNMENT
+        std::vector<Block*> heads;
+        /// @brief the number of free blocks in each list
+        std::vector<int> sizes;
+    };
+
+    /// @brief the granularity of the object sizes (also the alignment of the blocks)
+    static const std::size_t ALIGNMENT = 16;
+
+    /// @brief returns the free lists of the calling thread (0 if they have already been destroyed)
+    static FreeLists* getFreeLists() {
+        if (isDestroyed()) {
+            return nullptr;
+        }
+        static thread_local FreeLists lists;
+        return &lists;
+    }
+
+
+    /// @brief whether the free lists of the calling thread have been destroyed (trivially destructible, so always valid)
+    static bool& isDestroyed() {
+        static thread_local bool destroyed = false;
+        return destroyed;
+    }
+
+
+private:
+    /// @brief Invalidated constructor (only static members)
+    MemoryPool();
+
+};
+
+
+#endif
+
+/****************************************************************************/
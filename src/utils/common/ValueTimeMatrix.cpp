@@ -0,0 +1,141 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    ValueTimeMatrix.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// A dense matrix of values for numbered objects (edges) and equidistant time intervals
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cmath>
+#include <limits>
+#include "StdDefs.h"
+#include "MsgHandler.h"
+#include "ToString.h"
+#include "ValueTimeMatrix.h"
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const double ValueTimeMatrix::MAX_VALUES = 1 << 28;
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+ValueTimeMatrix::ValueTimeMatrix() :
+    myBegin(0.), myLength(-1.), myAmDense(true), myExtendOverEnd(false) {}
+
+
+ValueTimeMatrix::~ValueTimeMatrix() {}
+
+
+void
+ValueTimeMatrix::add(const int index, const double begin, const double end, const double value) {
+    if (!myAmDense) {
+        return;
+    }
+    if (myLength < 0.) {
+        myBegin = begin;
+        myLength = end - begin;
+    }
+    const double first = std::floor((begin - myBegin) / myLength + 0.5);
+    const double last = std::floor((end - myBegin) / myLength + 0.5);
+    const double numRows = MAX2(index + 1, (int)myLastInterval.size());
+    if (!(myLength > 0.) || first < 0. || last <= first
+            || begin != myBegin + first * myLength || end != myBegin + last * myLength) {
+        invalidate();
+        return;
+    }
+    if (MAX2(last, (double)myValues.size()) * numRows > MAX_VALUES) {
+        WRITE_WARNING("The dense weight storage would exceed its limit of " + toString((long long int)MAX_VALUES) + " values (1 GiB), falling back to the slower time lines.");
+        invalidate();
+        return;
+    }
+    addRows(index);
+    while ((int)myValues.size() < (int)last) {
+        myValues.push_back(std::vector<float>(myLastInterval.size(), std::numeric_limits<float>::quiet_NaN()));
+    }
+    for (int i = (int)first; i < (int)last; i++) {
+        myValues[i][index] = (float)value;
+    }
+    myLastInterval[index] = MAX2(myLastInterval[index], (int)last - 1);
+}
+
+
+void
+ValueTimeMatrix::remove(const int index) {
+    if (index < (int)myLastInterval.size()) {
+        for (std::vector<float>& values : myValues) {
+            values[index] = std::numeric_limits<float>::quiet_NaN();
+        }
+        myLastInterval[index] = -1;
+    }
+}
+
+
+bool
+ValueTimeMatrix::retrieve(const int index, const double time, double& value) const {
+    if (index >= (int)myLastInterval.size() || myLastInterval[index] < 0 || time < myBegin) {
+        return false;
+    }
+    const int lastInterval = myLastInterval[index];
+    const double interval = std::floor((time - myBegin) / myLength);
+    if (interval > lastInterval) {
+        if (!myExtendOverEnd) {
+            return false;
+        }
+        value = myValues[lastInterval][index];
+        return true;
+    }
+    const float result = myValues[(int)interval][index];
+    if (std::isnan(result)) {
+        return false;
+    }
+    value = result;
+    return true;
+}
+
+
+void
+ValueTimeMatrix::addRows(const int index) {
+    if (index >= (int)myLastInterval.size()) {
+        // grow geometrically to avoid copying all intervals for every new object
+        const int size = MAX2(index + 1, 2 * (int)myLastInterval.size());
+        for (std::vector<float>& values : myValues) {
+            values.resize(size, std::numeric_limits<float>::quiet_NaN());
+        }
+        myLastInterval.resize(size, -1);
+    }
+}
+
+
+void
+ValueTimeMatrix::invalidate() {
+    myValues.clear();
+    myLastInterval.clear();
+    myAmDense = false;
+}
+
+
+/****************************************************************************/
+
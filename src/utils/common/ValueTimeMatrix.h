@@ -0,0 +1,153 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    ValueTimeMatrix.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// A dense matrix of values for numbered objects (edges) and equidistant time intervals
+/****************************************************************************/
+#ifndef ValueTimeMatrix_h
+#define ValueTimeMatrix_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class ValueTimeMatrix
+ * @brief A dense matrix of values for numbered objects (edges) and equidistant time intervals
+ *
+ * The matrix is an alternative to one ValueTimeLine per edge for the common case
+ *  of weights which were aggregated over intervals of the same length. The first
+ *  added interval defines the begin and the length of all intervals. Retrieving a
+ *  value is a constant time lookup then. The values for one interval are stored
+ *  contiguously because a route search mostly asks for the values of many edges
+ *  at similar times.
+ *
+ * The values are stored as single precision floats to halve the memory, so a
+ *  retrieved value is the added value rounded to a relative precision of about
+ *  6e-8 (24 bit mantissa). Apart from this rounding, the matrix describes the same
+ *  values as a ValueTimeLine filled with the same data (without calling fillGaps)
+ *  as long as all added intervals are aligned to this grid.
+ *
+ * If an interval does not fit, the matrix discards its data and isDense() returns
+ *  false, so the caller needs to fall back to the time lines. The same happens
+ *  (with a warning) if the matrix would need more than MAX_VALUES (2^28) values,
+ *  which is 1 GiB of memory.
+ */
+class ValueTimeMatrix {
+public:
+    /// @brief Constructor
+    ValueTimeMatrix();
+
+    /// @brief Destructor
+    ~ValueTimeMatrix();
+
+
+    /** @brief Adds a value for an object and a time interval
+     *
+     * Earlier values of the object in the interval are overwritten. If the interval
+     *  does not fit the grid the matrix is not dense anymore.
+     *
+     * @param[in] index the numerical id of the object
+     * @param[in] begin the start time of the interval (inclusive)
+     * @param[in] end the end time of the interval (exclusive)
+     * @param[in] value the value to store
+     */
+    void add(const int index, const double begin, const double end, const double value);
+
+
+    /** @brief Removes all values of the given object
+     * @param[in] index the numerical id of the object
+     */
+    void remove(const int index);
+
+
+    /** @brief Returns the value for the given object and time if there is one
+     * @param[in] index the numerical id of the object
+     * @param[in] time the time for which the value shall be retrieved
+     * @param[out] value the value if the time is described
+     * @return Whether a value was set for the object and time
+     */
+    bool retrieve(const int index, const double time, double& value) const;
+
+
+    /// @brief Returns whether all values could be stored in the matrix
+    bool isDense() const {
+        return myAmDense;
+    }
+
+
+    /** @brief Sets whether the last value of each object is valid for all later times as well
+     * @see ValueTimeLine::fillGaps
+     */
+    void setExtendOverEnd(const bool extend) {
+        myExtendOverEnd = extend;
+    }
+
+
+private:
+    /// @brief makes room for the given object
+    void addRows(const int index);
+
+    /// @brief discards all values and marks the matrix as not being dense
+    void invalidate();
+
+
+private:
+    /// @brief the begin of the first interval
+    double myBegin;
+
+    /// @brief the length of the intervals (-1 as long as no interval was added)
+    double myLength;
+
+    /// @brief the values (NaN if not set), one vector over all objects per interval
+    std::vector<std::vector<float> > myValues;
+
+    /// @brief the index of the last interval with a value for each object (-1 if there is none)
+    std::vector<int> myLastInterval;
+
+    /// @brief whether all added intervals fit the grid
+    bool myAmDense;
+
+    /// @brief whether the last value of each object is valid for all later times
+    bool myExtendOverEnd;
+
+    /// @brief the maximum number of values, 2^28 floats or 1 GiB (protects against very short intervals)
+    static const double MAX_VALUES;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    ValueTimeMatrix(const ValueTimeMatrix&);
+
+    /// @brief Invalidated assignment operator.
+    ValueTimeMatrix& operator=(const ValueTimeMatrix&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,87 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2004-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    FXConditionalLock.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// A scoped lock which only triggers on condition
+/****************************************************************************/
+
+#ifndef FXConditionalLock_h
+#define FXConditionalLock_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <fx.h>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class FXConditionalLock
+ * @brief A scoped lock which only triggers on condition
+ *
+ * This is used to guard shared data which only needs protection when the
+ *  simulation runs in parallel, so the single threaded case does not pay
+ *  for the locking.
+ */
+class FXConditionalLock {
+public:
+    /** @brief Constructor
+     *
+     * Locks the given mutex if the condition holds.
+     *
+     * @param[in] fxMutex the mutex to lock
+     * @param[in] condition whether locking shall take place at all
+     */
+    FXConditionalLock(FXMutex& fxMutex, const bool condition)
+        : myMutex(fxMutex), myCondition(condition) {
+        if (condition) {
+            fxMutex.lock();
+        }
+    }
+
+    /// @brief Destructor, unlocks the mutex if it was locked on construction
+    ~FXConditionalLock() {
+        if (myCondition) {
+            myMutex.unlock();
+        }
+    }
+
+private:
+    /// @brief the mutex to lock
+    FXMutex& myMutex;
+
+    /// @brief whether the mutex was locked
+    const bool myCondition;
+
+private:
+    /// @brief Invalidated copy constructor.
+    FXConditionalLock(const FXConditionalLock&);
+
+    /// @brief Invalidated assignment operator.
+    FXConditionalLock& operator=(const FXConditionalLock&);
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -50,6 +50,9 @@ public:
      */
     class Task {
     public:
+        /// @brief Constructor
+        Task() : myIndex(0), myAmFinished(false) {}
+
         /// @brief Desctructor
         virtual ~Task() {};
 
@@ -72,9 +75,28 @@ public:
         void setIndex(const int newIndex) {
             myIndex = newIndex;
         }
+
+        /** @brief Marks the task as finished.
+         *
+         * This is called by the pool (with its mutex locked) when the worker completed the task.
+         */
+        void setFinished() {
+            myAmFinished = true;
+        }
+
+        /** @brief Returns whether the task has been completed (only reliable with the pool's mutex locked)
+         *
+         * @return whether the task was run by a worker
+         */
+        bool isFinished() const {
+            return myAmFinished;
+        }
     private:
         /// @brief the index of the task, valid only after the task has been added to the pool
         int myIndex;
+
+        /// @brief whether a worker completed the task
+        bool myAmFinished;
     };
 
     /**
@@ -145,6 +167,7 @@ public:
         void addFinished(Task* const t) {
             myMutex.lock();
             myNumFinished++;
+            t->setFinished();
             myFinishedTasks.push_back(t);
             myCondition.signal();
             myMutex.unlock();
@@ -168,6 +191,25 @@ public:
             myMutex.unlock();
         }
 
+        /** @brief waits for the given task to be finished and removes it from the list of finished tasks
+         *
+         * This allows to collect single results while other tasks are still running.
+         *  The caller becomes responsible for deleting the task. The task stays counted
+         *  as finished, so the indices of the pending tasks remain unique and waitAll
+         *  does not wait for it again. It may also be called after waitAll(false) collected
+         *  the task already.
+         *
+         * @param[in] t the task to wait for
+         */
+        void waitFor(Task* const t) {
+            myMutex.lock();
+            while (!t->isFinished()) {
+                myCondition.wait(myMutex);
+            }
+            myFinishedTasks.remove(t);
+            myMutex.unlock();
+        }
+
         /** @brief Checks whether there are currently more pending tasks than threads.
          *
          * This is only a rough estimate because the tasks are already assigned and there could be an idle thread even though the
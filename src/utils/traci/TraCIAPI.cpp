@@ -28,6 +28,7 @@
 #include <config.h>
 #endif
 
+#include <set>
 #include "TraCIAPI.h"
 
 using namespace libsumo;
@@ -74,6 +75,19 @@ TraCIAPI::connect(const std::string& host, int port) {
 }
 
 
+void
+TraCIAPI::connectSharedMemory(const std::string& name) {
+    mySocket = new tcpip::Socket(name, false);
+    try {
+        mySocket->connect();
+    } catch (tcpip::SocketException&) {
+        delete mySocket;
+        mySocket = 0;
+        throw;
+    }
+}
+
+
 void
 TraCIAPI::setOrder(int order) {
     tcpip::Storage outMsg;
@@ -197,7 +211,7 @@ TraCIAPI::send_commandSetValue(int domID, int varID, const std::string& objID, t
 
 void
 TraCIAPI::send_commandSubscribeObjectVariable(int domID, const std::string& objID, SUMOTime beginTime, SUMOTime endTime,
-        const std::vector<int>& vars) const {
+        const std::vector<int>& vars, bool onChange) const {
     if (mySocket == 0) {
         throw tcpip::SocketException("Socket is not initialised");
     }
@@ -205,8 +219,11 @@ TraCIAPI::send_commandSubscribeObjectVariable(int domID, const std::string& objI
     // command length (domID, objID, beginTime, endTime, length, vars)
     int varNo = (int) vars.size();
     outMsg.writeUnsignedByte(0);
-    outMsg.writeInt(5 + 1 + 4 + 4 + 4 + (int) objID.length() + 1 + varNo);
+    outMsg.writeInt(5 + (onChange ? 1 : 0) + 1 + 4 + 4 + 4 + (int) objID.length() + 1 + varNo);
     // command id
+    if (onChange) {
+        outMsg.writeUnsignedByte(CMD_SUBSCRIBE_ON_CHANGE);
+    }
     outMsg.writeUnsignedByte(domID);
     // time
     outMsg.writeInt((int)beginTime);
@@ -223,6 +240,35 @@ TraCIAPI::send_commandSubscribeObjectVariable(int domID, const std::string& objI
 }
 
 
+void
+TraCIAPI::send_commandSubscribeDomainVariables(int domain, SUMOTime beginTime, SUMOTime endTime, int flags,
+        const std::vector<int>& vars) const {
+    if (mySocket == 0) {
+        throw tcpip::SocketException("Socket is not initialised");
+    }
+    tcpip::Storage outMsg;
+    // command length (cmdID, beginTime, endTime, domain, flags, length, vars)
+    int varNo = (int) vars.size();
+    outMsg.writeUnsignedByte(0);
+    outMsg.writeInt(5 + 1 + 4 + 4 + 1 + 1 + 1 + varNo);
+    // command id
+    outMsg.writeUnsignedByte(CMD_SUBSCRIBE_DOMAIN_VARIABLES);
+    // time
+    outMsg.writeInt((int)beginTime);
+    outMsg.writeInt((int)endTime);
+    // domain and flags
+    outMsg.writeUnsignedByte(domain);
+    outMsg.writeUnsignedByte(flags);
+    // variables
+    outMsg.writeUnsignedByte(varNo);
+    for (int i = 0; i < varNo; ++i) {
+        outMsg.writeUnsignedByte(vars[i]);
+    }
+    // send message
+    mySocket->sendExact(outMsg);
+}
+
+
 void
 TraCIAPI::send_commandSubscribeObjectContext(int domID, const std::string& objID, SUMOTime beginTime, SUMOTime endTime,
         int domain, double range, const std::vector<int>& vars) const {
@@ -560,7 +606,22 @@ void
 TraCIAPI::readVariableSubscription(tcpip::Storage& inMsg) {
     const std::string objectID = inMsg.readString();
     const int variableCount = inMsg.readUnsignedByte();
+    SubscribedValues::iterator last = myOnChangeValues.find(objectID);
+    if (last != myOnChangeValues.end() && variableCount == 0) {
+        // the on-change subscription has ended
+        myOnChangeValues.erase(last);
+        mySubscribedValues.erase(objectID);
+        return;
+    }
     readVariables(inMsg, objectID, variableCount, mySubscribedValues);
+    if (last != myOnChangeValues.end()) {
+        // only the changed values were sent
+        const TraCIValues& changed = mySubscribedValues[objectID];
+        for (TraCIValues::const_iterator i = changed.begin(); i != changed.end(); ++i) {
+            last->second[i->first] = i->second;
+        }
+        mySubscribedValues[objectID] = last->second;
+    }
 }
 
 void
@@ -577,19 +638,75 @@ TraCIAPI::readContextSubscription(tcpip::Storage& inMsg) {
     }
 }
 
+void
+TraCIAPI::readDomainSubscription(tcpip::Storage& inMsg) {
+    const int domain = inMsg.readUnsignedByte();
+    int variableCount = inMsg.readUnsignedByte();
+    const SUMOTime time = inMsg.readInt();
+    DomainValues& into = mySubscribedDomainValues[domain];
+    if (inMsg.readUnsignedByte() == 0) {
+        into.ids = inMsg.readStringList();
+    } else {
+        const SUMOTime baseTime = inMsg.readInt();
+        const std::vector<std::string> removed = inMsg.readStringList();
+        const std::vector<std::string> added = inMsg.readStringList();
+        // the same step may be received twice (if other clients are slower)
+        if (time != into.time) {
+            if (baseTime != into.time) {
+                throw tcpip::SocketException("Missed an update of the ids of domain " + toString(domain) + ".");
+            }
+            const std::set<std::string> removedSet(removed.begin(), removed.end());
+            std::vector<std::string> ids;
+            for (std::vector<std::string>::const_iterator i = into.ids.begin(); i != into.ids.end(); ++i) {
+                if (removedSet.count(*i) == 0) {
+                    ids.push_back(*i);
+                }
+            }
+            ids.insert(ids.end(), added.begin(), added.end());
+            into.ids.swap(ids);
+        }
+    }
+    into.time = time;
+    const int numObjects = inMsg.readInt();
+    while (variableCount > 0) {
+        const int variableID = inMsg.readUnsignedByte();
+        const int status = inMsg.readUnsignedByte();
+        const int type = inMsg.readUnsignedByte();
+        if (status != RTYPE_OK) {
+            throw tcpip::SocketException("Subscription response error: variableID=" + toString(variableID) + " status=" + toString(status) + " " + inMsg.readString());
+        }
+        const int components = type == POSITION_3D ? 3 : (type == POSITION_2D ? 2 : 1);
+        std::vector<double>& column = into.values[variableID];
+        column.resize(numObjects * components);
+        for (std::vector<double>::iterator i = column.begin(); i != column.end(); ++i) {
+            *i = inMsg.readDouble();
+        }
+        into.types[variableID] = type;
+        variableCount--;
+    }
+}
+
 void
 TraCIAPI::simulationStep(SUMOTime time) {
     send_commandSimulationStep(time);
     tcpip::Storage inMsg;
     check_resultState(inMsg, CMD_SIMSTEP);
 
-    mySubscribedValues.clear();
+    // objects of on-change subscriptions are only sent when something changed
+    mySubscribedValues = myOnChangeValues;
     mySubscribedContextValues.clear();
+    for (SubscribedDomainValues::iterator i = mySubscribedDomainValues.begin(); i != mySubscribedDomainValues.end(); ++i) {
+        // keep the ids for the next delta
+        i->second.types.clear();
+        i->second.values.clear();
+    }
     int numSubs = inMsg.readInt();
     while (numSubs > 0) {
         int cmdId = check_commandGetResult(inMsg, 0, -1, true);
         if (cmdId >= RESPONSE_SUBSCRIBE_INDUCTIONLOOP_VARIABLE && cmdId <= RESPONSE_SUBSCRIBE_PERSON_VARIABLE) {
             readVariableSubscription(inMsg);
+        } else if (cmdId == RESPONSE_SUBSCRIBE_DOMAIN_VARIABLES) {
+            readDomainSubscription(inMsg);
         } else {
             readContextSubscription(inMsg);
         }
@@ -1564,6 +1681,11 @@ TraCIAPI::SimulationScope::getMinExpectedNumber() const {
     return myParent.getInt(CMD_GET_SIM_VARIABLE, VAR_MIN_EXPECTED_VEHICLES, "");
 }
 
+double
+TraCIAPI::SimulationScope::getStepProfile(const std::string& phase) const {
+    return myParent.getDouble(CMD_GET_SIM_VARIABLE, VAR_STEP_PROFILE, phase);
+}
+
 void
 TraCIAPI::SimulationScope::subscribe(int domID, const std::string& objID, SUMOTime beginTime, SUMOTime endTime, const std::vector<int>& vars) const {
     myParent.send_commandSubscribeObjectVariable(domID, objID, beginTime, endTime, vars);
@@ -1572,6 +1694,22 @@ TraCIAPI::SimulationScope::subscribe(int domID, const std::string& objID, SUMOTi
     if (vars.size() > 0) {
         myParent.check_commandGetResult(inMsg, domID);
         myParent.readVariableSubscription(inMsg);
+    } else {
+        myParent.myOnChangeValues.erase(objID);
+    }
+}
+
+void
+TraCIAPI::SimulationScope::subscribeOnChange(int domID, const std::string& objID, SUMOTime beginTime, SUMOTime endTime, const std::vector<int>& vars) const {
+    myParent.send_commandSubscribeObjectVariable(domID, objID, beginTime, endTime, vars, true);
+    tcpip::Storage inMsg;
+    myParent.check_resultState(inMsg, domID);
+    if (vars.size() > 0) {
+        myParent.myOnChangeValues[objID];
+        myParent.check_commandGetResult(inMsg, domID);
+        myParent.readVariableSubscription(inMsg);
+    } else {
+        myParent.myOnChangeValues.erase(objID);
     }
 }
 
@@ -1617,6 +1755,30 @@ TraCIAPI::SimulationScope::getContextSubscriptionResults(const std::string& objI
 }
 
 
+void
+TraCIAPI::SimulationScope::subscribeDomain(int domain, SUMOTime beginTime, SUMOTime endTime, const std::vector<int>& vars, bool idDelta) const {
+    myParent.send_commandSubscribeDomainVariables(domain, beginTime, endTime, idDelta ? 1 : 0, vars);
+    tcpip::Storage inMsg;
+    myParent.check_resultState(inMsg, CMD_SUBSCRIBE_DOMAIN_VARIABLES);
+    if (vars.size() > 0) {
+        myParent.check_commandGetResult(inMsg, CMD_SUBSCRIBE_DOMAIN_VARIABLES);
+        myParent.readDomainSubscription(inMsg);
+    } else {
+        myParent.mySubscribedDomainValues.erase(domain);
+    }
+}
+
+
+const TraCIAPI::DomainValues
+TraCIAPI::SimulationScope::getDomainSubscriptionResults(int domain) const {
+    if (myParent.mySubscribedDomainValues.find(domain) != myParent.mySubscribedDomainValues.end()) {
+        return myParent.mySubscribedDomainValues[domain];
+    } else {
+        return DomainValues();
+    }
+}
+
+
 // ---------------------------------------------------------------------------
 // TraCIAPI::TrafficLightScope-methods
 // ---------------------------------------------------------------------------
@@ -74,6 +74,12 @@ public:
      */
     void connect(const std::string& host, int port);
 
+    /** @brief Connects to a SUMO server on the same host via shared memory (sumo --remote-shm)
+     * @param[in] name The name of the shared memory segment
+     * @exception tcpip::SocketException if the connection fails
+     */
+    void connectSharedMemory(const std::string& name);
+
     /// @brief set priority (execution order) for the client
     void setOrder(int order);
 
@@ -480,6 +486,20 @@ public:
     typedef std::map<std::string, TraCIValues> SubscribedValues;
     typedef std::map<std::string, SubscribedValues> SubscribedContextValues;
 
+    /// @brief The ids and the values (as columns) of all objects of a domain subscription
+    struct DomainValues {
+        DomainValues() : time(-1) {}
+        /// @brief The time the ids were received last
+        SUMOTime time;
+        /// @brief The ids of the objects in the order of the values
+        std::vector<std::string> ids;
+        /// @brief The value type by variable
+        std::map<int, int> types;
+        /// @brief The values of all objects by variable (the components of positions are consecutive)
+        std::map<int, std::vector<double> > values;
+    };
+    typedef std::map<int, DomainValues> SubscribedDomainValues;
+
 
     /** @class SimulationScope
      * @brief Scope for interaction with the simulation
@@ -504,7 +524,16 @@ public:
         libsumo::TraCIBoundary getNetBoundary() const;
         int getMinExpectedNumber() const;
 
+        double getStepProfile(const std::string& phase = "") const;
+
         void subscribe(int domID, const std::string& objID, SUMOTime beginTime, SUMOTime endTime, const std::vector<int>& vars) const;
+        /** @brief Subscribes the variables of the object such that only the changed values are transferred
+         *
+         * The results still contain all values. Unchanged objects are not transferred at all,
+         *  the server sends a response without variables when the subscription ends
+         *  (the object is gone or the end time was reached) and the object is removed from the results.
+         */
+        void subscribeOnChange(int domID, const std::string& objID, SUMOTime beginTime, SUMOTime endTime, const std::vector<int>& vars) const;
         void subscribeContext(int domID, const std::string& objID, SUMOTime beginTime, SUMOTime endTime, int domain, double range, const std::vector<int>& vars) const;
 
         const SubscribedValues getSubscriptionResults() const;
@@ -513,6 +542,17 @@ public:
         const SubscribedContextValues getContextSubscriptionResults() const;
         const SubscribedValues getContextSubscriptionResults(const std::string& objID) const;
 
+        /** @brief Subscribes numeric variables of all objects of a domain
+         * @param[in] domain The get command id of the domain
+         * @param[in] beginTime The begin time step of the subscription
+         * @param[in] endTime The end time step of the subscription
+         * @param[in] vars The variables to subscribe (an empty list removes the subscription)
+         * @param[in] idDelta Whether only the changes of the ids shall be transferred (needs the results of every step)
+         */
+        void subscribeDomain(int domain, SUMOTime beginTime, SUMOTime endTime, const std::vector<int>& vars, bool idDelta = false) const;
+
+        const DomainValues getDomainSubscriptionResults(int domain) const;
+
     private:
         /// @brief invalidated copy constructor
         SimulationScope(const SimulationScope& src);
@@ -904,8 +944,9 @@ protected:
      * @param[in] beginTime The begin time step of subscriptions
      * @param[in] endTime The end time step of subscriptions
      * @param[in] vars The variables to subscribe
+     * @param[in] onChange Whether only the changed values shall be transferred
      */
-    void send_commandSubscribeObjectVariable(int domID, const std::string& objID, SUMOTime beginTime, SUMOTime endTime, const std::vector<int>& vars) const;
+    void send_commandSubscribeObjectVariable(int domID, const std::string& objID, SUMOTime beginTime, SUMOTime endTime, const std::vector<int>& vars, bool onChange = false) const;
 
 
     /** @brief Sends a SubscribeContext request
@@ -919,6 +960,16 @@ protected:
      */
     void send_commandSubscribeObjectContext(int domID, const std::string& objID, SUMOTime beginTime, SUMOTime endTime,
                                             int domain, double range, const std::vector<int>& vars) const;
+
+
+    /** @brief Sends a SubscribeDomain request
+     * @param[in] domain The get command id of the domain
+     * @param[in] beginTime The begin time step of subscriptions
+     * @param[in] endTime The end time step of subscriptions
+     * @param[in] flags Bit 1: transfer only the changes of the ids
+     * @param[in] vars The variables to subscribe
+     */
+    void send_commandSubscribeDomainVariables(int domain, SUMOTime beginTime, SUMOTime endTime, int flags, const std::vector<int>& vars) const;
     /// @}
 
 
@@ -947,6 +998,7 @@ protected:
 
     void readVariableSubscription(tcpip::Storage& inMsg);
     void readContextSubscription(tcpip::Storage& inMsg);
+    void readDomainSubscription(tcpip::Storage& inMsg);
     void readVariables(tcpip::Storage& inMsg, const std::string& objectID, int variableCount, SubscribedValues& into);
 
     template <class T>
@@ -967,6 +1019,9 @@ protected:
 
     SubscribedValues mySubscribedValues;
     SubscribedContextValues mySubscribedContextValues;
+    SubscribedDomainValues mySubscribedDomainValues;
+    /// @brief The last received values of the objects with on-change subscriptions
+    SubscribedValues myOnChangeValues;
 };
 
 
@@ -29,6 +29,12 @@
 
 #include <iostream>
 #include <fstream>
+#include <queue>
+#include <functional>
+#include <utils/common/FileHelpers.h>
+#include <utils/common/StringUtils.h>
+#include <utils/common/SUMOVehicleClass.h>
+#include "SuccessorGraph.h"
 
 #ifdef HAVE_FOX
 #include <utils/foxtools/FXWorkerThread.h>
@@ -62,6 +68,9 @@
 template<class E, class V>
 class AbstractLookupTable {
 public:
+    /// @brief Destructor
+    virtual ~AbstractLookupTable() {}
+
     /// @brief provide a lower bound on the distance between from and to (excluding traveltime of both edges)
     virtual double lowerBound(const E* from, const E* to, double speed, double speedFactor, double fromEffort, double toEffort) const = 0;
 
@@ -101,7 +110,23 @@ private:
 template<class E, class V>
 class LandmarkLookupTable : public AbstractLookupTable<E, V> {
 public:
-    LandmarkLookupTable(const std::string& filename, const std::vector<E*>& edges, SUMOAbstractRouter<E, V>* router, const V* defaultVehicle, const std::string& outfile, const int maxNumThreads) {
+    /** @brief Constructor
+     *
+     * Loads the landmark distances from a text file (one line per landmark followed
+     *  by one line per landmark and edge) or from a binary file as written when the
+     *  output file name ends with ".bin". If no file name is given, the landmarks are
+     *  selected automatically. Missing distances are computed by one Dijkstra search
+     *  per landmark and direction using the efforts of the given router.
+     *
+     * @param[in] filename The file to load the landmarks and their distances from (may be empty)
+     * @param[in] edges All edges of the network
+     * @param[in] router The router whose efforts are used for missing distances (may be 0 if nothing is missing)
+     * @param[in] defaultVehicle The vehicle to compute distances for
+     * @param[in] outfile The file to save the table to (may be empty)
+     * @param[in] maxNumThreads The number of threads to compute the distances in parallel
+     * @param[in] numLandmarks The number of landmarks to select if no file name is given
+     */
+    LandmarkLookupTable(const std::string& filename, const std::vector<E*>& edges, SUMOAbstractRouter<E, V>* router, const V* defaultVehicle, const std::string& outfile, const int maxNumThreads, const int numLandmarks = 0) {
         myFirstNonInternal = -1;
         std::map<std::string, int> numericID;
         for (E* e : edges) {
@@ -112,54 +137,24 @@ public:
                 numericID[e->getID()] = e->getNumericalID() - myFirstNonInternal;
             }
         }
-        std::ifstream strm(filename.c_str());
-        if (!strm.good()) {
-            throw ProcessError("Could not load landmark-lookup-table from '" + filename + "'.");
+        if (filename == "") {
+            selectLandmarks(edges, numLandmarks);
+        } else if (!loadBinary(filename, edges)) {
+            loadText(filename, numericID);
         }
+        const bool binaryOutput = StringUtils::endsWith(outfile, ".bin");
         std::ofstream* ostrm = 0;
-        if (!outfile.empty()) {
-            ostrm = new std::ofstream(outfile.c_str());
-            if (!ostrm->good()) {
-                throw ProcessError("Could not open file '" + outfile + "' for writing.");
-            }
-        }
-        std::string line;
-        int numLandMarks = 0;
-        while (std::getline(strm, line)) {
-            if (line == "") {
-                break;
-            }
-            //std::cout << "'" << line << "'" << "\n";
-            StringTokenizer st(line);
-            if (st.size() == 1) {
-                const std::string lm = st.get(0);
-                myLandmarks[lm] = numLandMarks++;
-                myFromLandmarkDists.push_back(std::vector<double>(0));
-                myToLandmarkDists.push_back(std::vector<double>(0));
-                if (ostrm != 0) {
-                    (*ostrm) << lm << "\n";
-                }
-            } else {
-                assert(st.size() == 4);
-                const std::string lm = st.get(0);
-                const std::string edge = st.get(1);
-                if (numericID[edge] != (int)myFromLandmarkDists[myLandmarks[lm]].size()) {
-                    WRITE_WARNING("Unknown or unordered edge '" + edge + "' in landmark file.");
-                }
-                const double distFrom = TplConvert::_2double(st.get(2).c_str());
-                const double distTo = TplConvert::_2double(st.get(3).c_str());
-                myFromLandmarkDists[myLandmarks[lm]].push_back(distFrom);
-                myToLandmarkDists[myLandmarks[lm]].push_back(distTo);
-            }
+        if (outfile != "" && !binaryOutput) {
+            ostrm = openText(outfile);
         }
         if (myLandmarks.empty()) {
-            WRITE_WARNING("No landmarks in '" + filename + "', falling back to standard A*.");
+            WRITE_WARNING("No landmarks" + (filename == "" ? std::string("") : " in '" + filename + "'") + ", falling back to standard A*.");
             delete ostrm;
             return;
         }
-#ifdef HAVE_FOX
-        FXWorkerThread::Pool threadPool;
-#endif
+        // collect the landmarks with missing distances
+        std::vector<int> incomplete;
+        std::vector<const E*> landmarkEdges;
         for (int i = 0; i < (int)myLandmarks.size(); ++i) {
             if ((int)myFromLandmarkDists[i].size() != (int)edges.size() - myFirstNonInternal) {
                 const std::string landmarkID = getLandmark(i);
@@ -174,109 +169,71 @@ public:
                     WRITE_WARNING("Landmark '" + landmarkID + "' does not exist in the network.");
                     continue;
                 }
-                if (router != 0) {
-                    const std::string missing = outfile.empty() ? filename + ".missing" : outfile;
+                if (router == 0) {
+                    throw ProcessError("Not all network edges were found in the lookup table '" + filename + "' for landmark '" + landmarkID + "'.");
+                }
+                if (filename != "") {
+                    const std::string missing = outfile == "" ? filename + ".missing" : outfile;
                     WRITE_WARNING("Not all network edges were found in the lookup table '" + filename + "' for landmark '" + landmarkID + "'. Saving missing values to '" + missing + "'.");
-                    if (ostrm == 0) {
-                        ostrm = new std::ofstream(missing.c_str());
-                        if (!ostrm->good()) {
-                            throw ProcessError("Could not open file '" + missing + "' for writing.");
-                        }
+                    if (ostrm == 0 && !binaryOutput) {
+                        ostrm = openText(missing);
                     }
-                } else {
-                    throw ProcessError("Not all network edges were found in the lookup table '" + filename + "' for landmark '" + landmarkID + "'.");
                 }
-                std::vector<const E*> routeLM(1, landmark);
-                const double lmCost = router->recomputeCosts(routeLM, defaultVehicle, 0);
-                std::vector<const E*> route;
+                incomplete.push_back(i);
+                landmarkEdges.push_back(landmark);
+            }
+        }
+        // compute the missing distances, one search per landmark and direction
+        std::vector<std::vector<double> > fromDists(incomplete.size());
+        std::vector<std::vector<double> > toDists(incomplete.size());
+        if (!incomplete.empty()) {
+            const SUMOVehicleClass vClass = defaultVehicle == 0 ? SVC_IGNORING : defaultVehicle->getVClass();
+            SuccessorGraph<E> graph(edges);
+            const typename SuccessorGraph<E>::Adjacency& successors = graph.getSuccessors(vClass);
+            const typename SuccessorGraph<E>::Adjacency& predecessors = graph.getPredecessors(vClass);
 #ifdef HAVE_FOX
-                if (maxNumThreads > 0) {
-                    if (threadPool.size() == 0) {
-                        // The CHRouter needs initialization
-                        // before it gets cloned, so we do a dummy routing which is not in parallel
-                        router->compute(landmark, landmark, defaultVehicle, 0, route);
-                        route.clear();
-                        while ((int)threadPool.size() < maxNumThreads) {
-                            new WorkerThread(threadPool, router->clone(), defaultVehicle);
-                        }
-                    }
-                    std::vector<RoutingTask*> currentTasks;
-                    for (int j = (int)myFromLandmarkDists[i].size() + myFirstNonInternal; j < (int)edges.size(); ++j) {
-                        const E* edge = edges[j];
-                        if (landmark != edge) {
-                            std::vector<const E*> routeE(1, edge);
-                            const double sourceDestCost = lmCost + router->recomputeCosts(routeE, defaultVehicle, 0);
-                            // compute from-distance (skip taz-sources and other unreachable edges)
-                            if (edge->getPredecessors().size() > 0 && landmark->getSuccessors().size() > 0) {
-                                currentTasks.push_back(new RoutingTask(landmark, edge, sourceDestCost));
-                                threadPool.add(currentTasks.back());
-                            }
-                            // compute to-distance (skip unreachable landmarks)
-                            if (landmark->getPredecessors().size() > 0 && edge->getSuccessors().size() > 0) {
-                                currentTasks.push_back(new RoutingTask(edge, landmark, sourceDestCost));
-                                threadPool.add(currentTasks.back());
-                            }
-                        }
-                    }
-                    threadPool.waitAll(false);
-                    int taskIndex = 0;
-                    for (int j = (int)myFromLandmarkDists[i].size() + myFirstNonInternal; j < (int)edges.size(); ++j) {
-                        const E* edge = edges[j];
-                        double distFrom = -1;
-                        double distTo = -1;
-                        if (landmark == edge) {
-                            distFrom = 0;
-                            distTo = 0;
-                        } else {
-                            if (edge->getPredecessors().size() > 0 && landmark->getSuccessors().size() > 0) {
-                                distFrom = currentTasks[taskIndex]->getCost();
-                                delete currentTasks[taskIndex++];
-                            }
-                            if (landmark->getPredecessors().size() > 0 && edge->getSuccessors().size() > 0) {
-                                distTo = currentTasks[taskIndex]->getCost();
-                                delete currentTasks[taskIndex++];
-                            }
-                        }
-                        myFromLandmarkDists[i].push_back(distFrom);
-                        myToLandmarkDists[i].push_back(distTo);
-                        (*ostrm) << landmarkID << " " << edge->getID() << " " << distFrom << " " << distTo << "\n";
-                    }
-                    currentTasks.clear();
-                    continue;
+            if (maxNumThreads > 0) {
+                FXWorkerThread::Pool threadPool;
+                while ((int)threadPool.size() < MIN2(maxNumThreads, 2 * (int)incomplete.size())) {
+                    new FXWorkerThread(threadPool);
                 }
+                for (int k = 0; k < (int)incomplete.size(); ++k) {
+                    const int first = (int)myFromLandmarkDists[incomplete[k]].size() + myFirstNonInternal;
+                    threadPool.add(new LandmarkTask(router, defaultVehicle, landmarkEdges[k], edges, successors, first, fromDists[k]));
+                    threadPool.add(new LandmarkTask(router, defaultVehicle, landmarkEdges[k], edges, predecessors, first, toDists[k]));
+                }
+                threadPool.waitAll();
+            } else {
 #endif
-                for (int j = (int)myFromLandmarkDists[i].size() + myFirstNonInternal; j < (int)edges.size(); ++j) {
-                    const E* edge = edges[j];
-                    double distFrom = -1;
-                    double distTo = -1;
-                    if (landmark == edge) {
-                        distFrom = 0;
-                        distTo = 0;
-                    } else {
-                        std::vector<const E*> routeE(1, edge);
-                        const double sourceDestCost = lmCost + router->recomputeCosts(routeE, defaultVehicle, 0);
-                        // compute from-distance (skip taz-sources and other unreachable edges)
-                        if (edge->getPredecessors().size() > 0 && landmark->getSuccessors().size() > 0) {
-                            if (router->compute(landmark, edge, defaultVehicle, 0, route)) {
-                                distFrom = MAX2(0.0, router->recomputeCosts(route, defaultVehicle, 0) - sourceDestCost);
-                                route.clear();
-                            }
-                        }
-                        // compute to-distance (skip unreachable landmarks)
-                        if (landmark->getPredecessors().size() > 0 && edge->getSuccessors().size() > 0) {
-                            if (router->compute(edge, landmark, defaultVehicle, 0, route)) {
-                                distTo = MAX2(0.0, router->recomputeCosts(route, defaultVehicle, 0) - sourceDestCost);
-                                route.clear();
-                            }
-                        }
-                    }
-                    myFromLandmarkDists[i].push_back(distFrom);
-                    myToLandmarkDists[i].push_back(distTo);
-                    (*ostrm) << landmarkID << " " << edge->getID() << " " << distFrom << " " << distTo << "\n";
+                for (int k = 0; k < (int)incomplete.size(); ++k) {
+                    const int first = (int)myFromLandmarkDists[incomplete[k]].size() + myFirstNonInternal;
+                    computeDistances(router, defaultVehicle, landmarkEdges[k], edges, successors, first, fromDists[k]);
+                    computeDistances(router, defaultVehicle, landmarkEdges[k], edges, predecessors, first, toDists[k]);
+                }
+#ifdef HAVE_FOX
+            }
+#else
+            UNUSED_PARAMETER(maxNumThreads);
+#endif
+        }
+        for (int k = 0; k < (int)incomplete.size(); ++k) {
+            const int i = incomplete[k];
+            const std::string landmarkID = getLandmark(i);
+            const int first = (int)myFromLandmarkDists[i].size() + myFirstNonInternal;
+            for (int j = first; j < (int)edges.size(); ++j) {
+                const double distFrom = fromDists[k][j - first];
+                const double distTo = toDists[k][j - first];
+                myFromLandmarkDists[i].push_back(distFrom);
+                myToLandmarkDists[i].push_back(distTo);
+                if (ostrm != 0) {
+                    (*ostrm) << landmarkID << " " << edges[j]->getID() << " " << distFrom << " " << distTo << "\n";
                 }
             }
         }
         delete ostrm;
+        if (binaryOutput) {
+            saveBinary(outfile, edges);
+        }
     }
 
     double lowerBound(const E* from, const E* to, double speed, double speedFactor, double fromEffort, double toEffort) const {
@@ -331,53 +288,278 @@ public:
         return false;
     }
 
+private:
+    /// @brief reads the landmarks and the distances from a text file
+    void loadText(const std::string& filename, std::map<std::string, int>& numericID) {
+        std::ifstream strm(filename.c_str());
+        if (!strm.good()) {
+            throw ProcessError("Could not load landmark-lookup-table from '" + filename + "'.");
+        }
+        std::string line;
+        int numLandMarks = 0;
+        while (std::getline(strm, line)) {
+            if (line == "") {
+                break;
+            }
+            //std::cout << "'" << line << "'" << "\n";
+            StringTokenizer st(line);
+            if (st.size() == 1) {
+                const std::string lm = st.get(0);
+                myLandmarks[lm] = numLandMarks++;
+                myFromLandmarkDists.push_back(std::vector<double>(0));
+                myToLandmarkDists.push_back(std::vector<double>(0));
+            } else {
+                assert(st.size() == 4);
+                const std::string lm = st.get(0);
+                const std::string edge = st.get(1);
+                if (numericID[edge] != (int)myFromLandmarkDists[myLandmarks[lm]].size()) {
+                    WRITE_WARNING("Unknown or unordered edge '" + edge + "' in landmark file.");
+                }
+                const double distFrom = TplConvert::_2double(st.get(2).c_str());
+                const double distTo = TplConvert::_2double(st.get(3).c_str());
+                myFromLandmarkDists[myLandmarks[lm]].push_back(distFrom);
+                myToLandmarkDists[myLandmarks[lm]].push_back(distTo);
+            }
+        }
+    }
+
+    /// @brief opens a text file for the (missing) distances and writes the landmarks
+    std::ofstream* openText(const std::string& filename) const {
+        std::ofstream* const ostrm = new std::ofstream(filename.c_str());
+        if (!ostrm->good()) {
+            delete ostrm;
+            throw ProcessError("Could not open file '" + filename + "' for writing.");
+        }
+        for (int i = 0; i < (int)myLandmarks.size(); ++i) {
+            (*ostrm) << getLandmark(i) << "\n";
+        }
+        return ostrm;
+    }
+
+    /** @brief reads the landmarks and the distances from a binary file
+     * @return false if the file is not a binary landmark file
+     */
+    bool loadBinary(const std::string& filename, const std::vector<E*>& edges) {
+        std::ifstream strm(filename.c_str(), std::ios::binary);
+        if (!strm.good()) {
+            throw ProcessError("Could not load landmark-lookup-table from '" + filename + "'.");
+        }
+        char magic[sizeof(BINARY_MAGIC)];
+        if (!strm.read(magic, sizeof(magic)) || std::string(magic, sizeof(magic)) != std::string(BINARY_MAGIC, sizeof(magic))) {
+            return false;
+        }
+        int byteOrder = 0;
+        int version = 0;
+        int numEdges = 0;
+        long long int checksum = 0;
+        int numLandmarks = 0;
+        strm.read((char*)&byteOrder, sizeof(byteOrder));
+        if (strm.good() && byteOrder != BINARY_BYTE_ORDER) {
+            throw ProcessError("The landmark-lookup-table '" + filename + "' was written on a platform with a different byte order.");
+        }
+        strm.read((char*)&version, sizeof(version));
+        strm.read((char*)&numEdges, sizeof(numEdges));
+        strm.read((char*)&checksum, sizeof(checksum));
+        strm.read((char*)&numLandmarks, sizeof(numLandmarks));
+        if (!strm.good() || version != BINARY_VERSION) {
+            throw ProcessError("Unknown format of landmark-lookup-table '" + filename + "'.");
+        }
+        if (numEdges != (int)edges.size() - myFirstNonInternal || checksum != getChecksum(edges)) {
+            throw ProcessError("The landmark-lookup-table '" + filename + "' does not match the network.");
+        }
+        for (int i = 0; i < numLandmarks && strm.good(); ++i) {
+            int size = 0;
+            strm.read((char*)&size, sizeof(size));
+            std::string lm(MAX2(size, 0), ' ');
+            strm.read(&lm[0], lm.size());
+            myLandmarks[lm] = i;
+            myFromLandmarkDists.push_back(std::vector<double>(numEdges));
+            myToLandmarkDists.push_back(std::vector<double>(numEdges));
+            strm.read((char*)myFromLandmarkDists.back().data(), numEdges * sizeof(double));
+            strm.read((char*)myToLandmarkDists.back().data(), numEdges * sizeof(double));
+        }
+        if (!strm.good()) {
+            throw ProcessError("Could not read landmark-lookup-table from '" + filename + "'.");
+        }
+        return true;
+    }
+
+    /// @brief writes the landmarks with complete distances to a binary file
+    void saveBinary(const std::string& filename, const std::vector<E*>& edges) const {
+        std::ofstream strm(filename.c_str(), std::ios::binary);
+        if (!strm.good()) {
+            throw ProcessError("Could not open file '" + filename + "' for writing.");
+        }
+        const int numEdges = (int)edges.size() - myFirstNonInternal;
+        std::vector<int> complete;
+        for (int i = 0; i < (int)myLandmarks.size(); ++i) {
+            if ((int)myFromLandmarkDists[i].size() == numEdges) {
+                complete.push_back(i);
+            }
+        }
+        const long long int checksum = getChecksum(edges);
+        strm.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        FileHelpers::writeInt(strm, BINARY_BYTE_ORDER);
+        FileHelpers::writeInt(strm, BINARY_VERSION);
+        FileHelpers::writeInt(strm, numEdges);
+        strm.write((const char*)&checksum, sizeof(checksum));
+        FileHelpers::writeInt(strm, (int)complete.size());
+        for (const int i : complete) {
+            FileHelpers::writeString(strm, getLandmark(i));
+            strm.write((const char*)myFromLandmarkDists[i].data(), numEdges * sizeof(double));
+            strm.write((const char*)myToLandmarkDists[i].data(), numEdges * sizeof(double));
+        }
+    }
+
+    /// @brief computes a hash of the ids of all non internal edges (in numerical order)
+    long long int getChecksum(const std::vector<E*>& edges) const {
+        // 64 bit FNV-1a which does not depend on the platform
+        unsigned long long int hash = 14695981039346656037ULL;
+        for (int j = myFirstNonInternal; j < (int)edges.size(); ++j) {
+            const std::string id = edges[j]->getID() + '\n';
+            for (const char c : id) {
+                hash ^= (unsigned char)c;
+                hash *= 1099511628211ULL;
+            }
+        }
+        return (long long int)hash;
+    }
+
+    /** @brief selects the landmarks using the farthest heuristic
+     *
+     * The first landmark is the edge farthest away from an arbitrary edge, every
+     *  following landmark maximizes the (air) distance to the closest landmark chosen
+     *  so far. Only edges with predecessors and successors are considered.
+     */
+    void selectLandmarks(const std::vector<E*>& edges, const int numLandmarks) {
+        std::vector<const E*> candidates;
+        for (int j = myFirstNonInternal; j < (int)edges.size(); ++j) {
+            if (edges[j]->getPredecessors().size() > 0 && edges[j]->getSuccessors().size() > 0) {
+                candidates.push_back(edges[j]);
+            }
+        }
+        if (candidates.empty()) {
+            return;
+        }
+        std::vector<double> minDist(candidates.size(), std::numeric_limits<double>::max());
+        const E* next = candidates.front();
+        for (int i = -1; i < numLandmarks; ++i) {
+            double maxDist = 0.;
+            int best = -1;
+            for (int k = 0; k < (int)candidates.size(); ++k) {
+                minDist[k] = MIN2(minDist[k], candidates[k]->getDistanceTo(next));
+                if (minDist[k] > maxDist) {
+                    maxDist = minDist[k];
+                    best = k;
+                }
+            }
+            if (i == -1) {
+                // the arbitrary start edge is no landmark
+                std::fill(minDist.begin(), minDist.end(), std::numeric_limits<double>::max());
+            }
+            if (best < 0) {
+                break;
+            }
+            next = candidates[best];
+            myLandmarks[next->getID()] = (int)myFromLandmarkDists.size();
+            myFromLandmarkDists.push_back(std::vector<double>(0));
+            myToLandmarkDists.push_back(std::vector<double>(0));
+        }
+    }
+
+    /** @brief computes the distances between the landmark and all edges starting with the given one
+     *
+     * Runs a single one-to-all Dijkstra search from the landmark along the given
+     *  neighbors (the successors for the distances from the landmark, the predecessors
+     *  for the distances to the landmark) using the efforts at time 0. As with the
+     *  routed distances before, the efforts of the landmark and of the edge itself
+     *  are not included. Unreachable edges get -1.
+     */
+    static void computeDistances(const SUMOAbstractRouter<E, V>* router, const V* vehicle, const E* landmark, const std::vector<E*>& edges,
+                                 const typename SuccessorGraph<E>::Adjacency& neighbors, const int first, std::vector<double>& into) {
+        typedef std::pair<double, int> QueueEntry;
+        std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > queue;
+        std::vector<double> efforts(edges.size(), -1.);
+        std::vector<double> dists(edges.size(), std::numeric_limits<double>::max());
+        const int lmID = landmark->getNumericalID();
+        if (!landmark->prohibits(vehicle)) {
+            efforts[lmID] = router->getEffort(landmark, vehicle, 0.);
+            dists[lmID] = efforts[lmID];
+            queue.push(QueueEntry(dists[lmID], lmID));
+        }
+        while (!queue.empty()) {
+            const QueueEntry current = queue.top();
+            queue.pop();
+            if (current.first > dists[current.second]) {
+                // outdated entry
+                continue;
+            }
+            for (typename SuccessorGraph<E>::const_iterator it = neighbors.begin(current.second); it != neighbors.end(current.second); ++it) {
+                const E* const edge = edges[*it];
+                if (efforts[*it] < 0) {
+                    if (edge->prohibits(vehicle)) {
+                        continue;
+                    }
+                    efforts[*it] = router->getEffort(edge, vehicle, 0.);
+                }
+                const double dist = current.first + efforts[*it];
+                if (dist < dists[*it]) {
+                    dists[*it] = dist;
+                    queue.push(QueueEntry(dist, *it));
+                }
+            }
+        }
+        for (int j = first; j < (int)edges.size(); ++j) {
+            if (j == lmID) {
+                into.push_back(0);
+            } else if (dists[j] == std::numeric_limits<double>::max()) {
+                into.push_back(-1);
+            } else {
+                into.push_back(MAX2(0.0, dists[j] - efforts[lmID] - efforts[j]));
+            }
+        }
+    }
+
 private:
     std::map<std::string, int> myLandmarks;
     std::vector<std::vector<double> > myFromLandmarkDists;
     std::vector<std::vector<double> > myToLandmarkDists;
     int myFirstNonInternal;
 
+    /// @brief the start of a binary landmark file (the zero byte never occurs in text files)
+    static const char BINARY_MAGIC[4];
+
+    /** @brief the marker for the byte order of the binary format
+     *
+     * All numbers are written in the native byte order, so a file can only be
+     *  read on platforms with the same byte order which is checked using this value.
+     */
+    static const int BINARY_BYTE_ORDER = 0x01020304;
+
+    /// @brief the version of the binary format
+    static const int BINARY_VERSION = 2;
+
 #ifdef HAVE_FOX
 private:
-    class WorkerThread : public FXWorkerThread {
+    class LandmarkTask : public FXWorkerThread::Task {
     public:
-        WorkerThread(FXWorkerThread::Pool& pool,
-                     SUMOAbstractRouter<E, V>* router, const V* vehicle)
-            : FXWorkerThread(pool), myRouter(router), myVehicle(vehicle) {}
-        virtual ~WorkerThread() {
-            delete myRouter;
-        }
-        double compute(const E* src, const E* dest, const double costOff) {
-            double result = -1.;
-            if (myRouter->compute(src, dest, myVehicle, 0, myRoute)) {
-                result = MAX2(0.0, myRouter->recomputeCosts(myRoute, myVehicle, 0) + costOff);
-                myRoute.clear();
-            }
-            return result;
+        LandmarkTask(const SUMOAbstractRouter<E, V>* router, const V* vehicle, const E* landmark, const std::vector<E*>& edges,
+                     const typename SuccessorGraph<E>::Adjacency& neighbors, const int first, std::vector<double>& into)
+            : myRouter(router), myVehicle(vehicle), myLandmark(landmark), myEdges(edges), myNeighbors(neighbors), myFirst(first), myInto(into) {}
+        void run(FXWorkerThread* /*context*/) {
+            computeDistances(myRouter, myVehicle, myLandmark, myEdges, myNeighbors, myFirst, myInto);
         }
     private:
-        SUMOAbstractRouter<E, V>* myRouter;
-        const V* myVehicle;
-        std::vector<const E*> myRoute;
-    };
-
-    class RoutingTask : public FXWorkerThread::Task {
-    public:
-        RoutingTask(const E* src, const E* dest, const double costOff)
-            : mySrc(src), myDest(dest), myCost(-costOff) {}
-        void run(FXWorkerThread* context) {
-            myCost = ((WorkerThread*)context)->compute(mySrc, myDest, myCost);
-        }
-        double getCost() {
-            return myCost;
-        }
-    private:
-        const E* const mySrc;
-        const E* const myDest;
-        double myCost;
+        const SUMOAbstractRouter<E, V>* const myRouter;
+        const V* const myVehicle;
+        const E* const myLandmark;
+        const std::vector<E*>& myEdges;
+        const typename SuccessorGraph<E>::Adjacency& myNeighbors;
+        const int myFirst;
+        std::vector<double>& myInto;
     private:
         /// @brief Invalidated assignment operator.
-        RoutingTask& operator=(const RoutingTask&);
+        LandmarkTask& operator=(const LandmarkTask&);
     };
 
 
@@ -396,6 +578,10 @@ private:
 };
 
 
+template<class E, class V>
+const char LandmarkLookupTable<E, V>::BINARY_MAGIC[4] = {'\0', 'L', 'M', 'T'};
+
+
 
 
 #endif
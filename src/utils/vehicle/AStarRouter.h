@@ -45,10 +45,12 @@
 #include <utils/common/TplConvert.h>
 #include <utils/common/StdDefs.h>
 #include <utils/common/ToString.h>
+#include <utils/common/IndexedHeap.h>
 #include <utils/iodevices/BinaryInputDevice.h>
 #include <utils/iodevices/OutputDevice.h>
 #include "AStarLookupTable.h"
 #include "SUMOAbstractRouter.h"
+#include "SuccessorGraph.h"
 
 #define UNREACHABLE (std::numeric_limits<double>::max() / 1000.0)
 
@@ -102,7 +104,8 @@ public:
             traveltime(std::numeric_limits<double>::max()),
             heuristicTime(std::numeric_limits<double>::max()),
             prev(0),
-            visited(false) {
+            visited(false),
+            heapIndex(-1) {
         }
 
         /// The current edge
@@ -120,6 +123,9 @@ public:
         /// The previous edge
         bool visited;
 
+        /// The position in the frontier (-1 if not in the frontier)
+        int heapIndex;
+
         inline void reset() {
             // heuristicTime is set before adding to the frontier, thus no reset is needed
             traveltime = std::numeric_limits<double>::max();
@@ -143,39 +149,32 @@ public:
         }
     };
 
+    /// @brief The min edge heap
+    typedef IndexedHeap<EdgeInfo, EdgeInfoComparator> Frontier;
+
     /// Constructor
     AStarRouter(const std::vector<E*>& edges, bool unbuildIsWarning, Operation operation, const LookupTable* const lookup = 0):
         SUMOAbstractRouter<E, V>(operation, "AStarRouter"),
         myErrorMsgHandler(unbuildIsWarning ? MsgHandler::getWarningInstance() : MsgHandler::getErrorInstance()),
         myLookupTable(lookup),
-        myMaxSpeed(NUMERICAL_EPS) {
+        myMaxSpeed(NUMERICAL_EPS),
+        myGraph(edges) {
         for (typename std::vector<E*>::const_iterator i = edges.begin(); i != edges.end(); ++i) {
             myEdgeInfos.push_back(EdgeInfo(*i));
             myMaxSpeed = MAX2(myMaxSpeed, (*i)->getSpeedLimit() * MAX2(1.0, (*i)->getLengthGeometryFactor()));
         }
     }
 
-    AStarRouter(const std::vector<EdgeInfo>& edgeInfos, bool unbuildIsWarning, Operation operation, const LookupTable* const lookup = 0):
-        SUMOAbstractRouter<E, V>(operation, "AStarRouter"),
-        myErrorMsgHandler(unbuildIsWarning ? MsgHandler::getWarningInstance() : MsgHandler::getErrorInstance()),
-        myLookupTable(lookup),
-        myMaxSpeed(NUMERICAL_EPS) {
-        for (typename std::vector<EdgeInfo>::const_iterator i = edgeInfos.begin(); i != edgeInfos.end(); ++i) {
-            myEdgeInfos.push_back(EdgeInfo(i->edge));
-            myMaxSpeed = MAX2(myMaxSpeed, i->edge->getSpeedLimit() * i->edge->getLengthGeometryFactor());
-        }
-    }
-
     /// Destructor
     virtual ~AStarRouter() {}
 
     virtual SUMOAbstractRouter<E, V>* clone() {
-        return new AStarRouter<E, V, PF>(myEdgeInfos, myErrorMsgHandler == MsgHandler::getWarningInstance(), this->myOperation, myLookupTable);
+        return new AStarRouter<E, V, PF>(myGraph.getEdges(), myErrorMsgHandler == MsgHandler::getWarningInstance(), this->myOperation, myLookupTable);
     }
 
     void init() {
         // all EdgeInfos touched in the previous query are either in myFrontierList or myFound: clean those up
-        for (typename std::vector<EdgeInfo*>::iterator i = myFrontierList.begin(); i != myFrontierList.end(); i++) {
+        for (typename Frontier::const_iterator i = myFrontierList.begin(); i != myFrontierList.end(); i++) {
             (*i)->reset();
         }
         myFrontierList.clear();
@@ -205,6 +204,8 @@ public:
 #endif
         const SUMOVehicleClass vClass = vehicle == 0 ? SVC_IGNORING : vehicle->getVClass();
         const double time = STEPS2TIME(msTime);
+        myGraph.update();
+        const typename Graph::Adjacency& successors = myGraph.getSuccessors(vClass);
         if (this->myBulkMode) {
             const EdgeInfo& toInfo = myEdgeInfos[to->getNumericalID()];
             if (toInfo.visited) {
@@ -218,7 +219,7 @@ public:
             EdgeInfo* const fromInfo = &(myEdgeInfos[from->getNumericalID()]);
             fromInfo->traveltime = 0;
             fromInfo->prev = 0;
-            myFrontierList.push_back(fromInfo);
+            myFrontierList.push(fromInfo);
         }
         // loop
         int num_visited = 0;
@@ -249,8 +250,7 @@ public:
 #endif
                 return true;
             }
-            pop_heap(myFrontierList.begin(), myFrontierList.end(), myComparator);
-            myFrontierList.pop_back();
+            myFrontierList.pop();
             myFound.push_back(minimumInfo);
             minimumInfo->visited = true;
 #ifdef ASTAR_DEBUG_QUERY
@@ -259,7 +259,7 @@ public:
                       << " EF=" << this->getEffort(minEdge, vehicle, time + minimumInfo->traveltime)
                       << " HT=" << minimumInfo->heuristicTime
                       << " Q(TT,HT,Edge)=";
-            for (typename std::vector<EdgeInfo*>::iterator it = myFrontierList.begin(); it != myFrontierList.end(); it++) {
+            for (typename Frontier::const_iterator it = myFrontierList.begin(); it != myFrontierList.end(); it++) {
                 std::cout << (*it)->traveltime << "," << (*it)->heuristicTime << "," << (*it)->edge->getID() << " ";
             }
             std::cout << "\n";
@@ -272,12 +272,10 @@ public:
                 continue;
             }
             // check all ways from the node with the minimal length
-            const std::vector<E*>& successors = minEdge->getSuccessors(vClass);
-            for (typename std::vector<E*>::const_iterator it = successors.begin(); it != successors.end(); ++it) {
-                const E* const follower = *it;
-                EdgeInfo* const followerInfo = &(myEdgeInfos[follower->getNumericalID()]);
+            for (typename Graph::const_iterator it = successors.begin(minEdge->getNumericalID()); it != successors.end(minEdge->getNumericalID()); ++it) {
+                EdgeInfo* const followerInfo = &(myEdgeInfos[*it]);
                 // check whether it can be used
-                if (PF::operator()(follower, vehicle)) {
+                if (PF::operator()(followerInfo->edge, vehicle)) {
                     continue;
                 }
                 const double oldEffort = followerInfo->traveltime;
@@ -299,19 +297,9 @@ public:
                     std::cout << "   follower=" << followerInfo->edge->getID() << " OEF=" << oldEffort << " TT=" << traveltime << " HR=" << heuristic_remaining << " HT=" << followerInfo->heuristicTime << "\n";
 #endif
                     followerInfo->prev = minimumInfo;
-                    if (oldEffort == std::numeric_limits<double>::max()) {
-                        myFrontierList.push_back(followerInfo);
-                        push_heap(myFrontierList.begin(), myFrontierList.end(), myComparator);
-                    } else {
-                        typename std::vector<EdgeInfo*>::iterator fi = find(myFrontierList.begin(), myFrontierList.end(), followerInfo);
-                        if (fi == myFrontierList.end()) {
-                            assert(mayRevisit);
-                            myFrontierList.push_back(followerInfo);
-                            push_heap(myFrontierList.begin(), myFrontierList.end(), myComparator);
-                        } else {
-                            push_heap(myFrontierList.begin(), fi + 1, myComparator);
-                        }
-                    }
+                    // an edge which is not in the frontier any more can only be reached again with an inconsistent heuristic
+                    assert(oldEffort == std::numeric_limits<double>::max() || myFrontierList.contains(followerInfo) || mayRevisit);
+                    myFrontierList.update(followerInfo);
                 }
             }
         }
@@ -352,12 +340,10 @@ protected:
     std::vector<EdgeInfo> myEdgeInfos;
 
     /// A container for reusage of the min edge heap
-    std::vector<EdgeInfo*> myFrontierList;
+    Frontier myFrontierList;
     /// @brief list of visited Edges (for resetting)
     std::vector<EdgeInfo*> myFound;
 
-    EdgeInfoComparator myComparator;
-
     /// @brief the handler for routing errors
     MsgHandler* const myErrorMsgHandler;
 
@@ -366,6 +352,12 @@ protected:
 
     /// @brief maximum speed in the network
     double myMaxSpeed;
+
+    /// @brief The compact successor graph
+    typedef SuccessorGraph<E> Graph;
+
+    /// @brief The successors of all edges by vehicle class
+    Graph myGraph;
 };
 
 
@@ -0,0 +1,338 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    BidirectionalDijkstraRouter.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// Bidirectional Dijkstra shortest path algorithm for time independent weights
+/****************************************************************************/
+#ifndef BidirectionalDijkstraRouter_h
+#define BidirectionalDijkstraRouter_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cassert>
+#include <string>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <iterator>
+#include <utils/common/ToString.h>
+#include <utils/common/MsgHandler.h>
+#include <utils/common/StdDefs.h>
+#include <utils/common/IndexedHeap.h>
+#include "SUMOAbstractRouter.h"
+#include "SuccessorGraph.h"
+
+//#define BidirectionalDijkstraRouter_DEBUG_QUERY_PERF
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class BidirectionalDijkstraRouter
+ * @brief Computes the shortest path through a network using a forward search from
+ *  the origin and a backward search from the destination at the same time.
+ *
+ * The template parameters are:
+ * @param E The edge class to use (MSEdge/ROEdge)
+ * @param V The vehicle class to use (MSVehicle/ROVehicle)
+ * @param PF The prohibition function to use (prohibited_withPermissions/noProhibitions)
+ *
+ * The backward search cannot know the time at which an edge is reached, so all
+ *  efforts are retrieved for the departure time. This makes the router suitable
+ *  for weights which do not change during a trip only. The search stops as soon as
+ *  the two frontiers together cannot improve the best meeting found so far which
+ *  usually happens after exploring a fraction of the edges the Dijkstra needs.
+ */
+template<class E, class V, class PF>
+class BidirectionalDijkstraRouter : public SUMOAbstractRouter<E, V>, public PF {
+
+public:
+    typedef double(* Operation)(const E* const, const V* const, double);
+
+    /**
+     * @class EdgeInfo
+     * The effort needed to reach the edge (forward) or the destination (backward)
+     *  together with the neighbor on the best path
+     */
+    class EdgeInfo {
+    public:
+        /// Constructor
+        EdgeInfo(const E* const e)
+            : edge(e), effort(std::numeric_limits<double>::max()), prev(0), visited(false), heapIndex(-1) {}
+
+        /// The current edge
+        const E* const edge;
+
+        /// Effort to reach the edge (forward) or the destination (backward)
+        double effort;
+
+        /// The previous edge (forward) or the next edge (backward)
+        EdgeInfo* prev;
+
+        /// Whether the effort is final
+        bool visited;
+
+        /// The position in the frontier (-1 if not in the frontier)
+        int heapIndex;
+
+        inline void reset() {
+            effort = std::numeric_limits<double>::max();
+            visited = false;
+        }
+
+    private:
+        /// @brief Invalidated assignment operator
+        EdgeInfo& operator=(const EdgeInfo& s) = delete;
+
+    };
+
+    /**
+     * @class EdgeInfoByEffortComparator
+     * Class to compare (and so sort) nodes by their effort
+     */
+    class EdgeInfoByEffortComparator {
+    public:
+        /// Comparing method
+        bool operator()(const EdgeInfo* nod1, const EdgeInfo* nod2) const {
+            if (nod1->effort == nod2->effort) {
+                return nod1->edge->getNumericalID() > nod2->edge->getNumericalID();
+            }
+            return nod1->effort > nod2->effort;
+        }
+    };
+
+    /// @brief The min edge heap
+    typedef IndexedHeap<EdgeInfo, EdgeInfoByEffortComparator> Frontier;
+
+
+    /// Constructor
+    BidirectionalDijkstraRouter(const std::vector<E*>& edges, bool unbuildIsWarning, Operation effortOperation) :
+        SUMOAbstractRouter<E, V>(effortOperation, "BidirectionalDijkstraRouter"),
+        myForward(edges), myBackward(edges), myGraph(edges),
+        myErrorMsgHandler(unbuildIsWarning ?  MsgHandler::getWarningInstance() : MsgHandler::getErrorInstance()) {
+    }
+
+    /// Destructor
+    virtual ~BidirectionalDijkstraRouter() { }
+
+    virtual SUMOAbstractRouter<E, V>* clone() {
+        return new BidirectionalDijkstraRouter<E, V, PF>(myGraph.getEdges(), myErrorMsgHandler == MsgHandler::getWarningInstance(), this->myOperation);
+    }
+
+
+    /** @brief Builds the route between the given edges using the minimum effort at the given time
+     *
+     * The bulk mode is ignored because the backward search depends on the destination.
+     */
+    virtual bool compute(const E* from, const E* to, const V* const vehicle,
+                         SUMOTime msTime, std::vector<const E*>& into) {
+        assert(from != 0 && to != 0);
+        // check whether from and to can be used
+        if (PF::operator()(from, vehicle)) {
+            myErrorMsgHandler->inform("Vehicle '" + vehicle->getID() + "' is not allowed on source edge '" + from->getID() + "'.");
+            return false;
+        }
+        if (PF::operator()(to, vehicle)) {
+            myErrorMsgHandler->inform("Vehicle '" + vehicle->getID() + "' is not allowed on destination edge '" + to->getID() + "'.");
+            return false;
+        }
+        this->startQuery();
+        if (from == to) {
+            into.push_back(from);
+            this->endQuery(1);
+            return true;
+        }
+        const SUMOVehicleClass vClass = vehicle == 0 ? SVC_IGNORING : vehicle->getVClass();
+        const double time = STEPS2TIME(msTime);
+        myGraph.update();
+        const typename Graph::Adjacency& successors = myGraph.getSuccessors(vClass);
+        const typename Graph::Adjacency& predecessors = myGraph.getPredecessors(vClass);
+        myForward.init(from);
+        myBackward.init(to);
+        // the best path found so far passes the meeting edge
+        double minEffort = std::numeric_limits<double>::max();
+        const E* meeting = 0;
+        int num_visited = 0;
+        while (!myForward.frontier.empty() && !myBackward.frontier.empty()) {
+            if (myForward.frontier.front()->effort + myBackward.frontier.front()->effort >= minEffort) {
+                break;
+            }
+            num_visited += 1;
+            // expand the smaller frontier
+            if (myForward.frontier.size() <= myBackward.frontier.size()) {
+                EdgeInfo* const minimumInfo = myForward.settle();
+                const E* const minEdge = minimumInfo->edge;
+                const double effort = minimumInfo->effort + this->getEffort(minEdge, vehicle, time);
+                for (typename Graph::const_iterator it = successors.begin(minEdge->getNumericalID()); it != successors.end(minEdge->getNumericalID()); ++it) {
+                    const E* const follower = myForward.edgeInfos[*it].edge;
+                    if (PF::operator()(follower, vehicle)) {
+                        continue;
+                    }
+                    if (myForward.relax(follower, effort, minimumInfo)) {
+                        const EdgeInfo& otherInfo = myBackward.getEdgeInfo(follower);
+                        if (otherInfo.effort != std::numeric_limits<double>::max() && effort + otherInfo.effort < minEffort) {
+                            minEffort = effort + otherInfo.effort;
+                            meeting = follower;
+                        }
+                    }
+                }
+            } else {
+                EdgeInfo* const minimumInfo = myBackward.settle();
+                const E* const minEdge = minimumInfo->edge;
+                for (typename Graph::const_iterator it = predecessors.begin(minEdge->getNumericalID()); it != predecessors.end(minEdge->getNumericalID()); ++it) {
+                    const E* const pred = myBackward.edgeInfos[*it].edge;
+                    if (PF::operator()(pred, vehicle)) {
+                        continue;
+                    }
+                    const double effort = minimumInfo->effort + this->getEffort(pred, vehicle, time);
+                    if (myBackward.relax(pred, effort, minimumInfo)) {
+                        const EdgeInfo& otherInfo = myForward.getEdgeInfo(pred);
+                        if (otherInfo.effort != std::numeric_limits<double>::max() && effort + otherInfo.effort < minEffort) {
+                            minEffort = effort + otherInfo.effort;
+                            meeting = pred;
+                        }
+                    }
+                }
+            }
+        }
+        this->endQuery(num_visited);
+#ifdef BidirectionalDijkstraRouter_DEBUG_QUERY_PERF
+        std::cout << "visited " + toString(num_visited) + " edges (" + (meeting == 0 ? "unsuccessful" : "successful") + ")\n";
+#endif
+        if (meeting == 0) {
+            myErrorMsgHandler->inform("No connection between edge '" + from->getID() + "' and edge '" + to->getID() + "' found.");
+            return false;
+        }
+        buildPathFrom(meeting, into);
+        return true;
+    }
+
+
+    double recomputeCosts(const std::vector<const E*>& edges, const V* const v, SUMOTime msTime) const {
+        double costs = 0;
+        double t = STEPS2TIME(msTime);
+        for (const E* const e : edges) {
+            if (PF::operator()(e, v)) {
+                return -1;
+            }
+            const double effortDelta = this->getEffort(e, v, t);
+            costs += effortDelta;
+            t += effortDelta;
+        }
+        return costs;
+    }
+
+
+private:
+    /// @brief the state of the search in one direction
+    struct Search {
+        Search(const std::vector<E*>& edges) {
+            for (typename std::vector<E*>::const_iterator i = edges.begin(); i != edges.end(); ++i) {
+                edgeInfos.push_back(EdgeInfo(*i));
+            }
+        }
+
+        inline EdgeInfo& getEdgeInfo(const E* const edge) {
+            return edgeInfos[edge->getNumericalID()];
+        }
+
+        /// @brief cleans up the previous query and adds the start edge
+        void init(const E* const start) {
+            // all EdgeInfos touched in the previous query are either in the frontier or found: clean those up
+            for (typename Frontier::const_iterator i = frontier.begin(); i != frontier.end(); i++) {
+                (*i)->reset();
+            }
+            frontier.clear();
+            for (EdgeInfo* const info : found) {
+                info->reset();
+            }
+            found.clear();
+            EdgeInfo* const startInfo = &getEdgeInfo(start);
+            startInfo->effort = 0;
+            startInfo->prev = 0;
+            frontier.push(startInfo);
+        }
+
+        /// @brief removes the edge with the minimal effort from the frontier and marks it as visited
+        EdgeInfo* settle() {
+            EdgeInfo* const minimumInfo = frontier.front();
+            frontier.pop();
+            found.push_back(minimumInfo);
+            minimumInfo->visited = true;
+            return minimumInfo;
+        }
+
+        /// @brief updates the effort of the given edge and reports whether it improved
+        bool relax(const E* const edge, const double effort, EdgeInfo* const prev) {
+            EdgeInfo* const info = &getEdgeInfo(edge);
+            if (info->visited || effort >= info->effort) {
+                return false;
+            }
+            info->effort = effort;
+            info->prev = prev;
+            frontier.update(info);
+            return true;
+        }
+
+        /// The container of edge information
+        std::vector<EdgeInfo> edgeInfos;
+        /// A container for reusage of the min edge heap
+        Frontier frontier;
+        /// @brief list of visited Edges (for resetting)
+        std::vector<EdgeInfo*> found;
+    };
+
+
+    /// @brief Builds the path through the given meeting edge
+    void buildPathFrom(const E* const meeting, std::vector<const E*>& edges) {
+        std::vector<const E*> tmp;
+        for (const EdgeInfo* info = &myForward.getEdgeInfo(meeting); info != 0; info = info->prev) {
+            tmp.push_back(info->edge);
+        }
+        std::copy(tmp.rbegin(), tmp.rend(), std::back_inserter(edges));
+        for (const EdgeInfo* info = myBackward.getEdgeInfo(meeting).prev; info != 0; info = info->prev) {
+            edges.push_back(info->edge);
+        }
+    }
+
+
+private:
+    /// @brief the search from the origin
+    Search myForward;
+
+    /// @brief the search from the destination
+    Search myBackward;
+
+    /// @brief The compact successor graph
+    typedef SuccessorGraph<E> Graph;
+
+    /// @brief The successors and predecessors of all edges by vehicle class
+    Graph myGraph;
+
+    /// @brief the handler for routing errors
+    MsgHandler* const myErrorMsgHandler;
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -42,6 +42,10 @@
 #include <utils/vehicle/SUMOAbstractRouter.h>
 #include "SPTree.h"
 
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXWorkerThread.h>
+#endif
+
 //#define CHRouter_DEBUG_CONTRACTION
 //#define CHRouter_DEBUG_CONTRACTION_WITNESSES
 //#define CHRouter_DEBUG_CONTRACTION_QUEUE
@@ -74,10 +78,12 @@ public:
     // backward connections are used only in backwards search
     class Connection {
     public:
-        Connection(int t, double c, SVCPermissions p): target(t), cost(c), permissions(p) {}
+        Connection(int t, double c, SVCPermissions p, const E* v = 0): target(t), cost(c), permissions(p), via(v) {}
         int target;
         double cost;
         SVCPermissions permissions;
+        /// @brief the edge a shortcut passes (only set in customized hierarchies)
+        const E* via;
     };
 
     typedef std::pair<const E*, const E*> ConstEdgePair;
@@ -88,6 +94,34 @@ public:
         std::vector<std::vector<Connection> > backwardUplinks;
     };
 
+    /// @brief A pair of arcs (given by their indices) passing a lower ranked edge
+    struct Triangle {
+        Triangle(int f, int s, int v): first(f), second(s), via(v) {}
+        int first;
+        int second;
+        int via;
+    };
+
+    /** @brief The metric independent part of a customizable hierarchy
+     *
+     * The edges are contracted without witness searches, so the topology contains
+     *  every shortcut which may be needed for any edge weights. Each arc leads
+     *  from or to a higher ranked edge and knows its lower triangles, which is all
+     *  that is needed to compute the arc costs for new edge weights.
+     */
+    struct Topology {
+        /// @brief the (forward) start and end of each arc
+        std::vector<std::pair<int, int> > arcs;
+        /// @brief the lower triangles of each arc
+        std::vector<std::vector<Triangle> > triangles;
+        /// @brief the arcs leading to higher ranked followers of each edge
+        std::vector<std::vector<int> > forwardArcs;
+        /// @brief the arcs coming from higher ranked predecessors of each edge
+        std::vector<std::vector<int> > backwardArcs;
+        /// @brief the arcs grouped by the level of their lower end, arcs of one level do not depend on each other
+        std::vector<std::vector<int> > levels;
+    };
+
     /** @brief Constructor
      * @param[in] validatePermissions Whether a multi-permission hierarchy shall be built
      *            If set to false, the net is pruned in synchronize() and the
@@ -199,6 +233,172 @@ public:
         return result;
     }
 
+
+    /** @brief Contracts the network without using edge weights
+     *
+     * The contraction order only depends on the network structure, so the result
+     *  can be reused for all weights (and vehicle classes) by calling customize.
+     */
+    const Topology* buildTopology() {
+        Topology* result = new Topology();
+        const int numEdges = (int)myCHInfos.size();
+        PROGRESS_BEGIN_MESSAGE("Building customizable Contraction Hierarchy (" + toString(numEdges) + " edges)\n");
+        const long startMillis = SysUtils::getCurrentMillis();
+        std::vector<CHInfo*> queue; // max heap: edge to be contracted is front
+        for (int i = 0; i < numEdges; i++) {
+            myCHInfos[i].resetContractionState();
+        }
+        for (int i = 0; i < numEdges; i++) {
+            synchronizeTopology(myCHInfos[i]);
+        }
+        for (int i = 0; i < numEdges; i++) {
+            myCHInfos[i].updateMetricIndependentPriority();
+            queue.push_back(&(myCHInfos[i]));
+        }
+        make_heap(queue.begin(), queue.end(), myCmp);
+        result->forwardArcs.resize(numEdges);
+        result->backwardArcs.resize(numEdges);
+        std::vector<int> byRank;
+        // contraction loop
+        while (!queue.empty()) {
+            while (tryUpdateFront(queue, false)) {}
+            CHInfo* max = queue.front();
+            max->rank = (int)byRank.size();
+            const int edgeID = max->edge->getNumericalID();
+            byRank.push_back(edgeID);
+            for (typename CHConnections::const_iterator it = max->followers.begin(); it != max->followers.end(); it++) {
+                result->forwardArcs[edgeID].push_back((int)result->arcs.size());
+                result->arcs.push_back(std::make_pair(edgeID, it->target->edge->getNumericalID()));
+                disconnect(it->target->approaching, max);
+                it->target->updatePriority(0);
+            }
+            for (typename CHConnections::const_iterator it = max->approaching.begin(); it != max->approaching.end(); it++) {
+                result->backwardArcs[edgeID].push_back((int)result->arcs.size());
+                result->arcs.push_back(std::make_pair(it->target->edge->getNumericalID(), edgeID));
+                disconnect(it->target->followers, max);
+                it->target->updatePriority(0);
+            }
+            for (typename std::vector<Shortcut>::const_iterator it = max->shortcuts.begin(); it != max->shortcuts.end(); it++) {
+                CHInfo* from = getCHInfo(it->edgePair.first);
+                CHInfo* to = getCHInfo(it->edgePair.second);
+                from->followers.push_back(CHConnection(to, 0., SVCAll, it->underlying));
+                to->approaching.push_back(CHConnection(from, 0., SVCAll, it->underlying));
+            }
+            pop_heap(queue.begin(), queue.end(), myCmp);
+            queue.pop_back();
+        }
+        // all arcs between the higher neighbors of an edge exist, so every such pair forms a lower triangle
+        result->triangles.resize(result->arcs.size());
+        for (int i = 0; i < numEdges; i++) {
+            for (std::vector<int>::const_iterator b = result->backwardArcs[i].begin(); b != result->backwardArcs[i].end(); ++b) {
+                for (std::vector<int>::const_iterator f = result->forwardArcs[i].begin(); f != result->forwardArcs[i].end(); ++f) {
+                    const int from = result->arcs[*b].first;
+                    const int to = result->arcs[*f].second;
+                    if (from != to) {
+                        result->triangles[findArc(*result, from, to)].push_back(Triangle(*b, *f, i));
+                    }
+                }
+            }
+        }
+        // the level of an edge exceeds the levels of all its lower neighbors
+        std::vector<int> level(numEdges, 0);
+        for (std::vector<int>::const_iterator e = byRank.begin(); e != byRank.end(); ++e) {
+            for (std::vector<int>::const_iterator f = result->forwardArcs[*e].begin(); f != result->forwardArcs[*e].end(); ++f) {
+                level[result->arcs[*f].second] = MAX2(level[result->arcs[*f].second], level[*e] + 1);
+            }
+            for (std::vector<int>::const_iterator b = result->backwardArcs[*e].begin(); b != result->backwardArcs[*e].end(); ++b) {
+                level[result->arcs[*b].first] = MAX2(level[result->arcs[*b].first], level[*e] + 1);
+            }
+            if (level[*e] >= (int)result->levels.size()) {
+                result->levels.resize(level[*e] + 1);
+            }
+            std::vector<int>& arcs = result->levels[level[*e]];
+            arcs.insert(arcs.end(), result->forwardArcs[*e].begin(), result->forwardArcs[*e].end());
+            arcs.insert(arcs.end(), result->backwardArcs[*e].begin(), result->backwardArcs[*e].end());
+        }
+        const long duration = SysUtils::getCurrentMillis() - startMillis;
+        WRITE_MESSAGE("Created " + toString(result->arcs.size()) + " arcs in " + toString(result->levels.size()) + " levels.");
+        MsgHandler::getMessageInstance()->endProcessMsg("done (" + toString(duration) + "ms).");
+        PROGRESS_DONE_MESSAGE();
+        myUpdateCount = 0;
+        return result;
+    }
+
+
+    /** @brief Computes the arc costs of a customizable hierarchy for the current edge weights
+     *
+     * The original connections get the effort of their start edge, then each arc
+     *  gets the cost of its cheapest lower triangle if that is cheaper. The levels
+     *  are processed bottom up, the arcs within one level in parallel. Arcs which
+     *  cannot be used by the vehicle class are left out. The threads are kept
+     *  by the builder for the next customization.
+     */
+    Hierarchy* customize(const Topology& topology, SUMOTime time, const V* const vehicle,
+                         const SUMOAbstractRouter<E, V>* effortProvider, const int numThreads) {
+        const int numEdges = (int)myEdges.size();
+        const SUMOVehicleClass svc = vehicle->getVClass();
+        PROGRESS_BEGIN_MESSAGE("Customizing Contraction Hierarchy for vClass='" + SumoVehicleClassStrings.getString(svc)
+                               + "' and time=" + time2string(time));
+        const long startMillis = SysUtils::getCurrentMillis();
+        std::vector<double> costs(topology.arcs.size(), std::numeric_limits<double>::max());
+        std::vector<int> vias(topology.arcs.size(), -1);
+        const double time_seconds = STEPS2TIME(time); // timelines store seconds!
+        for (int i = 0; i < numEdges; i++) {
+            const E* const edge = myEdges[i];
+            if ((edge->getPermissions() & svc) != svc) {
+                continue;
+            }
+            const double cost = effortProvider->getEffort(edge, vehicle, time_seconds);
+            const std::vector<E*>& successors = edge->getSuccessors(svc);
+            for (typename std::vector<E*>::const_iterator it = successors.begin(); it != successors.end(); ++it) {
+                if (((*it)->getPermissions() & svc) == svc && *it != edge) {
+                    costs[findArc(topology, i, (*it)->getNumericalID())] = cost;
+                }
+            }
+        }
+#ifdef HAVE_FOX
+        while (myThreadPool.size() < numThreads) {
+            new FXWorkerThread(myThreadPool);
+        }
+#else
+        UNUSED_PARAMETER(numThreads);
+#endif
+        for (typename std::vector<std::vector<int> >::const_iterator level = topology.levels.begin(); level != topology.levels.end(); ++level) {
+            const int numArcs = (int)level->size();
+#ifdef HAVE_FOX
+            if (myThreadPool.size() > 1 && numArcs >= 16 * myThreadPool.size()) {
+                const int chunk = numArcs / myThreadPool.size() + 1;
+                for (int begin = 0; begin < numArcs; begin += chunk) {
+                    myThreadPool.add(new CustomizationTask(topology, *level, begin, MIN2(begin + chunk, numArcs), costs, vias));
+                }
+                myThreadPool.waitAll();
+                continue;
+            }
+#endif
+            customizeArcs(topology, *level, 0, numArcs, costs, vias);
+        }
+        Hierarchy* result = new Hierarchy();
+        result->forwardUplinks.resize(numEdges);
+        result->backwardUplinks.resize(numEdges);
+        for (int i = 0; i < numEdges; i++) {
+            for (std::vector<int>::const_iterator f = topology.forwardArcs[i].begin(); f != topology.forwardArcs[i].end(); ++f) {
+                if (costs[*f] < std::numeric_limits<double>::max()) {
+                    result->forwardUplinks[i].push_back(Connection(topology.arcs[*f].second, costs[*f], SVCAll,
+                                                        vias[*f] < 0 ? 0 : myEdges[vias[*f]]));
+                }
+            }
+            for (std::vector<int>::const_iterator b = topology.backwardArcs[i].begin(); b != topology.backwardArcs[i].end(); ++b) {
+                if (costs[*b] < std::numeric_limits<double>::max()) {
+                    result->backwardUplinks[i].push_back(Connection(topology.arcs[*b].first, costs[*b], SVCAll,
+                                                         vias[*b] < 0 ? 0 : myEdges[vias[*b]]));
+                }
+            }
+        }
+        const long duration = SysUtils::getCurrentMillis() - startMillis;
+        MsgHandler::getMessageInstance()->endProcessMsg(" done (" + toString(duration) + "ms).");
+        return result;
+    }
+
 private:
     struct Shortcut {
         Shortcut(ConstEdgePair e, double c, int u, SVCPermissions p):
@@ -236,12 +436,16 @@ private:
         /// @brief Constructor
         CHInfo(const E* e) :
             edge(e),
+            priority(0.),
             contractedNeighbors(0),
             rank(-1),
             level(0),
             underlyingTotal(0),
             visited(false),
-            traveltime(std::numeric_limits<double>::max()) {
+            traveltime(std::numeric_limits<double>::max()),
+            depth(0),
+            permissions(SVCAll),
+            heapIndex(-1) {
         }
 
         /// @brief recompute the contraction priority and report whether it changed
@@ -252,6 +456,18 @@ private:
             } else {
                 contractedNeighbors += 1; // called when a connected edge was contracted
             }
+            return computePriority();
+        }
+
+        /// @brief recompute the contraction priority assuming all paths via this edge need a shortcut
+        bool updateMetricIndependentPriority() {
+            updateAllShortcuts();
+            updateLevel();
+            return computePriority();
+        }
+
+        /// @brief compute the priority from the current terms and report whether it changed
+        bool computePriority() {
             const double oldPriority = priority;
             // priority term as used by abraham []
             const int edge_difference = (int)followers.size() + (int)approaching.size() - 2 * (int)shortcuts.size();
@@ -319,6 +535,32 @@ private:
         }
 
 
+        /// compute the shortcuts for all pairs of neighbors which are not connected yet (no witness search)
+        void updateAllShortcuts() {
+            shortcuts.clear();
+            underlyingTotal = 0;
+            for (typename CHConnections::iterator it_a = approaching.begin(); it_a != approaching.end(); it_a++) {
+                CHConnection& aInfo = *it_a;
+                CHConnections& existing = aInfo.target->followers;
+                for (typename CHConnections::iterator it = existing.begin(); it != existing.end(); it++) {
+                    it->target->visited = true;
+                }
+                for (typename CHConnections::iterator it_f = followers.begin(); it_f != followers.end(); it_f++) {
+                    CHConnection& fInfo = *it_f;
+                    if (fInfo.target != aInfo.target && !fInfo.target->visited) {
+                        const int underlying = aInfo.underlying + fInfo.underlying;
+                        underlyingTotal += underlying;
+                        shortcuts.push_back(Shortcut(ConstEdgePair(aInfo.target->edge, fInfo.target->edge),
+                                                     0., underlying, SVCAll));
+                    }
+                }
+                for (typename CHConnections::iterator it = existing.begin(); it != existing.end(); it++) {
+                    it->target->visited = false;
+                }
+            }
+        }
+
+
         // update level as defined by Abraham
         void updateLevel() {
             int maxLower = std::numeric_limits<int>::min();
@@ -381,6 +623,8 @@ private:
         // @note: we may miss some witness paths by making traveltime the only
         // criteria durinng search
         SVCPermissions permissions;
+        /// the position in the search queue (-1 if not queued)
+        int heapIndex;
 
         inline void reset() {
             traveltime = std::numeric_limits<double>::max();
@@ -452,6 +696,81 @@ private:
     }
 
 
+    /// @brief copy the connections from the original net for all vehicle classes (without costs)
+    void synchronizeTopology(CHInfo& info) {
+        const std::vector<E*>& successors = info.edge->getSuccessors(SVC_IGNORING);
+        for (typename std::vector<E*>::const_iterator it = successors.begin(); it != successors.end(); ++it) {
+            CHInfo* follower = getCHInfo(*it);
+            bool known = follower == &info;
+            for (typename CHConnections::const_iterator con = info.followers.begin(); con != info.followers.end() && !known; ++con) {
+                known = con->target == follower;
+            }
+            if (!known) {
+                info.followers.push_back(CHConnection(follower, 0., SVCAll, 1));
+                follower->approaching.push_back(CHConnection(&info, 0., SVCAll, 1));
+            }
+        }
+    }
+
+
+    /// @brief returns the index of the arc between the given edges in a topology
+    static int findArc(const Topology& topology, const int from, const int to) {
+        for (std::vector<int>::const_iterator it = topology.forwardArcs[from].begin(); it != topology.forwardArcs[from].end(); ++it) {
+            if (topology.arcs[*it].second == to) {
+                return *it;
+            }
+        }
+        for (std::vector<int>::const_iterator it = topology.backwardArcs[to].begin(); it != topology.backwardArcs[to].end(); ++it) {
+            if (topology.arcs[*it].first == from) {
+                return *it;
+            }
+        }
+        assert(false);
+        return -1;
+    }
+
+
+    /// @brief assign the cost of the cheapest lower triangle to the given arcs (if it is cheaper)
+    static void customizeArcs(const Topology& topology, const std::vector<int>& arcs, const int begin, const int end,
+                              std::vector<double>& costs, std::vector<int>& vias) {
+        for (int i = begin; i < end; i++) {
+            const int arc = arcs[i];
+            const std::vector<Triangle>& triangles = topology.triangles[arc];
+            for (typename std::vector<Triangle>::const_iterator t = triangles.begin(); t != triangles.end(); ++t) {
+                const double viaCost = costs[t->first] + costs[t->second];
+                if (viaCost < costs[arc]) {
+                    costs[arc] = viaCost;
+                    vias[arc] = t->via;
+                }
+            }
+        }
+    }
+
+
+#ifdef HAVE_FOX
+    /// @brief customizes a part of the arcs of a level
+    class CustomizationTask : public FXWorkerThread::Task {
+    public:
+        CustomizationTask(const Topology& topology, const std::vector<int>& arcs, const int begin, const int end,
+                          std::vector<double>& costs, std::vector<int>& vias)
+            : myTopology(topology), myArcs(arcs), myBegin(begin), myEnd(end), myCosts(costs), myVias(vias) {}
+        void run(FXWorkerThread* /* context */) {
+            customizeArcs(myTopology, myArcs, myBegin, myEnd, myCosts, myVias);
+        }
+    private:
+        const Topology& myTopology;
+        const std::vector<int>& myArcs;
+        const int myBegin;
+        const int myEnd;
+        std::vector<double>& myCosts;
+        std::vector<int>& myVias;
+    private:
+        /// @brief Invalidated assignment operator.
+        CustomizationTask& operator=(const CustomizationTask&);
+    };
+#endif
+
+
     /// @brief remove all connections to/from the given edge (assume it exists only once)
     void disconnect(CHConnections& connections, CHInfo* other) {
         for (typename CHConnections::iterator it = connections.begin(); it != connections.end(); it++) {
@@ -466,14 +785,14 @@ private:
     /** @brief tries to update the priority of the first edge
      * @return wether updating changed the first edge
      */
-    bool tryUpdateFront(std::vector<CHInfo*>& queue) {
+    bool tryUpdateFront(std::vector<CHInfo*>& queue, const bool witnessSearch = true) {
         myUpdateCount++;
         CHInfo* max = queue.front();
 #ifdef CHRouter_DEBUG_CONTRACTION_QUEUE
         std::cout << "updating '" << max->edge->getID() << "'\n";
         debugPrintQueue(queue);
 #endif
-        if (max->updatePriority(mySPTree)) {
+        if (witnessSearch ? max->updatePriority(mySPTree) : max->updateMetricIndependentPriority()) {
             pop_heap(queue.begin(), queue.end(), myCmp);
             push_heap(queue.begin(), queue.end(), myCmp);
             return true;
@@ -513,6 +832,11 @@ private:
     /// @brief counters for performance logging
     int myUpdateCount;
 
+#ifdef HAVE_FOX
+    /// @brief the threads for customizing the arcs of a level
+    FXWorkerThread::Pool myThreadPool;
+#endif
+
 private:
     /// @brief Invalidated assignment operator
     CHBuilder& operator=(const CHBuilder& s);
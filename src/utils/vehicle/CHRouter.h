@@ -37,12 +37,19 @@
 #include <algorithm>
 #include <iterator>
 #include <deque>
+#include <memory>
+#include <map>
 #include <utils/common/SysUtils.h>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/StdDefs.h>
+#include <utils/common/IndexedHeap.h>
 #include <utils/vehicle/SUMOAbstractRouter.h>
 #include "CHBuilder.h"
 
+#ifdef HAVE_FOX
+#include <fx.h>
+#endif
+
 //#define CHRouter_DEBUG_QUERY
 //#define CHRouter_DEBUG_QUERY_PERF
 
@@ -82,7 +89,8 @@ public:
             edge(e),
             traveltime(std::numeric_limits<double>::max()),
             prev(0),
-            visited(false) {
+            visited(false),
+            heapIndex(-1) {
         }
 
         /// The current edge
@@ -97,6 +105,9 @@ public:
         /// Whether the shortest path to this edge is already found
         bool visited;
 
+        /// The position in the frontier (-1 if not in the frontier)
+        int heapIndex;
+
         inline void reset() {
             traveltime = std::numeric_limits<double>::max();
             visited = false;
@@ -153,7 +164,7 @@ public:
         void init(const E* const start, const V* const vehicle) {
             assert(vehicle != 0);
             // all EdgeInfos touched in the previous query are either in myFrontier or myFound: clean those up
-            for (typename std::vector<EdgeInfo*>::iterator i = myFrontier.begin(); i != myFrontier.end(); i++) {
+            for (typename IndexedHeap<EdgeInfo, EdgeInfoByTTComparator>::const_iterator i = myFrontier.begin(); i != myFrontier.end(); i++) {
                 (*i)->reset();
             }
             myFrontier.clear();
@@ -165,7 +176,7 @@ public:
             EdgeInfo* startInfo = getEdgeInfo(start);
             startInfo->traveltime = 0;
             startInfo->prev = 0;
-            myFrontier.push_back(startInfo);
+            myFrontier.push(startInfo);
         }
 
 
@@ -177,13 +188,12 @@ public:
         bool step(const std::vector<ConnectionVector>& uplinks, const Unidirectional& otherSearch, double& minTTSeen, Meeting& meeting) {
             // pop the node with the minimal length
             EdgeInfo* const minimumInfo = myFrontier.front();
-            pop_heap(myFrontier.begin(), myFrontier.end(), myComparator);
-            myFrontier.pop_back();
+            myFrontier.pop();
             // check for a meeting with the other search
             const E* const minEdge = minimumInfo->edge;
 #ifdef CHRouter_DEBUG_QUERY
             std::cout << "DEBUG: " << (myAmForward ? "Forward" : "Backward") << " hit '" << minEdge->getID() << "' Q: ";
-            for (typename std::vector<EdgeInfo*>::iterator it = myFrontier.begin(); it != myFrontier.end(); it++) {
+            for (typename IndexedHeap<EdgeInfo, EdgeInfoByTTComparator>::const_iterator it = myFrontier.begin(); it != myFrontier.end(); it++) {
                 std::cout << (*it)->traveltime << "," << (*it)->edge->getID() << " ";
             }
             std::cout << "\n";
@@ -222,14 +232,7 @@ public:
                 if (!upwardInfo->visited && traveltime < oldTraveltime) {
                     upwardInfo->traveltime = traveltime;
                     upwardInfo->prev = minimumInfo;
-                    if (oldTraveltime == std::numeric_limits<double>::max()) {
-                        myFrontier.push_back(upwardInfo);
-                        push_heap(myFrontier.begin(), myFrontier.end(), myComparator);
-                    } else {
-                        push_heap(myFrontier.begin(),
-                                  find(myFrontier.begin(), myFrontier.end(), upwardInfo) + 1,
-                                  myComparator);
-                    }
+                    myFrontier.update(upwardInfo);
                 }
             }
             // @note: this effectively does a full dijkstra search.
@@ -244,18 +247,76 @@ public:
         /// @brief the role of this search
         bool myAmForward;
         /// @brief the min edge heap
-        std::vector<EdgeInfo*> myFrontier;
+        IndexedHeap<EdgeInfo, EdgeInfoByTTComparator> myFrontier;
         /// @brief the set of visited (settled) Edges
         std::set<const E*> myFound;
         /// @brief The container of edge information
         std::vector<EdgeInfo> myEdgeInfos;
 
-        EdgeInfoByTTComparator myComparator;
-
         const V* myVehicle;
 
     };
 
+    /**
+     * @class Customization
+     * The state shared by all clones of a customizable router: the metric
+     *  independent topology and the hierarchies customized for the current
+     *  weight interval (one per vehicle class)
+     */
+    class Customization {
+    public:
+        /// @brief Constructor
+        Customization(const std::vector<E*>& edges, bool unbuildIsWarning, const int numThreads) :
+            myBuilder(edges, unbuildIsWarning, SVC_IGNORING, false),
+            myTopology(0),
+            myNumThreads(numThreads) {
+        }
+
+        /// @brief Destructor
+        ~Customization() {
+            delete myTopology;
+        }
+
+        /** @brief Returns the hierarchy for the vehicle class and the weight interval starting at begin
+         *
+         * The topology is built on the first call, the hierarchy is customized
+         *  whenever a new interval is requested.
+         */
+        std::shared_ptr<const typename CHBuilder<E, V>::Hierarchy> getHierarchy(const SUMOTime begin, const V* const vehicle,
+                const SUMOAbstractRouter<E, V>* effortProvider) {
+#ifdef HAVE_FOX
+            FXMutexLock lock(myMutex);
+#endif
+            if (myTopology == 0) {
+                myTopology = myBuilder.buildTopology();
+            }
+            std::pair<SUMOTime, std::shared_ptr<const typename CHBuilder<E, V>::Hierarchy> >& current = myHierarchies[vehicle->getVClass()];
+            if (current.second == nullptr || current.first != begin) {
+                current.first = begin;
+                current.second.reset(myBuilder.customize(*myTopology, begin, vehicle, effortProvider, myNumThreads));
+            }
+            return current.second;
+        }
+
+    private:
+        /// @brief the builder (only used for the topology and the customization)
+        CHBuilder<E, V> myBuilder;
+        /// @brief the metric independent part of the hierarchy
+        const typename CHBuilder<E, V>::Topology* myTopology;
+        /// @brief the current hierarchies with the begin of their weight interval
+        std::map<SUMOVehicleClass, std::pair<SUMOTime, std::shared_ptr<const typename CHBuilder<E, V>::Hierarchy> > > myHierarchies;
+        /// @brief the number of threads to use for customization
+        const int myNumThreads;
+#ifdef HAVE_FOX
+        /// @brief the mutex guarding the customization
+        FXMutex myMutex;
+#endif
+
+    private:
+        /// @brief Invalidated assignment operator
+        Customization& operator=(const Customization& s);
+    };
+
     /** @brief Constructor
      * @param[in] validatePermissions Whether a multi-permission hierarchy shall be built
      *            If set to false, the net is pruned in synchronize() and the
@@ -295,6 +356,45 @@ public:
         mySVC(svc) {
     }
 
+    /** @brief Constructor for a customizable hierarchy
+     *
+     * The contraction order is computed once without using edge weights and
+     *  the hierarchy is only customized (recosted) for each weight period and
+     *  vehicle class. Clones share the hierarchy and its customization.
+     * @param[in] numThreads The number of threads to use for customization
+     */
+    CHRouter(const std::vector<E*>& edges, bool unbuildIsWarning, Operation operation,
+             SUMOTime weightPeriod, const int numThreads) :
+        SUMOAbstractRouter<E, V>(operation, "CHRouter"),
+        myEdges(edges),
+        myErrorMsgHandler(unbuildIsWarning ? MsgHandler::getWarningInstance() : MsgHandler::getErrorInstance()),
+        myForwardSearch(edges, true),
+        myBackwardSearch(edges, false),
+        myHierarchyBuilder(0),
+        myHierarchy(0),
+        myCustomization(std::make_shared<Customization>(edges, unbuildIsWarning, numThreads)),
+        myWeightPeriod(weightPeriod),
+        myValidUntil(0),
+        mySVC(SVC_IGNORING) {
+    }
+
+    /** @brief Cloning constructor for a customizable hierarchy
+     */
+    CHRouter(const std::vector<E*>& edges, bool unbuildIsWarning, Operation operation,
+             SUMOTime weightPeriod, const std::shared_ptr<Customization>& customization) :
+        SUMOAbstractRouter<E, V>(operation, "CHRouter"),
+        myEdges(edges),
+        myErrorMsgHandler(unbuildIsWarning ? MsgHandler::getWarningInstance() : MsgHandler::getErrorInstance()),
+        myForwardSearch(edges, true),
+        myBackwardSearch(edges, false),
+        myHierarchyBuilder(0),
+        myHierarchy(0),
+        myCustomization(customization),
+        myWeightPeriod(weightPeriod),
+        myValidUntil(0),
+        mySVC(SVC_IGNORING) {
+    }
+
     /// Destructor
     virtual ~CHRouter() {
         if (myHierarchyBuilder != 0) {
@@ -305,6 +405,10 @@ public:
 
 
     virtual SUMOAbstractRouter<E, V>* clone() {
+        if (myCustomization != nullptr) {
+            return new CHRouter<E, V, PF>(myEdges, myErrorMsgHandler == MsgHandler::getWarningInstance(), this->myOperation,
+                                          myWeightPeriod, myCustomization);
+        }
         WRITE_MESSAGE("Cloning Contraction Hierarchy for " + SumoVehicleClassStrings.getString(mySVC) + " and time " + time2string(myValidUntil) + ".");
         CHRouter<E, V, PF>* clone = new CHRouter<E, V, PF>(myEdges, myErrorMsgHandler == MsgHandler::getWarningInstance(), this->myOperation,
                 mySVC, myWeightPeriod, myHierarchy);
@@ -320,8 +424,13 @@ public:
                          SUMOTime msTime, std::vector<const E*>& into) {
         assert(from != 0 && to != 0);
         // assert(myHierarchyBuilder.mySPTree->validatePermissions() || vehicle->getVClass() == mySVC || mySVC == SVC_IGNORING);
-        // do we need to rebuild the hierarchy?
-        if (msTime >= myValidUntil) {
+        if (myCustomization != nullptr) {
+            // the customization is shared, so we keep the current one alive until the query is done
+            const SUMOTime begin = myWeightPeriod < std::numeric_limits<int>::max() ? msTime - msTime % myWeightPeriod : 0;
+            myCustomizedHierarchy = myCustomization->getHierarchy(begin, vehicle, this);
+            myHierarchy = myCustomizedHierarchy.get();
+        } else if (msTime >= myValidUntil) {
+            // we need to rebuild the hierarchy
             while (msTime >= myValidUntil) {
                 myValidUntil += myWeightPeriod;
             }
@@ -426,6 +535,22 @@ public:
 private:
     // retrieve the via edge for a shortcut
     const E* getVia(const E* forwardFrom, const E* forwardTo) const {
+        if (myCustomization != nullptr) {
+            // the shortcuts of a customized hierarchy depend on the weights and are stored with the connection
+            const typename Unidirectional::ConnectionVector& forward = myHierarchy->forwardUplinks[forwardFrom->getNumericalID()];
+            for (typename Unidirectional::ConnectionVector::const_iterator it = forward.begin(); it != forward.end(); ++it) {
+                if (it->target == forwardTo->getNumericalID()) {
+                    return it->via;
+                }
+            }
+            const typename Unidirectional::ConnectionVector& backward = myHierarchy->backwardUplinks[forwardTo->getNumericalID()];
+            for (typename Unidirectional::ConnectionVector::const_iterator it = backward.begin(); it != backward.end(); ++it) {
+                if (it->target == forwardFrom->getNumericalID()) {
+                    return it->via;
+                }
+            }
+            return 0;
+        }
         typename CHBuilder<E, V>::ConstEdgePair forward(forwardFrom, forwardTo);
         typename CHBuilder<E, V>::ShortcutVia::const_iterator it = myHierarchy->shortcuts.find(forward);
         if (it != myHierarchy->shortcuts.end()) {
@@ -450,6 +575,12 @@ private:
     CHBuilder<E, V>* myHierarchyBuilder;
     const typename CHBuilder<E, V>::Hierarchy* myHierarchy;
 
+    /// @brief the shared state of a customizable hierarchy (0 for a classic one)
+    std::shared_ptr<Customization> myCustomization;
+
+    /// @brief the customized hierarchy in use
+    std::shared_ptr<const typename CHBuilder<E, V>::Hierarchy> myCustomizedHierarchy;
+
     /// @brief the validity duration of one weight interval
     const SUMOTime myWeightPeriod;
 
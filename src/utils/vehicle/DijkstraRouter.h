@@ -40,7 +40,9 @@
 #include <utils/common/ToString.h>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/StdDefs.h>
+#include <utils/common/IndexedHeap.h>
 #include "SUMOAbstractRouter.h"
+#include "SuccessorGraph.h"
 
 //#define DijkstraRouter_DEBUG_QUERY
 //#define DijkstraRouter_DEBUG_QUERY_PERF
@@ -78,7 +80,7 @@ public:
     public:
         /// Constructor
         EdgeInfo(const E* const e)
-            : edge(e), effort(std::numeric_limits<double>::max()), leaveTime(0), prev(0), visited(false) {}
+            : edge(e), effort(std::numeric_limits<double>::max()), leaveTime(0), prev(0), visited(false), heapIndex(-1) {}
 
         /// The current edge
         const E* const edge;
@@ -95,6 +97,9 @@ public:
         /// The previous edge
         bool visited;
 
+        /// The position in the frontier (-1 if not in the frontier)
+        int heapIndex;
+
         inline void reset() {
             effort = std::numeric_limits<double>::max();
             visited = false;
@@ -121,10 +126,13 @@ public:
         }
     };
 
+    /// @brief The min edge heap
+    typedef IndexedHeap<EdgeInfo, EdgeInfoByEffortComparator> Frontier;
+
 
     /// Constructor
     DijkstraRouter(const std::vector<E*>& edges, bool unbuildIsWarning, Operation effortOperation, Operation ttOperation = nullptr) :
-        SUMOAbstractRouter<E, V>(effortOperation, "DijkstraRouter"), myTTOperation(ttOperation),
+        SUMOAbstractRouter<E, V>(effortOperation, "DijkstraRouter"), myTTOperation(ttOperation), myGraph(edges),
         myErrorMsgHandler(unbuildIsWarning ?  MsgHandler::getWarningInstance() : MsgHandler::getErrorInstance()) {
         for (typename std::vector<E*>::const_iterator i = edges.begin(); i != edges.end(); ++i) {
             myEdgeInfos.push_back(EdgeInfo(*i));
@@ -135,7 +143,7 @@ public:
     virtual ~DijkstraRouter() { }
 
     virtual SUMOAbstractRouter<E, V>* clone() {
-        return new DijkstraRouter<E, V, PF>(myEdgeInfos, myErrorMsgHandler == MsgHandler::getWarningInstance(), this->myOperation, myTTOperation);
+        return new DijkstraRouter<E, V, PF>(myGraph.getEdges(), myErrorMsgHandler == MsgHandler::getWarningInstance(), this->myOperation, myTTOperation);
     }
 
     inline double getTravelTime(const E* const e, const V* const v, const double t, const double effort) const {
@@ -144,7 +152,7 @@ public:
 
     void init() {
         // all EdgeInfos touched in the previous query are either in myFrontierList or myFound: clean those up
-        for (typename std::vector<EdgeInfo*>::iterator i = myFrontierList.begin(); i != myFrontierList.end(); i++) {
+        for (typename Frontier::const_iterator i = myFrontierList.begin(); i != myFrontierList.end(); i++) {
             (*i)->reset();
         }
         myFrontierList.clear();
@@ -174,6 +182,8 @@ public:
         std::cout << "DEBUG: starting search for '" << vehicle->getID() << "' time: " << STEPS2TIME(msTime) << "\n";
 #endif
         const SUMOVehicleClass vClass = vehicle == 0 ? SVC_IGNORING : vehicle->getVClass();
+        myGraph.update();
+        const typename Graph::Adjacency& successors = myGraph.getSuccessors(vClass);
         if (this->myBulkMode) {
             const EdgeInfo& toInfo = myEdgeInfos[to->getNumericalID()];
             if (toInfo.visited) {
@@ -188,7 +198,7 @@ public:
             fromInfo->effort = 0;
             fromInfo->prev = 0;
             fromInfo->leaveTime = STEPS2TIME(msTime);
-            myFrontierList.push_back(fromInfo);
+            myFrontierList.push(fromInfo);
         }
         // loop
         int num_visited = 0;
@@ -206,13 +216,12 @@ public:
 #endif
                 return true;
             }
-            pop_heap(myFrontierList.begin(), myFrontierList.end(), myComparator);
-            myFrontierList.pop_back();
+            myFrontierList.pop();
             myFound.push_back(minimumInfo);
             minimumInfo->visited = true;
 #ifdef DijkstraRouter_DEBUG_QUERY
             std::cout << "DEBUG: hit '" << minEdge->getID() << "' Eff: " << minimumInfo->effort << ", TT: " << minimumInfo->leaveTime << " Q: ";
-            for (typename std::vector<EdgeInfo*>::iterator it = myFrontierList.begin(); it != myFrontierList.end(); it++) {
+            for (typename Frontier::const_iterator it = myFrontierList.begin(); it != myFrontierList.end(); it++) {
                 std::cout << (*it)->effort << "," << (*it)->edge->getID() << " ";
             }
             std::cout << "\n";
@@ -223,12 +232,10 @@ public:
             assert(effort >= minimumInfo->effort);
             assert(leaveTime >= minimumInfo->leaveTime);
             // check all ways from the node with the minimal length
-            const std::vector<E*>& successors = minEdge->getSuccessors(vClass);
-            for (typename std::vector<E*>::const_iterator it = successors.begin(); it != successors.end(); ++it) {
-                const E* const follower = *it;
-                EdgeInfo* const followerInfo = &(myEdgeInfos[follower->getNumericalID()]);
+            for (typename Graph::const_iterator it = successors.begin(minEdge->getNumericalID()); it != successors.end(minEdge->getNumericalID()); ++it) {
+                EdgeInfo* const followerInfo = &(myEdgeInfos[*it]);
                 // check whether it can be used
-                if (PF::operator()(follower, vehicle)) {
+                if (PF::operator()(followerInfo->edge, vehicle)) {
                     continue;
                 }
                 const double oldEffort = followerInfo->effort;
@@ -236,14 +243,7 @@ public:
                     followerInfo->effort = effort;
                     followerInfo->leaveTime = leaveTime;
                     followerInfo->prev = minimumInfo;
-                    if (oldEffort == std::numeric_limits<double>::max()) {
-                        myFrontierList.push_back(followerInfo);
-                        push_heap(myFrontierList.begin(), myFrontierList.end(), myComparator);
-                    } else {
-                        push_heap(myFrontierList.begin(),
-                                  find(myFrontierList.begin(), myFrontierList.end(), followerInfo) + 1,
-                                  myComparator);
-                    }
+                    myFrontierList.update(followerInfo);
                 }
             }
         }
@@ -258,6 +258,31 @@ public:
     }
 
 
+    /** @brief Builds the routes to all destinations using a single search tree
+     *
+     * The destinations are queried in bulk mode, so the search is only continued
+     *  for destinations which have not been visited already.
+     */
+    int computeOneToMany(const E* from, const std::vector<const E*>& to, const V* const vehicle,
+                         SUMOTime msTime, std::vector<std::vector<const E*> >& into) {
+        const bool wasBulkMode = this->myBulkMode;
+        into.clear();
+        into.resize(to.size());
+        int numFound = 0;
+        // the tree may only be reused after a search for an admissible destination has been started
+        bool haveTree = false;
+        for (int i = 0; i < (int)to.size(); i++) {
+            this->myBulkMode = haveTree;
+            if (compute(from, to[i], vehicle, msTime, into[i])) {
+                numFound++;
+            }
+            haveTree |= !PF::operator()(from, vehicle) && !PF::operator()(to[i], vehicle);
+        }
+        this->myBulkMode = wasBulkMode;
+        return numFound;
+    }
+
+
     double recomputeCosts(const std::vector<const E*>& edges, const V* const v, SUMOTime msTime) const {
         double costs = 0;
         double t = STEPS2TIME(msTime);
@@ -287,28 +312,23 @@ public:
     }
 
 private:
-    DijkstraRouter(const std::vector<EdgeInfo>& edgeInfos, bool unbuildIsWarning, Operation effortOperation, Operation ttOperation) :
-        SUMOAbstractRouter<E, V>(effortOperation, "DijkstraRouter"), myTTOperation(ttOperation),
-        myErrorMsgHandler(unbuildIsWarning ? MsgHandler::getWarningInstance() : MsgHandler::getErrorInstance()) {
-        for (const EdgeInfo& ei : edgeInfos) {
-            myEdgeInfos.push_back(EdgeInfo(ei.edge));
-        }
-    }
+    /// @brief The compact successor graph
+    typedef SuccessorGraph<E> Graph;
 
-private:
     /// @brief The object's operation to perform for travel times
     Operation myTTOperation;
 
+    /// @brief The successors of all edges by vehicle class
+    Graph myGraph;
+
     /// The container of edge information
     std::vector<EdgeInfo> myEdgeInfos;
 
     /// A container for reusage of the min edge heap
-    std::vector<EdgeInfo*> myFrontierList;
+    Frontier myFrontierList;
     /// @brief list of visited Edges (for resetting)
     std::vector<EdgeInfo*> myFound;
 
-    EdgeInfoByEffortComparator myComparator;
-
     /// @brief the handler for routing errors
     MsgHandler* const myErrorMsgHandler;
 };
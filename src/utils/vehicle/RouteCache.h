@@ -0,0 +1,237 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    RouteCache.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// A bounded thread safe cache of routes between edge pairs
+/****************************************************************************/
+#ifndef RouteCache_h
+#define RouteCache_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <functional>
+#include <utils/common/StdDefs.h>
+#include <utils/common/SUMOTime.h>
+#include <utils/common/SUMOVehicleClass.h>
+#ifdef HAVE_FOX
+#include <fx.h>
+#endif
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class RouteCache
+ * @brief A bounded thread safe cache of routes between edge pairs
+ *
+ * The routes are stored per origin, destination and vehicle class together
+ *  with the epoch (usually the time of the last edge weight update) they were
+ *  computed for. A lookup only succeeds if the stored route is not older than
+ *  the given epoch, so callers may decide how much staleness they accept.
+ *
+ * The entries are distributed over several shards with a mutex each to allow
+ *  parallel access from routing threads. Each shard keeps at most its share of
+ *  the capacity (rounded down, small caches use fewer shards) and drops the
+ *  least recently used route if it is full, so the cache never holds more
+ *  than the given capacity.
+ */
+template<class E>
+class RouteCache {
+public:
+    /** @brief Constructor
+     * @param[in] capacity The maximum number of routes to keep (at least one)
+     * @param[in] numShards The maximum number of independently locked parts
+     */
+    RouteCache(const int capacity, const int numShards = 16) :
+        myShards(MAX2(1, MIN2(numShards, capacity))),
+        myShardCapacity(MAX2(1, capacity / (int)myShards.size())) {
+    }
+
+
+    /** @brief Retrieves a route
+     * @param[in] from The origin
+     * @param[in] to The destination
+     * @param[in] vClass The vehicle class the route was computed for
+     * @param[in] minEpoch The oldest acceptable epoch
+     * @param[filled] into The route (if found)
+     * @return Whether a route was found
+     */
+    bool get(const E* const from, const E* const to, const SUMOVehicleClass vClass,
+             const SUMOTime minEpoch, std::vector<const E*>& into) {
+        const Key key(from, to, vClass);
+        Shard& shard = getShard(key);
+#ifdef HAVE_FOX
+        FXMutexLock lock(shard.mutex);
+#endif
+        typename std::unordered_map<Key, Entry, KeyHash>::iterator it = shard.entries.find(key);
+        if (it == shard.entries.end() || it->second.epoch < minEpoch) {
+            shard.misses++;
+            return false;
+        }
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lruPos);
+        into = it->second.edges;
+        shard.hits++;
+        return true;
+    }
+
+
+    /** @brief Stores a route unless a newer one is already known
+     * @param[in] from The origin
+     * @param[in] to The destination
+     * @param[in] vClass The vehicle class the route was computed for
+     * @param[in] epoch The epoch the route was computed for
+     * @param[in] edges The route
+     */
+    void put(const E* const from, const E* const to, const SUMOVehicleClass vClass,
+             const SUMOTime epoch, const std::vector<const E*>& edges) {
+        const Key key(from, to, vClass);
+        Shard& shard = getShard(key);
+#ifdef HAVE_FOX
+        FXMutexLock lock(shard.mutex);
+#endif
+        typename std::unordered_map<Key, Entry, KeyHash>::iterator it = shard.entries.find(key);
+        if (it != shard.entries.end()) {
+            if (it->second.epoch <= epoch) {
+                it->second.epoch = epoch;
+                it->second.edges = edges;
+                shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lruPos);
+            }
+            return;
+        }
+        if ((int)shard.entries.size() >= myShardCapacity) {
+            shard.entries.erase(shard.lru.back());
+            shard.lru.pop_back();
+        }
+        shard.lru.push_front(key);
+        Entry& entry = shard.entries[key];
+        entry.epoch = epoch;
+        entry.edges = edges;
+        entry.lruPos = shard.lru.begin();
+    }
+
+
+    /// @brief Removes all routes (the counters are kept)
+    void clear() {
+        for (Shard& shard : myShards) {
+#ifdef HAVE_FOX
+            FXMutexLock lock(shard.mutex);
+#endif
+            shard.entries.clear();
+            shard.lru.clear();
+        }
+    }
+
+
+    /// @brief Returns the number of successful lookups
+    long long int getHits() {
+        long long int result = 0;
+        for (Shard& shard : myShards) {
+#ifdef HAVE_FOX
+            FXMutexLock lock(shard.mutex);
+#endif
+            result += shard.hits;
+        }
+        return result;
+    }
+
+
+    /// @brief Returns the number of failed lookups
+    long long int getMisses() {
+        long long int result = 0;
+        for (Shard& shard : myShards) {
+#ifdef HAVE_FOX
+            FXMutexLock lock(shard.mutex);
+#endif
+            result += shard.misses;
+        }
+        return result;
+    }
+
+
+private:
+    /// @brief origin, destination and vehicle class of a route
+    struct Key {
+        Key(const E* const f, const E* const t, const SUMOVehicleClass c) : from(f), to(t), vClass(c) {}
+        bool operator==(const Key& other) const {
+            return from == other.from && to == other.to && vClass == other.vClass;
+        }
+        const E* from;
+        const E* to;
+        SUMOVehicleClass vClass;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            std::size_t result = std::hash<const E*>()(key.from);
+            result ^= std::hash<const E*>()(key.to) + 0x9e3779b9 + (result << 6) + (result >> 2);
+            result ^= std::hash<int>()((int)key.vClass) + 0x9e3779b9 + (result << 6) + (result >> 2);
+            return result;
+        }
+    };
+
+    /// @brief a cached route with its epoch and its place in the usage list
+    struct Entry {
+        SUMOTime epoch;
+        std::vector<const E*> edges;
+        typename std::list<Key>::iterator lruPos;
+    };
+
+    /// @brief an independently locked part of the cache
+    struct Shard {
+        Shard() : hits(0), misses(0) {}
+#ifdef HAVE_FOX
+        FXMutex mutex;
+#endif
+        std::unordered_map<Key, Entry, KeyHash> entries;
+        /// @brief the keys, most recently used first
+        std::list<Key> lru;
+        long long int hits;
+        long long int misses;
+    };
+
+    Shard& getShard(const Key& key) {
+        return myShards[KeyHash()(key) % myShards.size()];
+    }
+
+    /// @brief the shards
+    std::vector<Shard> myShards;
+
+    /// @brief the maximum number of routes per shard
+    const int myShardCapacity;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    RouteCache(const RouteCache& src);
+
+    /// @brief Invalidated assignment operator.
+    RouteCache& operator=(const RouteCache& src);
+
+};
+
+
+#endif
+
+/****************************************************************************/
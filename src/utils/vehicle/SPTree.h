@@ -37,6 +37,7 @@
 #include <iterator>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/StdDefs.h>
+#include <utils/common/IndexedHeap.h>
 
 
 template<class E, class C>
@@ -74,7 +75,7 @@ public:
 
     void init() {
         // all EdgeInfos touched in the previous query are either in myFrontier or myFound: clean those up
-        for (typename std::vector<E*>::iterator i = myFrontier.begin(); i != myFrontier.end(); i++) {
+        for (typename IndexedHeap<E, EdgeByTTComparator>::const_iterator i = myFrontier.begin(); i != myFrontier.end(); i++) {
             (*i)->reset();
         }
         myFrontier.clear();
@@ -94,12 +95,11 @@ public:
         start->traveltime = 0;
         start->depth = 0;
         start->permissions = start->edge->getPermissions();
-        myFrontier.push_back(start);
+        myFrontier.push(start);
         // build SPT
         while (!myFrontier.empty()) {
             E* min = myFrontier.front();
-            pop_heap(myFrontier.begin(), myFrontier.end(), myCmp);
-            myFrontier.pop_back();
+            myFrontier.pop();
             myFound.push_back(min);
             min->visited = true;
             if (min->depth < myMaxDepth) {
@@ -115,14 +115,7 @@ public:
                         follower->traveltime = traveltime;
                         follower->depth = min->depth + 1;
                         follower->permissions = (min->permissions & con.permissions);
-                        if (oldTraveltime == std::numeric_limits<double>::max()) {
-                            myFrontier.push_back(follower);
-                            push_heap(myFrontier.begin(), myFrontier.end(), myCmp);
-                        } else {
-                            push_heap(myFrontier.begin(),
-                                      find(myFrontier.begin(), myFrontier.end(), follower) + 1,
-                                      myCmp);
-                        }
+                        myFrontier.update(follower);
                     }
                 }
             }
@@ -168,15 +161,14 @@ private:
         init();
         start->traveltime = 0;
         start->depth = 0;
-        myFrontier.push_back(start);
+        myFrontier.push(start);
         // build SPT
         while (!myFrontier.empty()) {
             E* min = myFrontier.front();
             if (min == dest) {
                 return dest->traveltime;
             }
-            pop_heap(myFrontier.begin(), myFrontier.end(), myCmp);
-            myFrontier.pop_back();
+            myFrontier.pop();
             myFound.push_back(min);
             min->visited = true;
             if (min->depth < myMaxDepth) {
@@ -195,14 +187,7 @@ private:
                         follower->traveltime = traveltime;
                         follower->depth = min->depth + 1;
                         follower->permissions = (min->permissions & con.permissions);
-                        if (oldTraveltime == std::numeric_limits<double>::max()) {
-                            myFrontier.push_back(follower);
-                            push_heap(myFrontier.begin(), myFrontier.end(), myCmp);
-                        } else {
-                            push_heap(myFrontier.begin(),
-                                      find(myFrontier.begin(), myFrontier.end(), follower) + 1,
-                                      myCmp);
-                        }
+                        myFrontier.update(follower);
                     }
                 }
             }
@@ -222,13 +207,10 @@ private:
     }
 
     /// @brief the min edge heap
-    std::vector<E*> myFrontier;
+    IndexedHeap<E, EdgeByTTComparator> myFrontier;
     /// @brief the list of visited edges (used when resetting)
     std::vector<E*> myFound;
 
-    /// @brief comparator for search queue
-    EdgeByTTComparator myCmp;
-
     /// @brief maximum search depth
     int myMaxDepth;
 
@@ -78,6 +78,31 @@ public:
     virtual bool compute(const E* from, const E* to, const V* const vehicle,
                          SUMOTime msTime, std::vector<const E*>& into) = 0;
 
+    /** @brief Builds the routes from the given edge to all given destinations using the minimum effort at the given time
+     *
+     * The default implementation answers one query per destination. Routers which are able
+     *  to reuse their search tree for several destinations settle only one tree.
+     *
+     * @param[in] from The origin
+     * @param[in] to The destinations
+     * @param[in] vehicle The vehicle to route
+     * @param[in] msTime The departure time
+     * @param[filled] into The routes, one for each destination (empty if there is none)
+     * @return the number of destinations which could be reached
+     */
+    virtual int computeOneToMany(const E* from, const std::vector<const E*>& to, const V* const vehicle,
+                                 SUMOTime msTime, std::vector<std::vector<const E*> >& into) {
+        into.clear();
+        into.resize(to.size());
+        int numFound = 0;
+        for (int i = 0; i < (int)to.size(); i++) {
+            if (compute(from, to[i], vehicle, msTime, into[i])) {
+                numFound++;
+            }
+        }
+        return numFound;
+    }
+
     virtual double recomputeCosts(const std::vector<const E*>& edges,
                                   const V* const v, SUMOTime msTime) const = 0;
 
@@ -179,6 +179,31 @@ public:
      */
     virtual void reroute(SUMOTime t, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, const bool onInit = false, const bool withTaz = false) = 0;
 
+    /** @brief Collects the edges a rerouting has to pass (origin, stops or via edges and destination)
+     * @param[in] onInit Whether the vehicle starts with the new route
+     * @param[in] withTaz Whether the origin and destination are taken from the taz
+     * @param[filled] legs The edges to route along
+     * @see reroute
+     */
+    virtual void getRerouteLegs(const bool onInit, const bool withTaz, ConstMSEdgeVector& legs) const = 0;
+
+    /** @brief Computes the route along the given legs without changing the vehicle
+     * @param[in] t The time for which the route is computed
+     * @param[in] router The router to use
+     * @param[in] legs The edges to route along (as given by getRerouteLegs)
+     * @param[filled] edges The new route
+     * @see reroute
+     */
+    virtual void computeReroute(SUMOTime t, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, const ConstMSEdgeVector& legs, ConstMSEdgeVector& edges) const = 0;
+
+    /** @brief Replaces the current route by the result of computeReroute
+     * @param[in] edges The new route
+     * @param[in] legs The edges the route was computed along
+     * @param[in] onInit Whether the vehicle starts with the new route
+     * @see reroute
+     */
+    virtual void applyReroute(ConstMSEdgeVector& edges, const ConstMSEdgeVector& legs, const bool onInit) = 0;
+
     /** @brief Validates the current or given route
      * @param[out] msg Description why the route is not valid (if it is the case)
      * @param[in] route The route to check (or 0 if the current route shall be checked)
@@ -0,0 +1,271 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    SuccessorGraph.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// A compact snapshot of the successors of all edges for routing
+/****************************************************************************/
+#ifndef SuccessorGraph_h
+#define SuccessorGraph_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <atomic>
+#include <utils/common/SUMOVehicleClass.h>
+#ifdef HAVE_FOX
+#include <fx.h>
+#endif
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class SuccessorGraph
+ * @brief A compact snapshot of the successors of all edges for routing
+ *
+ * For every vehicle class which is queried the successors (and predecessors) of
+ *  all edges are retrieved once from E::getSuccessors(vClass) and stored as
+ *  numerical ids in a single array (compressed sparse row format). Iterating the
+ *  followers of an edge during a search does not need any lookup in the edge
+ *  and no locking then.
+ *
+ * The edges need to be given in the order of their numerical ids. The snapshots
+ *  are immutable and shared by all graphs on the same edges (usually the graphs of
+ *  the routers in the different routing threads), so there is only one snapshot per
+ *  vehicle class and permissions version in memory. Each graph keeps a reference to
+ *  the snapshots it uses and drops them in update() if the permissions in the network
+ *  changed in between which needs to be signaled by calling permissionsChanged().
+ *  Routers call update() once at the start of each query, so the snapshots stay
+ *  valid during the query even if another thread builds newer ones.
+ *
+ * The template parameter is:
+ * @param E The edge class to use (MSEdge/ROEdge)
+ */
+template<class E>
+class SuccessorGraph {
+public:
+    typedef std::vector<int>::const_iterator const_iterator;
+
+    /// @brief The neighbors of all edges for a single vehicle class
+    class Adjacency {
+    public:
+        /// @brief Returns the first neighbor of the edge with the given numerical id
+        const_iterator begin(const int id) const {
+            return myNeighbors.begin() + myOffsets[id];
+        }
+
+        /// @brief Returns the end of the neighbors of the edge with the given numerical id
+        const_iterator end(const int id) const {
+            return myNeighbors.begin() + myOffsets[id + 1];
+        }
+
+    private:
+        /// @brief the start of the neighbors of each edge (with an additional entry for the end)
+        std::vector<int> myOffsets;
+
+        /// @brief the numerical ids of the neighbors of all edges
+        std::vector<int> myNeighbors;
+
+        friend class SuccessorGraph;
+    };
+
+
+    /// @brief Constructor
+    SuccessorGraph(const std::vector<E*>& edges) : myEdges(edges), myVersion(myPermissionsVersion.load(std::memory_order_acquire)) {}
+
+
+    /// @brief Returns the edges (ordered by numerical id)
+    const std::vector<E*>& getEdges() const {
+        return myEdges;
+    }
+
+
+    /// @brief Returns the successors for the given vehicle class (building them if needed)
+    const Adjacency& getSuccessors(const SUMOVehicleClass vClass) {
+        std::shared_ptr<const Adjacency>& succ = mySuccessors[vClass];
+        if (succ == nullptr) {
+            succ = getShared(vClass, false);
+        }
+        return *succ;
+    }
+
+
+    /** @brief Returns the predecessors for the given vehicle class (building them if needed)
+     *
+     * These are the reverse of the successors, so for every predecessor the
+     *  connection to the edge is usable by the vehicle class.
+     */
+    const Adjacency& getPredecessors(const SUMOVehicleClass vClass) {
+        std::shared_ptr<const Adjacency>& pred = myPredecessors[vClass];
+        if (pred == nullptr) {
+            pred = getShared(vClass, true);
+        }
+        return *pred;
+    }
+
+
+    /// @brief Drops the snapshots if the permissions changed since they were retrieved
+    void update() {
+        const int version = myPermissionsVersion.load(std::memory_order_acquire);
+        if (myVersion != version) {
+            mySuccessors.clear();
+            myPredecessors.clear();
+            myVersion = version;
+        }
+    }
+
+
+    /// @brief Invalidates the snapshots of all graphs for this edge class
+    static void permissionsChanged() {
+        myPermissionsVersion.fetch_add(1, std::memory_order_release);
+    }
+
+
+private:
+    /// @brief The snapshots of a vehicle class shared by all graphs
+    struct SharedEntry {
+        SharedEntry() : version(-1) {}
+        /// @brief the permissions version the snapshots were built for
+        int version;
+        /// @brief the edges the snapshots were built for
+        std::vector<E*> edges;
+        /// @brief the successors
+        std::shared_ptr<const Adjacency> successors;
+        /// @brief the predecessors (built on demand)
+        std::shared_ptr<const Adjacency> predecessors;
+    };
+
+
+    /// @brief Returns the shared successors or predecessors, rebuilding them if they are outdated
+    std::shared_ptr<const Adjacency> getShared(const SUMOVehicleClass vClass, const bool predecessors) const {
+#ifdef HAVE_FOX
+        FXMutexLock locker(myLock);
+#endif
+        SharedEntry& entry = myShared[vClass];
+        // snapshots of a newer version are fine as well, this graph drops them with the next update
+        if (entry.successors == nullptr || entry.version < myVersion || entry.edges != myEdges) {
+            entry.version = myVersion;
+            entry.edges = myEdges;
+            entry.successors = buildSuccessors(vClass);
+            entry.predecessors.reset();
+        }
+        if (predecessors) {
+            if (entry.predecessors == nullptr) {
+                entry.predecessors = buildPredecessors(*entry.successors);
+            }
+            return entry.predecessors;
+        }
+        return entry.successors;
+    }
+
+
+    /// @brief Builds the successors for the given vehicle class
+    std::shared_ptr<const Adjacency> buildSuccessors(const SUMOVehicleClass vClass) const {
+        std::shared_ptr<Adjacency> adj = std::make_shared<Adjacency>();
+        adj->myOffsets.reserve(myEdges.size() + 1);
+        for (const E* const edge : myEdges) {
+            adj->myOffsets.push_back((int)adj->myNeighbors.size());
+            for (const E* const follower : edge->getSuccessors(vClass)) {
+                adj->myNeighbors.push_back(follower->getNumericalID());
+            }
+        }
+        adj->myOffsets.push_back((int)adj->myNeighbors.size());
+        return adj;
+    }
+
+
+    /// @brief Builds the predecessors by reversing the given successors
+    std::shared_ptr<const Adjacency> buildPredecessors(const Adjacency& succ) const {
+        std::shared_ptr<Adjacency> adj = std::make_shared<Adjacency>();
+        const int numEdges = (int)myEdges.size();
+        // count the predecessors of each edge and turn the counts into offsets
+        adj->myOffsets.assign(numEdges + 1, 0);
+        for (const int neighbor : succ.myNeighbors) {
+            adj->myOffsets[neighbor + 1]++;
+        }
+        for (int i = 0; i < numEdges; i++) {
+            adj->myOffsets[i + 1] += adj->myOffsets[i];
+        }
+        adj->myNeighbors.resize(succ.myNeighbors.size());
+        std::vector<int> fill(adj->myOffsets.begin(), adj->myOffsets.end() - 1);
+        for (int i = 0; i < numEdges; i++) {
+            for (const_iterator s = succ.begin(i); s != succ.end(i); ++s) {
+                adj->myNeighbors[fill[*s]++] = i;
+            }
+        }
+        return adj;
+    }
+
+
+private:
+    /// @brief the edges (ordered by numerical id)
+    const std::vector<E*> myEdges;
+
+    /// @brief the successors used by this graph by vehicle class
+    std::map<SUMOVehicleClass, std::shared_ptr<const Adjacency> > mySuccessors;
+
+    /// @brief the predecessors used by this graph by vehicle class
+    std::map<SUMOVehicleClass, std::shared_ptr<const Adjacency> > myPredecessors;
+
+    /// @brief the permissions version the snapshots were retrieved for
+    int myVersion;
+
+    /// @brief the global permissions version which changes whenever permissions change
+    static std::atomic<int> myPermissionsVersion;
+
+    /// @brief the snapshots shared by all graphs by vehicle class
+    static std::map<SUMOVehicleClass, SharedEntry> myShared;
+
+#ifdef HAVE_FOX
+    /// @brief the lock for the shared snapshots
+    static FXMutex myLock;
+#endif
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    SuccessorGraph(const SuccessorGraph& src);
+
+    /// @brief Invalidated assignment operator.
+    SuccessorGraph& operator=(const SuccessorGraph& src);
+
+};
+
+
+template<class E>
+std::atomic<int> SuccessorGraph<E>::myPermissionsVersion(0);
+
+template<class E>
+std::map<SUMOVehicleClass, typename SuccessorGraph<E>::SharedEntry> SuccessorGraph<E>::myShared;
+
+#ifdef HAVE_FOX
+template<class E>
+FXMutex SuccessorGraph<E>::myLock;
+#endif
+
+
+#endif
+
+/****************************************************************************/
+
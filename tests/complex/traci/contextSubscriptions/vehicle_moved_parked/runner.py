@@ -0,0 +1,53 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+# Copyright (C) 2008-2018 German Aerospace Center (DLR) and others.
+# This program and the accompanying materials
+# are made available under the terms of the Eclipse Public License v2.0
+# which accompanies this distribution, and is available at
+# http://www.eclipse.org/legal/epl-v20.html
+# SPDX-License-Identifier: EPL-2.0
+
+# @file    runner.py
+# @author  agent
+# @date    2026-10-17
+# @version $Id$
+
+
+from __future__ import print_function
+from __future__ import absolute_import
+import os
+import sys
+sys.path.append(os.path.join(os.environ['SUMO_HOME'], 'tools'))
+import traci
+import traci.constants as tc
+
+sumoBinary = os.environ["SUMO_BINARY"]
+
+cmd = [sumoBinary,
+       '-n', 'input_net.net.xml',
+       '-r', 'input_routes.rou.xml',
+       '--no-step-log',
+       ]
+
+
+def printContext(label):
+    # subscribing returns the context immediately (without a simulation step)
+    traci.vehicle.subscribeContext("ego", tc.CMD_GET_VEHICLE_VARIABLE, 100)
+    print(label, " ".join(sorted(traci.vehicle.getContextSubscriptionResults("ego").keys())))
+
+
+traci.start(cmd)
+for step in range(20):
+    traci.simulationStep()
+print("parked", traci.vehicle.isStoppedParking("parked"))
+# the parked vehicle is within range but not on the road
+printContext("initial")
+# the moved vehicle has to be found at its new position within the same step
+traci.vehicle.moveTo("far", "3fi_0", 60)
+printContext("moved")
+traci.simulationStep()
+print("step", " ".join(sorted(traci.vehicle.getContextSubscriptionResults("ego").keys())))
+traci.vehicle.remove("far")
+printContext("removed")
+traci.close()
@@ -0,0 +1,50 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+# Copyright (C) 2008-2018 German Aerospace Center (DLR) and others.
+# This program and the accompanying materials
+# are made available under the terms of the Eclipse Public License v2.0
+# which accompanies this distribution, and is available at
+# http://www.eclipse.org/legal/epl-v20.html
+# SPDX-License-Identifier: EPL-2.0
+
+# @file    runner.py
+# @author  agent
+# @date    2026-10-17
+# @version $Id$
+
+
+from __future__ import print_function
+from __future__ import absolute_import
+import os
+import subprocess
+import sys
+sys.path.append(os.path.join(
+    os.path.dirname(sys.argv[0]), "..", "..", "..", "..", "..", "tools"))
+import traci
+import traci.constants as tc
+import sumolib  # noqa
+
+sumoBinary = sumolib.checkBinary('sumo')
+
+PORT = sumolib.miscutils.getFreeSocketPort()
+sumoProcess = subprocess.Popen(
+    "%s -c sumo.sumocfg --remote-port %s" % (sumoBinary, PORT), shell=True, stdout=sys.stdout)
+traci.init(PORT)
+traci.simulationStep()
+# the road changes now and then, the route never
+traci.vehicle.subscribe("horiz", (tc.VAR_ROAD_ID, tc.VAR_ROUTE_ID), onChange=True)
+# ends after 3 seconds
+traci.route.subscribe("horizontal", (tc.VAR_EDGES,), end=3000, onChange=True)
+print("initial", traci.vehicle.getSubscriptionResults("horiz"), traci.route.getSubscriptionResults("horizontal"))
+step = 1
+while traci.simulation.getMinExpectedNumber() > 0:
+    # only the changed objects and the ended subscriptions are part of the response
+    responses = traci.simulationStep()
+    step += 1
+    # between the responses the last values stay available
+    if responses:
+        print("step", step, "responses", len(responses),
+              traci.vehicle.getSubscriptionResults("horiz"), traci.route.getSubscriptionResults("horizontal"))
+traci.close()
+sumoProcess.wait()
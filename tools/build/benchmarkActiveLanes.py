@@ -0,0 +1,92 @@
+#!/usr/bin/env python
+# Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+# Copyright (C) 2018-2018 German Aerospace Center (DLR) and others.
+# This program and the accompanying materials
+# are made available under the terms of the Eclipse Public License v2.0
+# which accompanies this distribution, and is available at
+# http://www.eclipse.org/legal/epl-v20.html
+# SPDX-License-Identifier: EPL-2.0
+
+# @file    benchmarkActiveLanes.py
+# @author  agent
+# @date    2026-10-17
+# @version $Id$
+
+"""
+Runs one or more sumo binaries on a generated grid with about 100000 lanes
+(two lanes per edge) and reports the time per simulation step spent in the
+phases which iterate over the active lanes (planMovements, junctionApproaches,
+executeMovements and laneChange). The short trips on random edges keep
+switching lanes between active and inactive, so the bookkeeping of the
+active lanes gets a large share of the time.
+Needs a POSIX system (os.wait4).
+"""
+from __future__ import absolute_import
+from __future__ import print_function
+
+import os
+import sys
+import random
+import subprocess
+import tempfile
+import xml.etree.ElementTree as ET
+from optparse import OptionParser
+
+PHASES = ("planMovements", "junctionApproaches", "executeMovements", "laneChange")
+
+
+def generateScenario(options, netgenerate):
+    net = os.path.join(options.dir, "grid.net.xml")
+    subprocess.check_call([netgenerate, "--grid", "--grid.number", str(options.grid),
+                           "--grid.length", "100", "--default.lanenumber", "2",
+                           "--no-turnarounds", "true", "--no-internal-links", "true",
+                           "-o", net], stdout=open(os.devnull, "w"))
+    edges = [e.get("id") for e in ET.parse(net).getroot().findall("edge") if e.get("function") is None]
+    routes = os.path.join(options.dir, "trips.rou.xml")
+    random.seed(options.seed)
+    with open(routes, "w") as out:
+        out.write("<routes>\n")
+        for i in range(options.trips):
+            out.write('    <trip id="t%s" depart="%.2f" from="%s" to="%s" departLane="random"/>\n' %
+                      (i, float(i) * options.end / options.trips, random.choice(edges), random.choice(edges)))
+        out.write("</routes>\n")
+    return net, routes, 2 * len(edges)
+
+
+def run(sumo, net, routes, options):
+    profile = os.path.join(options.dir, "profile.xml")
+    status, usage = os.wait4(subprocess.Popen(
+        [sumo, "-n", net, "-r", routes, "-e", str(options.end), "--step-profile-output", profile,
+         "--step-profile-output.period", str(options.end), "--no-step-log", "-W", "--ignore-route-errors",
+         "--time-to-teleport", "-1"], stdout=open(os.devnull, "w")).pid, 0)[1:]
+    if status != 0:
+        sys.exit("%s failed with status %s" % (sumo, status))
+    intervals = ET.parse(profile).getroot().findall("interval")
+    steps = sum(int(i.get("steps")) for i in intervals)
+    return [sum(float(i.get(p)) for i in intervals) / steps for p in PHASES]
+
+
+def main():
+    optParser = OptionParser(usage="usage: %prog [options] [sumo-binary ...]")
+    optParser.add_option("-g", "--grid", type="int", default=112, help="number of junctions per grid row")
+    optParser.add_option("-t", "--trips", type="int", default=50000, help="number of trips")
+    optParser.add_option("-e", "--end", type="int", default=600, help="simulation end in s")
+    optParser.add_option("-s", "--seed", type="int", default=42, help="random seed for the trips")
+    optParser.add_option("-d", "--dir", help="directory for the scenario (default: temporary)")
+    options, args = optParser.parse_args()
+    binDir = os.path.join(os.environ.get("SUMO_HOME", os.path.join(os.path.dirname(__file__), "..", "..")), "bin")
+    if not args:
+        args = [os.path.join(binDir, "sumo")]
+    if options.dir is None:
+        options.dir = tempfile.mkdtemp()
+    elif not os.path.isdir(options.dir):
+        os.makedirs(options.dir)
+    net, routes, numLanes = generateScenario(options, os.path.join(binDir, "netgenerate"))
+    print("%s lanes, time per step in ms" % numLanes)
+    print("binary\t" + "\t".join(PHASES))
+    for sumo in args:
+        print(sumo + "\t" + "\t".join("%.3f" % t for t in run(sumo, net, routes, options)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+# Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+# Copyright (C) 2018-2018 German Aerospace Center (DLR) and others.
+# This program and the accompanying materials
+# are made available under the terms of the Eclipse Public License v2.0
+# which accompanies this distribution, and is available at
+# http://www.eclipse.org/legal/epl-v20.html
+# SPDX-License-Identifier: EPL-2.0
+
+# @file    benchmarkInsertion.py
+# @author  agent
+# @date    2026-10-17
+# @version $Id$
+
+"""
+Runs one or more sumo binaries on a generated flow heavy grid scenario
+and reports the peak memory (RSS), the total running time and the time
+spent in the insertion phase per inserted vehicle.
+This is meant to compare builds, e.g. a default build with one configured
+with -DNO_MEMORY_POOL=ON (cmake) or --disable-memory-pool (autotools).
+Needs a POSIX system (os.wait4).
+"""
+from __future__ import absolute_import
+from __future__ import print_function
+
+import os
+import re
+import sys
+import random
+import subprocess
+import tempfile
+import time
+import xml.etree.ElementTree as ET
+from optparse import OptionParser
+
+
+def generateScenario(options, netgenerate):
+    net = os.path.join(options.dir, "grid.net.xml")
+    subprocess.check_call([netgenerate, "--grid", "--grid.number", str(options.grid),
+                           "--grid.length", "200", "--default.lanenumber", "2",
+                           "--no-turnarounds", "true", "-o", net], stdout=open(os.devnull, "w"))
+    edges = [e.get("id") for e in ET.parse(net).getroot().findall("edge") if e.get("function") is None]
+    routes = os.path.join(options.dir, "flows.rou.xml")
+    random.seed(options.seed)
+    with open(routes, "w") as out:
+        out.write("<routes>\n")
+        for i in range(options.flows):
+            source, dest = random.sample(edges, 2)
+            out.write('    <flow id="f%s" from="%s" to="%s" begin="0" end="%s" period="%s" departLane="best"/>\n' %
+                      (i, source, dest, options.end, options.period))
+        out.write("</routes>\n")
+    return net, routes
+
+
+def run(sumo, net, routes, options):
+    profile = os.path.join(options.dir, "profile.xml")
+    start = time.time()
+    proc = subprocess.Popen([sumo, "-n", net, "-r", routes, "-e", str(options.end),
+                             "--step-profile-output", profile, "--duration-log.statistics",
+                             "--no-step-log", "-W", "--ignore-route-errors"],
+                            stdout=subprocess.PIPE, universal_newlines=True)
+    output = proc.stdout.read()
+    # wait4 reports the resource usage of this child only
+    status, usage = os.wait4(proc.pid, 0)[1:]
+    duration = time.time() - start
+    if status != 0:
+        sys.exit("%s failed with status %s" % (sumo, status))
+    inserted = int(re.search(r"Inserted: (\d+)", output).group(1))
+    insertion = sum(float(i.get("insertion")) for i in ET.parse(profile).getroot().findall("interval"))
+    # ru_maxrss is given in kilobytes on Linux
+    return usage.ru_maxrss / 1024., duration, inserted, insertion
+
+
+def main():
+    optParser = OptionParser(usage="usage: %prog [options] [sumo-binary ...]")
+    optParser.add_option("-g", "--grid", type="int", default=20, help="number of junctions per grid row")
+    optParser.add_option("-f", "--flows", type="int", default=500, help="number of flows")
+    optParser.add_option("-p", "--period", type="float", default=20., help="period of each flow in s")
+    optParser.add_option("-e", "--end", type="int", default=900, help="simulation end in s")
+    optParser.add_option("-s", "--seed", type="int", default=42, help="random seed for the flows")
+    optParser.add_option("-d", "--dir", help="directory for the scenario (default: temporary)")
+    options, args = optParser.parse_args()
+    binDir = os.path.join(os.environ.get("SUMO_HOME", os.path.join(os.path.dirname(__file__), "..", "..")), "bin")
+    if not args:
+        args = [os.path.join(binDir, "sumo")]
+    if options.dir is None:
+        options.dir = tempfile.mkdtemp()
+    elif not os.path.isdir(options.dir):
+        os.makedirs(options.dir)
+    net, routes = generateScenario(options, os.path.join(binDir, "netgenerate"))
+    print("binary\tRSS[MB]\tduration[s]\tinserted\tinsertion[ms]\tinsertion/veh[us]")
+    for sumo in args:
+        rss, duration, inserted, insertion = run(sumo, net, routes, options)
+        print("%s\t%.1f\t%.2f\t%s\t%.1f\t%.2f" % (sumo, rss, duration, inserted, insertion,
+                                                 1000. * insertion / max(inserted, 1)))
+
+
+if __name__ == "__main__":
+    main()
@@ -63,6 +63,7 @@ _RETURN_VALUE_FUNC = {tc.VAR_TIME_STEP: Storage.readInt,
                       tc.VAR_TELEPORT_ENDING_VEHICLES_NUMBER: Storage.readInt,
                       tc.VAR_TELEPORT_ENDING_VEHICLES_IDS: Storage.readStringList,
                       tc.VAR_DELTA_T: Storage.readInt,
+                      tc.VAR_STEP_PROFILE: Storage.readDouble,
                       tc.VAR_NET_BOUNDING_BOX: lambda result: (result.read("!dd"), result.read("!dd"))}
 
 
@@ -245,6 +246,14 @@ class SimulationDomain(Domain):
         """
         return self._getUniversal(tc.VAR_DELTA_T)
 
+    def getStepProfile(self, phase=""):
+        """getStepProfile(string) -> double
+        Returns the time in ms spent in the given phase of the last simulation step
+        (or in the whole step if no phase is given). This requires the options
+        --duration-log.phases or --step-profile-output.
+        """
+        return self._getUniversal(tc.VAR_STEP_PROFILE, phase)
+
     def getNetBoundary(self):
         """getNetBoundary() -> ((double, double), (double, double))
 
@@ -393,12 +402,12 @@ class SimulationDomain(Domain):
         self._connection._packString(fileName)
         self._connection._sendExact()
 
-    def subscribe(self, varIDs=(tc.VAR_DEPARTED_VEHICLES_IDS,), begin=0, end=2**31 - 1):
-        """subscribe(list(integer), double, double) -> None
+    def subscribe(self, varIDs=(tc.VAR_DEPARTED_VEHICLES_IDS,), begin=0, end=2**31 - 1, onChange=False):
+        """subscribe(list(integer), double, double, bool) -> None
 
         Subscribe to one or more simulation values for the given interval.
         """
-        Domain.subscribe(self, "", varIDs, begin, end)
+        Domain.subscribe(self, "", varIDs, begin, end, onChange)
 
     def getSubscriptionResults(self):
         """getSubscriptionResults() -> dict(integer: <value_type>)
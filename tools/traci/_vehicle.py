@@ -1302,12 +1302,12 @@ class VehicleDomain(Domain):
 
     moveToVTD = moveToXY  # deprecated method name for backwards compatibility
 
-    def subscribe(self, objectID, varIDs=(tc.VAR_ROAD_ID, tc.VAR_LANEPOSITION), begin=0, end=2**31 - 1):
-        """subscribe(string, list(integer), int, int) -> None
+    def subscribe(self, objectID, varIDs=(tc.VAR_ROAD_ID, tc.VAR_LANEPOSITION), begin=0, end=2**31 - 1, onChange=False):
+        """subscribe(string, list(integer), int, int, bool) -> None
 
         Subscribe to one or more object values for the given interval.
         """
-        Domain.subscribe(self, objectID, varIDs, begin, end)
+        Domain.subscribe(self, objectID, varIDs, begin, end, onChange)
 
     def subscribeContext(self, objectID, domain, dist, varIDs=(
             tc.VAR_ROAD_ID, tc.VAR_LANEPOSITION), begin=0, end=2**31 - 1):
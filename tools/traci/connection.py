@@ -167,12 +167,15 @@ class Connection:
         # result.printDebug()
         result.readLength()
         response = result.read("!B")[0]
+        if response == tc.RESPONSE_SUBSCRIBE_DOMAIN_VARIABLES:
+            return self._readDomainSubscription(result)
         isVariableSubscription = response >= tc.RESPONSE_SUBSCRIBE_INDUCTIONLOOP_VARIABLE and response <= tc.RESPONSE_SUBSCRIBE_PERSON_VARIABLE
         objectID = result.readString()
         if not isVariableSubscription:
             domain = result.read("!B")[0]
         numVars = result.read("!B")[0]
         if isVariableSubscription:
+            receivedVars = numVars
             while numVars > 0:
                 varID = result.read("!B")[0]
                 status, varType = result.read("!BB")
@@ -185,6 +188,8 @@ class Connection:
                     raise FatalTraCIError(
                         "Cannot handle subscription response %02x for %s." % (response, objectID))
                 numVars -= 1
+            if response in self._subscriptionMapping:
+                self._subscriptionMapping[response].completeOnChange(objectID, receivedVars)
         else:
             objectNo = result.read("!i")[0]
             for o in range(objectNo):
@@ -205,9 +210,33 @@ class Connection:
                             "Cannot handle subscription response %02x for %s." % (response, objectID))
         return objectID, response
 
-    def _subscribe(self, cmdID, begin, end, objID, varIDs, parameters=None):
+    def _readDomainSubscription(self, result):
+        domain, numVars, time, idMode = result.read("!BBiB")
+        results = self._subscriptionMapping[domain]
+        if idMode == 0:
+            results.setDomainIDs(time, result.readStringList())
+        else:
+            baseTime = result.readInt()
+            removed = result.readStringList()
+            results.updateDomainIDs(time, baseTime, removed, result.readStringList())
+        numObjects = result.readInt()
+        for v in range(numVars):
+            varID, status, varType = result.read("!BBB")
+            if status:
+                print("Error!", result.readString())
+                continue
+            size = {tc.POSITION_2D: 2, tc.POSITION_3D: 3}.get(varType, 1)
+            values = result.read("!%sd" % (numObjects * size))
+            if size > 1:
+                values = tuple(zip(*[iter(values)] * size))
+            results.addDomain(varID, values)
+        return "", tc.RESPONSE_SUBSCRIBE_DOMAIN_VARIABLES
+
+    def _subscribe(self, cmdID, begin, end, objID, varIDs, parameters=None, onChange=False):
         self._queue.append(cmdID)
         length = 1 + 1 + 4 + 4 + 4 + len(objID) + 1 + len(varIDs)
+        if onChange:
+            length += 1
         if parameters:
             for v in varIDs:
                 if v in parameters:
@@ -216,6 +245,8 @@ class Connection:
             self._string += struct.pack("!B", length)
         else:
             self._string += struct.pack("!Bi", 0, length + 4)
+        if onChange:
+            self._string += struct.pack("!B", tc.CMD_SUBSCRIBE_ON_CHANGE)
         self._string += struct.pack("!Biii",
                                     cmdID, begin, end, len(objID)) + objID.encode("latin1")
         self._string += struct.pack("!B", len(varIDs))
@@ -224,6 +255,8 @@ class Connection:
             if parameters and v in parameters:
                 self._string += parameters[v]
         result = self._sendExact()
+        if cmdID + 0x10 in self._subscriptionMapping:
+            self._subscriptionMapping[cmdID + 0x10].setOnChange(objID, onChange and bool(varIDs))
         if varIDs:
             objectID, response = self._readSubscription(result)
             if response - cmdID != 16 or objectID != objID:
@@ -252,6 +285,26 @@ class Connection:
                 raise FatalTraCIError("Received answer %02x,%s for context subscription command %02x,%s." % (
                     response, objectID, cmdID, objID))
 
+    def _subscribeDomain(self, domain, begin, end, varIDs, delta):
+        cmdID = tc.CMD_SUBSCRIBE_DOMAIN_VARIABLES
+        self._queue.append(cmdID)
+        length = 1 + 1 + 4 + 4 + 1 + 1 + 1 + len(varIDs)
+        if length <= 255:
+            self._string += struct.pack("!B", length)
+        else:
+            self._string += struct.pack("!Bi", 0, length + 4)
+        self._string += struct.pack("!BiiBBB", cmdID, begin, end, domain, 1 if delta else 0, len(varIDs))
+        for v in varIDs:
+            self._string += struct.pack("!B", v)
+        result = self._sendExact()
+        if varIDs:
+            objectID, response = self._readSubscription(result)
+            if response - cmdID != 16:
+                raise FatalTraCIError("Received answer %02x for domain subscription command %02x." % (
+                    response, cmdID))
+        else:
+            self._subscriptionMapping[domain].setDomainIDs(-1, [])
+
     def isEmbedded(self):
         return _embedded
 
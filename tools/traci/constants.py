@@ -278,6 +278,16 @@ CMD_SUBSCRIBE_PERSON_VARIABLE = 0xde
 RESPONSE_SUBSCRIBE_PERSON_VARIABLE = 0xee
 
 
+#  command: subscribe numeric variables of all objects of a domain (columnar response)
+CMD_SUBSCRIBE_DOMAIN_VARIABLES = 0x60
+#  response: subscribe numeric variables of all objects of a domain (columnar response)
+RESPONSE_SUBSCRIBE_DOMAIN_VARIABLES = 0x70
+
+#  command: subscribe object variables, sending only the changed values (wraps a subscribe variable command)
+#  unchanged objects get no response, a response with zero variables means that the subscription has ended
+CMD_SUBSCRIBE_ON_CHANGE = 0x61
+
+
 #  ****************************************
 #  POSITION REPRESENTATIONS
 #  ****************************************
@@ -793,6 +803,9 @@ VAR_NET_BOUNDING_BOX = 0x7c
 #  minimum number of expected vehicles (get: simulation)
 VAR_MIN_EXPECTED_VEHICLES = 0x7d
 
+#  duration of a phase of the last simulation step (get: simulation)
+VAR_STEP_PROFILE = 0x7f
+
 #  number of vehicles starting to park (get: simulation)
 VAR_STOP_STARTING_VEHICLES_NUMBER = 0x68
 
@@ -35,6 +35,10 @@ class SubscriptionResults:
     def __init__(self, valueFunc):
         self._results = {}
         self._contextResults = {}
+        self._domainTime = -1
+        self._domainIDs = []
+        self._domainResults = {}
+        self._onChangeResults = {}
         self._valueFunc = valueFunc
 
     def _parse(self, varID, data):
@@ -44,13 +48,36 @@ class SubscriptionResults:
 
     def reset(self):
         self._results.clear()
+        # objects of on-change subscriptions are only sent when something changed
+        for refID, last in self._onChangeResults.items():
+            self._results[refID] = dict(last)
         self._contextResults.clear()
+        # the ids are kept for the next delta
+        self._domainResults.clear()
 
     def add(self, refID, varID, data):
         if refID not in self._results:
             self._results[refID] = {}
         self._results[refID][varID] = self._parse(varID, data)
 
+    def setOnChange(self, refID, onChange):
+        if onChange:
+            self._onChangeResults.setdefault(refID, {})
+        else:
+            self._onChangeResults.pop(refID, None)
+
+    def completeOnChange(self, refID, numVars):
+        """adds the unchanged values to the results of an on-change subscription,
+        a response without variables means that the subscription has ended"""
+        if refID in self._onChangeResults:
+            if numVars == 0:
+                del self._onChangeResults[refID]
+                self._results.pop(refID, None)
+                return
+            last = self._onChangeResults[refID]
+            last.update(self._results.get(refID, {}))
+            self._results[refID] = dict(last)
+
     def get(self, refID=None):
         if refID is None:
             return self._results
@@ -70,6 +97,25 @@ class SubscriptionResults:
             return self._contextResults
         return self._contextResults.get(refID, None)
 
+    def setDomainIDs(self, time, ids):
+        self._domainTime = time
+        self._domainIDs = ids
+
+    def updateDomainIDs(self, time, baseTime, removed, added):
+        # the same step may be received twice (if other clients are slower)
+        if time != self._domainTime:
+            if baseTime != self._domainTime:
+                raise FatalTraCIError("Missed an update of the ids of a domain subscription.")
+            removed = set(removed)
+            self._domainIDs = [objID for objID in self._domainIDs if objID not in removed] + list(added)
+        self._domainTime = time
+
+    def addDomain(self, varID, values):
+        self._domainResults[varID] = values
+
+    def getDomain(self):
+        return self._domainIDs, self._domainResults
+
     def __repr__(self):
         return "<%s, %s>" % (self._results, self._contextResults)
 
@@ -129,10 +175,14 @@ class Domain:
         """
         return self._getUniversal(tc.ID_COUNT, "")
 
-    def subscribe(self, objectID, varIDs=None, begin=0, end=2**31 - 1):
-        """subscribe(string, list(integer), double, double) -> None
+    def subscribe(self, objectID, varIDs=None, begin=0, end=2**31 - 1, onChange=False):
+        """subscribe(string, list(integer), double, double, bool) -> None
 
         Subscribe to one or more object values for the given interval.
+        If onChange is True, SUMO only transfers the values which changed since the last step
+        (the subscription results still contain all values). Unchanged objects are not transferred
+        at all, when the subscription ends (the object is gone or the end time was reached)
+        SUMO sends a response without values and the object is removed from the results.
         """
         if varIDs is None:
             if tc.LAST_STEP_VEHICLE_NUMBER in self._retValFunc:
@@ -140,7 +190,7 @@ class Domain:
             else:
                 varIDs = (tc.ID_LIST,)
         self._connection._subscribe(
-            self._subscribeID, begin, end, objectID, varIDs)
+            self._subscribeID, begin, end, objectID, varIDs, onChange=onChange)
 
     def unsubscribe(self, objectID):
         """unsubscribe(string) -> None
@@ -183,6 +233,27 @@ class Domain:
     def getContextSubscriptionResults(self, objectID=None):
         return self._connection._getSubscriptionResults(self._contextResponseID).getContext(objectID)
 
+    def subscribeDomain(self, varIDs, begin=0, end=2**31 - 1, delta=False):
+        """subscribeDomain(list(integer), double, double, bool) -> None
+
+        Subscribe to numeric values (without parameters) of all objects of this domain.
+        The results are transferred as one array per variable.
+        If delta is True only the changes of the ids are transferred, which requires
+        that the results of every simulation step are received.
+        """
+        self._connection._subscribeDomain(self._cmdGetID, begin, end, varIDs, delta)
+
+    def unsubscribeDomain(self):
+        self._connection._subscribeDomain(self._cmdGetID, 0, 2**31 - 1, [], False)
+
+    def getDomainSubscriptionResults(self):
+        """getDomainSubscriptionResults() -> (list(string), dict(integer: tuple))
+
+        Returns the ids of all objects of the domain subscription and a dict of the values
+        of each variable in the order of the ids. Positions are given as tuples.
+        """
+        return self._connection._getSubscriptionResults(self._cmdGetID).getDomain()
+
     def getParameter(self, objID, param):
         """getParameter(string, string) -> string
 
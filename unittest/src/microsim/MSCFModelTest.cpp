@@ -25,12 +25,14 @@
 #include <config.h>
 #endif
 
+#include <vector>
 #include <gtest/gtest.h>
 #include <utils/vehicle/SUMOVTypeParameter.h>
 #include <microsim/MSGlobals.h>
 #include <microsim/MSVehicleType.h>
 #include <microsim/cfmodels/MSCFModel.h>
 #include <microsim/cfmodels/MSCFModel_Krauss.h>
+#include <microsim/cfmodels/MSCFModel_IDM.h>
 
 
 class MSCFModelTest : public testing::Test {
@@ -57,6 +59,35 @@ class MSCFModelTest : public testing::Test {
             delete m;
             delete type;
         }
+
+        /// @brief fills the batch input with all combinations of some typical values
+        int fillBatch(std::vector<double>& speeds, std::vector<double>& gaps,
+                      std::vector<double>& predSpeeds, std::vector<double>& predDecels) {
+            const double values[] = {0., 0.5, 1., 2.5, 4., 7., 13.9, 22.25, 36.1};
+            for (double v : values) {
+                for (double g : values) {
+                    for (double vL : values) {
+                        for (double bL = 1.; bL <= 9.; bL += 4.) {
+                            speeds.push_back(v);
+                            gaps.push_back(g);
+                            predSpeeds.push_back(vL);
+                            predDecels.push_back(bL);
+                        }
+                    }
+                }
+            }
+            return (int)speeds.size();
+        }
+};
+
+
+/// @brief IDM with access to the internal speed computation (it needs a vehicle otherwise)
+class MSCFModel_IDMTest : public MSCFModel_IDM {
+public:
+    MSCFModel_IDMTest(const MSVehicleType* vtype, double accel, double decel, double headwayTime) :
+        MSCFModel_IDM(vtype, accel, decel, decel, decel, headwayTime, 4., 0.25) {}
+    using MSCFModel_IDM::_v;
+    using MSCFModel_IDM::_vBatch;
 };
 
 /* Test the method 'brakeGap'.*/
@@ -93,6 +124,42 @@ TEST_F(MSCFModelTest, test_method_static_freeSpeed) {
     EXPECT_DOUBLE_EQ(22.25, MSCFModel::freeSpeed(vCur, 4.5, 40, 13.9, false, 1.0));
 }
 
+/* Test the method 'followSpeedBatch'.*/
+
+TEST_F(MSCFModelTest, test_method_followSpeedBatch) {
+    std::vector<double> speeds, gaps, predSpeeds, predDecels;
+    const int n = fillBatch(speeds, gaps, predSpeeds, predDecels);
+    std::vector<const MSVehicle*> vehs(n, 0);
+    std::vector<double> result(n);
+    m->followSpeedBatch(&vehs[0], &speeds[0], &gaps[0], &predSpeeds[0], &predDecels[0], &vehs[0], &result[0], n);
+    for (int i = 0; i < n; i++) {
+        EXPECT_DOUBLE_EQ(m->followSpeed(0, speeds[i], gaps[i], predSpeeds[i], predDecels[i]), result[i]);
+    }
+    // ballistic update uses the scalar fallback
+    MSGlobals::gSemiImplicitEulerUpdate = false;
+    m->followSpeedBatch(&vehs[0], &speeds[0], &gaps[0], &predSpeeds[0], &predDecels[0], &vehs[0], &result[0], n);
+    for (int i = 0; i < n; i++) {
+        EXPECT_DOUBLE_EQ(m->followSpeed(0, speeds[i], gaps[i], predSpeeds[i], predDecels[i]), result[i]);
+    }
+    MSGlobals::gSemiImplicitEulerUpdate = true;
+}
+
+TEST_F(MSCFModelTest, test_method_followSpeedBatch_IDM) {
+    MSCFModel_IDMTest idm(type, accel, decel, tau);
+    std::vector<double> speeds, gaps, predSpeeds, predDecels;
+    const int n = fillBatch(speeds, gaps, predSpeeds, predDecels);
+    for (double& gap : gaps) {
+        // the IDM is not defined for zero gaps
+        gap += 0.1;
+    }
+    const std::vector<double> desSpeeds(n, 13.9);
+    std::vector<double> result(n);
+    idm._vBatch(&speeds[0], &gaps[0], &predSpeeds[0], &desSpeeds[0], &result[0], n);
+    for (int i = 0; i < n; i++) {
+        EXPECT_DOUBLE_EQ(idm._v(0, gaps[i], speeds[i], predSpeeds[i], desSpeeds[i]), result[i]);
+    }
+}
+
 #ifdef HAVE_SUBSECOND_TIMESTEPS
 TEST_F(MSCFModelTest, test_method_static_freeSpeed_half) {
     DELTA_T = 500;
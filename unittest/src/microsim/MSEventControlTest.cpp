@@ -17,11 +17,32 @@
 // Tests the class MSEventControl  
 /****************************************************************************/
 
+#include <iostream>
+#include <vector>
 #include <gtest/gtest.h>
+#include <utils/common/SysUtils.h>
 #include <microsim/MSEventControl.h>
 #include "../utils/common/CommandMock.h"
 
 
+/// @brief a command which records its executions and repeats with a fixed period
+class RecordingCommand : public Command {
+public:
+    RecordingCommand(int id, SUMOTime period, std::vector<std::pair<int, SUMOTime> >& log) :
+        myID(id), myPeriod(period), myLog(log) {}
+
+    SUMOTime execute(SUMOTime currentTime) {
+        myLog.push_back(std::make_pair(myID, currentTime));
+        return myPeriod;
+    }
+
+private:
+    const int myID;
+    const SUMOTime myPeriod;
+    std::vector<std::pair<int, SUMOTime> >& myLog;
+};
+
+
 /* Test the method 'execute'. Tests if the execute method from the Command Class is called.*/
 
 TEST(MSEventControl, test_method_execute) {
@@ -35,3 +56,139 @@ TEST(MSEventControl, test_method_execute) {
     eventControl.execute(5);
     EXPECT_TRUE(mock->isExecuteCalled());
 }
+
+
+/* Test the order of events with the same and with different times.*/
+
+TEST(MSEventControl, test_method_execute_order) {
+    std::vector<std::pair<int, SUMOTime> > log;
+    MSEventControl eventControl;
+    eventControl.addEvent(new RecordingCommand(0, 0, log), 2000);
+    eventControl.addEvent(new RecordingCommand(1, 0, log), 1000);
+    eventControl.addEvent(new RecordingCommand(2, 0, log), 2000);
+    eventControl.addEvent(new RecordingCommand(3, 0, log), 1000);
+    eventControl.addEvent(new RecordingCommand(4, 0, log), -1);
+    eventControl.execute(0);
+    ASSERT_EQ(1, (int)log.size());
+    EXPECT_EQ(4, log[0].first);
+    eventControl.execute(1000);
+    ASSERT_EQ(3, (int)log.size());
+    EXPECT_EQ(1, log[1].first);
+    EXPECT_EQ(3, log[2].first);
+    eventControl.execute(2000);
+    ASSERT_EQ(5, (int)log.size());
+    EXPECT_EQ(0, log[3].first);
+    EXPECT_EQ(2, log[4].first);
+    EXPECT_TRUE(eventControl.isEmpty());
+}
+
+
+/* Test recurring events and events beyond the time wheel.*/
+
+TEST(MSEventControl, test_method_execute_periodic) {
+    std::vector<std::pair<int, SUMOTime> > log;
+    MSEventControl eventControl;
+    eventControl.addEvent(new RecordingCommand(0, 3000, log), 0);
+    eventControl.addEvent(new RecordingCommand(1, 0, log), 100000000);
+    eventControl.addEvent(new RecordingCommand(2, 0, log), 1500);
+    for (SUMOTime t = 0; t < 10000; t += 1000) {
+        eventControl.execute(t);
+    }
+    ASSERT_EQ(5, (int)log.size());
+    EXPECT_EQ(std::make_pair(0, (SUMOTime)0), log[0]);
+    // events between two steps are executed in the step before
+    EXPECT_EQ(std::make_pair(2, (SUMOTime)1000), log[1]);
+    EXPECT_EQ(std::make_pair(0, (SUMOTime)3000), log[2]);
+    EXPECT_EQ(std::make_pair(0, (SUMOTime)6000), log[3]);
+    EXPECT_EQ(std::make_pair(0, (SUMOTime)9000), log[4]);
+    EXPECT_FALSE(eventControl.isEmpty());
+    // jump far ahead, the recurring event catches up (12000 to 99999000) before the late one
+    eventControl.execute(100000000);
+    ASSERT_EQ(5 + 33330 + 1, (int)log.size());
+    EXPECT_EQ(std::make_pair(0, (SUMOTime)100000000), log[5]);
+    EXPECT_EQ(std::make_pair(1, (SUMOTime)100000000), log.back());
+}
+
+
+/* Test moving the pending events back in time.*/
+
+TEST(MSEventControl, test_method_clearState) {
+    std::vector<std::pair<int, SUMOTime> > log;
+    MSEventControl eventControl;
+    eventControl.addEvent(new RecordingCommand(0, 3000, log), 0);
+    eventControl.addEvent(new RecordingCommand(1, 0, log), 12000);
+    for (SUMOTime t = 0; t <= 10000; t += 1000) {
+        eventControl.execute(t);
+    }
+    ASSERT_EQ(4, (int)log.size());
+    eventControl.clearState(11000, 0);
+    for (SUMOTime t = 0; t <= 4000; t += 1000) {
+        eventControl.execute(t);
+    }
+    ASSERT_EQ(7, (int)log.size());
+    EXPECT_EQ(std::make_pair(1, (SUMOTime)1000), log[4]);
+    EXPECT_EQ(std::make_pair(0, (SUMOTime)1000), log[5]);
+    EXPECT_EQ(std::make_pair(0, (SUMOTime)4000), log[6]);
+    EXPECT_FALSE(eventControl.isEmpty());
+}
+
+
+/* Test ties of events beyond the time wheel (4096 steps) which reach it at different times.*/
+
+TEST(MSEventControl, test_method_execute_overflow_ties) {
+    std::vector<std::pair<int, SUMOTime> > log;
+    MSEventControl eventControl;
+    const SUMOTime beyond = (4096 + 10) * DELTA_T;
+    eventControl.addEvent(new RecordingCommand(0, 0, log), beyond + DELTA_T);
+    eventControl.addEvent(new RecordingCommand(1, 0, log), beyond);
+    eventControl.addEvent(new RecordingCommand(2, 0, log), beyond + DELTA_T);
+    eventControl.addEvent(new RecordingCommand(3, 0, log), beyond);
+    eventControl.addEvent(new RecordingCommand(4, 0, log), beyond + DELTA_T / 2);
+    // reinserted into the overflow queue after the others
+    eventControl.addEvent(new RecordingCommand(5, beyond, log), 0);
+    eventControl.execute(0);
+    ASSERT_EQ(1, (int)log.size());
+    // all events are in the wheel now
+    eventControl.execute(20 * DELTA_T);
+    eventControl.addEvent(new RecordingCommand(6, 0, log), beyond);
+    eventControl.execute(beyond);
+    ASSERT_EQ(6, (int)log.size());
+    // same time in insertion order, the sub-step event comes after them
+    EXPECT_EQ(1, log[1].first);
+    EXPECT_EQ(3, log[2].first);
+    EXPECT_EQ(5, log[3].first);
+    EXPECT_EQ(6, log[4].first);
+    EXPECT_EQ(4, log[5].first);
+    eventControl.execute(beyond + DELTA_T);
+    ASSERT_EQ(8, (int)log.size());
+    EXPECT_EQ(0, log[6].first);
+    EXPECT_EQ(2, log[7].first);
+    // the recurring event is in the overflow queue again
+    EXPECT_FALSE(eventControl.isEmpty());
+}
+
+
+/* Measures adding and executing 1M recurring events (run with --gtest_also_run_disabled_tests).*/
+
+TEST(MSEventControl, DISABLED_benchmark_execute) {
+    std::vector<std::pair<int, SUMOTime> > log;
+    MSEventControl eventControl;
+    const int numEvents = 1000000;
+    const SUMOTime period = 300 * DELTA_T;
+    const SUMOTime end = 3600 * DELTA_T;
+    long begin = SysUtils::getCurrentMillis();
+    for (int i = 0; i < numEvents; i++) {
+        eventControl.addEvent(new RecordingCommand(i, period, log), (i % 300) * DELTA_T);
+    }
+    const long added = SysUtils::getCurrentMillis();
+    int executed = 0;
+    for (SUMOTime t = 0; t < end; t += DELTA_T) {
+        eventControl.execute(t);
+        executed += (int)log.size();
+        log.clear();
+    }
+    const long done = SysUtils::getCurrentMillis();
+    EXPECT_EQ(12 * numEvents, executed);
+    std::cout << "added " << numEvents << " events in " << added - begin << "ms, executed "
+              << executed << " events in " << done - added << "ms\n";
+}
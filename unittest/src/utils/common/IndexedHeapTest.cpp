@@ -0,0 +1,124 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    IndexedHeapTest.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// Tests IndexedHeap class from <SUMO>/src/utils/common
+/****************************************************************************/
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <vector>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <utils/common/IndexedHeap.h>
+
+
+// ===========================================================================
+// helper classes
+// ===========================================================================
+struct Item {
+    Item(int i, double k) : id(i), key(k), heapIndex(-1) {}
+    int id;
+    double key;
+    int heapIndex;
+};
+
+class ItemComparator {
+public:
+    bool operator()(const Item* a, const Item* b) const {
+        if (a->key == b->key) {
+            return a->id > b->id;
+        }
+        return a->key > b->key;
+    }
+};
+
+
+// ===========================================================================
+// test definitions
+// ===========================================================================
+/* Tests that the elements are popped in the order of their keys */
+TEST(IndexedHeap, test_pop_order) {
+    std::vector<Item> items;
+    for (int i = 0; i < 100; i++) {
+        items.push_back(Item(i, (i * 37) % 23));
+    }
+    IndexedHeap<Item, ItemComparator> heap;
+    for (Item& item : items) {
+        heap.push(&item);
+    }
+    EXPECT_EQ(100, heap.size());
+    const Item* last = heap.front();
+    while (!heap.empty()) {
+        const Item* const front = heap.front();
+        EXPECT_FALSE(ItemComparator()(last, front));
+        heap.pop();
+        EXPECT_EQ(-1, front->heapIndex);
+        last = front;
+    }
+}
+
+/* Tests decreasing keys against std::push_heap with the same comparator */
+TEST(IndexedHeap, test_update) {
+    std::vector<Item> items;
+    for (int i = 0; i < 50; i++) {
+        items.push_back(Item(i, 100 + (i * 13) % 17));
+    }
+    IndexedHeap<Item, ItemComparator> heap;
+    std::vector<Item*> reference;
+    ItemComparator cmp;
+    for (int i = 0; i < 50; i += 2) {
+        heap.push(&items[i]);
+        reference.push_back(&items[i]);
+        std::push_heap(reference.begin(), reference.end(), cmp);
+    }
+    for (int i = 0; i < 50; i++) {
+        items[i].key -= (i * 7) % 11;
+        heap.update(&items[i]);
+        EXPECT_TRUE(heap.contains(&items[i]));
+        std::vector<Item*>::iterator it = std::find(reference.begin(), reference.end(), &items[i]);
+        if (it == reference.end()) {
+            reference.push_back(&items[i]);
+            std::push_heap(reference.begin(), reference.end(), cmp);
+        } else {
+            std::push_heap(reference.begin(), it + 1, cmp);
+        }
+    }
+    while (!reference.empty()) {
+        ASSERT_FALSE(heap.empty());
+        EXPECT_EQ(reference.front(), heap.front());
+        std::pop_heap(reference.begin(), reference.end(), cmp);
+        reference.pop_back();
+        heap.pop();
+    }
+    EXPECT_TRUE(heap.empty());
+}
+
+/* Tests that clearing resets the positions of the elements */
+TEST(IndexedHeap, test_clear) {
+    Item a(0, 1.);
+    Item b(1, 2.);
+    IndexedHeap<Item, ItemComparator> heap;
+    heap.push(&a);
+    heap.push(&b);
+    EXPECT_EQ(&a, heap.front());
+    heap.clear();
+    EXPECT_TRUE(heap.empty());
+    EXPECT_FALSE(heap.contains(&a));
+    EXPECT_FALSE(heap.contains(&b));
+}
+
+
+/****************************************************************************/
+
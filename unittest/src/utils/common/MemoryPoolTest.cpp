@@ -0,0 +1,90 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    MemoryPoolTest.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// Tests MemoryPool class from <SUMO>/src/utils/common
+/****************************************************************************/
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <utils/common/MemoryPool.h>
+
+
+// ===========================================================================
+// helper classes
+// ===========================================================================
+/// @brief gives the tests their own pools
+struct SameThreadTag {};
+struct CrossThreadTag {};
+
+
+// ===========================================================================
+// test definitions
+// ===========================================================================
+#ifndef NO_MEMORY_POOL
+/* Test the reuse of freed memory within one thread. */
+TEST(MemoryPool, test_reuse_same_thread) {
+    typedef MemoryPool<SameThreadTag> Pool;
+    void* const p = Pool::allocate(40);
+    Pool::deallocate(p, 40);
+    EXPECT_EQ(1, Pool::getNumFree(40));
+    // objects of the same rounded size share the list
+    EXPECT_EQ(p, Pool::allocate(33));
+    EXPECT_EQ(0, Pool::getNumFree(40));
+    Pool::deallocate(p, 33);
+}
+
+
+/* Test memory which is allocated by one thread and freed by another. */
+TEST(MemoryPool, test_free_other_thread) {
+    typedef MemoryPool<CrossThreadTag> Pool;
+    const int maxFree = Pool::MAX_FREE;
+    std::vector<void*> blocks;
+    for (int i = 0; i < 2 * maxFree; i++) {
+        blocks.push_back(Pool::allocate(24));
+    }
+    int numFreeConsumer = -1;
+    int numReusedConsumer = 0;
+    std::thread consumer([&]() {
+        for (void* const p : blocks) {
+            Pool::deallocate(p, 24);
+        }
+        // the list of the freeing thread is bounded, the rest went back to the system
+        numFreeConsumer = Pool::getNumFree(24);
+        // the freeing thread can reuse the memory
+        std::vector<void*> reused;
+        for (int i = 0; i < maxFree; i++) {
+            reused.push_back(Pool::allocate(24));
+            if (std::find(blocks.begin(), blocks.end(), reused.back()) != blocks.end()) {
+                numReusedConsumer++;
+            }
+        }
+        for (void* const p : reused) {
+            Pool::deallocate(p, 24);
+        }
+    });
+    consumer.join();
+    EXPECT_EQ(maxFree, numFreeConsumer);
+    EXPECT_EQ(maxFree, numReusedConsumer);
+    // the allocating thread does not get the memory back, it stays with the freeing thread until it ends
+    EXPECT_EQ(0, Pool::getNumFree(24));
+}
+#endif
+
+
+/****************************************************************************/
@@ -0,0 +1,116 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    ValueTimeMatrixTest.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// Tests ValueTimeMatrix class from <SUMO>/src/utils/common
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+#include <gtest/gtest.h>
+#include <utils/common/ValueTimeLine.h>
+#include <utils/common/ValueTimeMatrix.h>
+
+
+// ===========================================================================
+// test definitions
+// ===========================================================================
+/* Tests that aligned intervals give the same values as the time lines. */
+TEST(ValueTimeMatrix, test_same_as_timeline) {
+    ValueTimeMatrix matrix;
+    std::vector<ValueTimeLine<double> > lines(5);
+    for (int i = 0; i < 40; i++) {
+        const int index = (i * 7) % 5;
+        const double begin = 900. * ((i * 13) % 8);
+        const double end = begin + 900. * (1 + i % 3);
+        matrix.add(index, begin, end, i + 0.5);
+        lines[index].add(begin, end, i + 0.5);
+    }
+    EXPECT_TRUE(matrix.isDense());
+    for (int index = 0; index < 6; index++) {
+        for (double t = -100.; t < 10000.; t += 50.) {
+            double value = -1.;
+            const bool described = index < 5 && lines[index].describesTime(t);
+            EXPECT_EQ(described, matrix.retrieve(index, t, value)) << "index " << index << " time " << t;
+            if (described) {
+                EXPECT_DOUBLE_EQ(lines[index].getValue(t), value);
+            }
+        }
+    }
+}
+
+/* Tests that gaps are not described unless extending over the end. */
+TEST(ValueTimeMatrix, test_gaps_and_extend) {
+    ValueTimeMatrix matrix;
+    matrix.add(0, 100., 200., 1.);
+    matrix.add(1, 300., 400., 3.);
+    double value = 0.;
+    EXPECT_FALSE(matrix.retrieve(0, 50., value));
+    EXPECT_TRUE(matrix.retrieve(0, 100., value));
+    EXPECT_DOUBLE_EQ(1., value);
+    EXPECT_FALSE(matrix.retrieve(0, 200., value));
+    EXPECT_FALSE(matrix.retrieve(1, 250., value));
+    EXPECT_FALSE(matrix.retrieve(1, 400., value));
+    matrix.setExtendOverEnd(true);
+    EXPECT_TRUE(matrix.retrieve(0, 1000., value));
+    EXPECT_DOUBLE_EQ(1., value);
+    EXPECT_FALSE(matrix.retrieve(1, 250., value));
+    EXPECT_TRUE(matrix.retrieve(1, 400., value));
+    EXPECT_DOUBLE_EQ(3., value);
+    matrix.remove(0);
+    EXPECT_FALSE(matrix.retrieve(0, 150., value));
+}
+
+/* Tests that an interval which does not fit makes the matrix sparse. */
+TEST(ValueTimeMatrix, test_not_aligned) {
+    ValueTimeMatrix matrix;
+    matrix.add(0, 0., 900., 1.);
+    matrix.add(0, 1800., 3600., 2.);
+    EXPECT_TRUE(matrix.isDense());
+    matrix.add(0, 100., 200., 3.);
+    EXPECT_FALSE(matrix.isDense());
+    double value = 0.;
+    EXPECT_FALSE(matrix.retrieve(0, 0., value));
+}
+
+/* Tests that exceeding the maximum number of values makes the matrix sparse. */
+TEST(ValueTimeMatrix, test_too_large) {
+    ValueTimeMatrix matrix;
+    matrix.add(0, 0., 1., 1.);
+    EXPECT_TRUE(matrix.isDense());
+    matrix.add(0, 1e9, 1e9 + 1., 2.);
+    EXPECT_FALSE(matrix.isDense());
+}
+
+/* Tests that the values are rounded to single precision. */
+TEST(ValueTimeMatrix, test_precision) {
+    ValueTimeMatrix matrix;
+    matrix.add(0, 0., 900., 0.1);
+    double value = 0.;
+    EXPECT_TRUE(matrix.retrieve(0, 0., value));
+    EXPECT_EQ((double)0.1f, value);
+    EXPECT_NE(0.1, value);
+}
+
+
+/****************************************************************************/
+
@@ -0,0 +1,258 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    CHRouterTest.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// Tests the customizable contraction hierarchy of CHRouter from <SUMO>/src/utils/vehicle
+/****************************************************************************/
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <string>
+#include <gtest/gtest.h>
+#include <utils/common/ToString.h>
+#include <utils/vehicle/DijkstraRouter.h>
+#include <utils/vehicle/AStarRouter.h>
+#include <utils/vehicle/CHRouter.h>
+
+
+// ===========================================================================
+// helper classes
+// ===========================================================================
+class TestVehicle;
+
+class TestEdge {
+public:
+    TestEdge(const int id, const double effort, const double fromX, const double fromY, const double toX, const double toY) :
+        myID(toString(id)), myNumericalID(id), myEffort(effort), myFromX(fromX), myFromY(fromY), myToX(toX), myToY(toY) {}
+    const std::string& getID() const {
+        return myID;
+    }
+    int getNumericalID() const {
+        return myNumericalID;
+    }
+    bool isInternal() const {
+        return false;
+    }
+    SVCPermissions getPermissions() const {
+        return SVCAll;
+    }
+    bool prohibits(const void* const) const {
+        return false;
+    }
+    const std::vector<TestEdge*>& getSuccessors(SUMOVehicleClass /* vClass */ = SVC_IGNORING) const {
+        return mySuccessors;
+    }
+    double getEffort() const {
+        return myEffort;
+    }
+    void setEffort(const double effort) {
+        myEffort = effort;
+    }
+    void addSuccessor(TestEdge* const succ) {
+        mySuccessors.push_back(succ);
+    }
+    // the methods below are needed by the A* router only, the efforts are at least the lengths (at speed 1)
+    double getSpeedLimit() const {
+        return 1.;
+    }
+    double getLengthGeometryFactor() const {
+        return 1.;
+    }
+    double getDistanceTo(const TestEdge* const other) const {
+        return std::sqrt((other->myFromX - myToX) * (other->myFromX - myToX) + (other->myFromY - myToY) * (other->myFromY - myToY));
+    }
+    double getMinimumTravelTime(const TestVehicle* const /* veh */) const {
+        return myEffort;
+    }
+private:
+    const std::string myID;
+    const int myNumericalID;
+    double myEffort;
+    const double myFromX, myFromY, myToX, myToY;
+    std::vector<TestEdge*> mySuccessors;
+};
+
+
+class TestVehicle {
+public:
+    const std::string& getID() const {
+        return myID;
+    }
+    SUMOVehicleClass getVClass() const {
+        return SVC_PASSENGER;
+    }
+    double getMaxSpeed() const {
+        return 1.;
+    }
+    double getChosenSpeedFactor() const {
+        return 1.;
+    }
+private:
+    const std::string myID = "veh";
+};
+
+
+double
+getTestEffort(const TestEdge* const e, const TestVehicle* const /* v */, double /* t */) {
+    return e->getEffort();
+}
+
+
+/* Builds a grid of edges where every edge is followed by the edges leaving its end node */
+class CHRouterTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        buildGrid(5);
+    }
+
+    /// @brief builds a grid with size x size nodes in a distance of 1, the efforts are between 1 and 11
+    void buildGrid(const int size) {
+        // nodes are numbered row by row, edges connect horizontal and vertical neighbors in both directions
+        std::vector<std::pair<int, int> > nodes;
+        for (int row = 0; row < size; row++) {
+            for (int col = 0; col < size; col++) {
+                const int node = row * size + col;
+                if (col + 1 < size) {
+                    nodes.push_back(std::make_pair(node, node + 1));
+                    nodes.push_back(std::make_pair(node + 1, node));
+                }
+                if (row + 1 < size) {
+                    nodes.push_back(std::make_pair(node, node + size));
+                    nodes.push_back(std::make_pair(node + size, node));
+                }
+            }
+        }
+        std::vector<std::vector<TestEdge*> > outgoing(size * size);
+        for (int i = 0; i < (int)nodes.size(); i++) {
+            const int from = nodes[i].first;
+            const int to = nodes[i].second;
+            edges.push_back(new TestEdge(i, 1. + (i * 7) % 11, from % size, from / size, to % size, to / size));
+            edgeNodes.push_back(nodes[i]);
+            outgoing[from].push_back(edges.back());
+        }
+        for (int i = 0; i < (int)edges.size(); i++) {
+            for (TestEdge* const succ : outgoing[edgeNodes[i].second]) {
+                // no turnarounds
+                if (edgeNodes[i].first != edgeNodes[succ->getNumericalID()].second) {
+                    edges[i]->addSuccessor(succ);
+                }
+            }
+        }
+    }
+
+    virtual void TearDown() {
+        for (TestEdge* const e : edges) {
+            delete e;
+        }
+    }
+
+    /// @brief compares the costs of all routes of both routers
+    void compareAll(SUMOAbstractRouter<TestEdge, TestVehicle>& router, SUMOAbstractRouter<TestEdge, TestVehicle>& reference, const SUMOTime time) {
+        for (const TestEdge* const from : edges) {
+            for (const TestEdge* const to : edges) {
+                std::vector<const TestEdge*> route;
+                std::vector<const TestEdge*> refRoute;
+                const bool found = router.compute(from, to, &vehicle, time, route);
+                const bool refFound = reference.compute(from, to, &vehicle, time, refRoute);
+                EXPECT_EQ(refFound, found);
+                if (found && refFound) {
+                    EXPECT_EQ(from, route.front());
+                    EXPECT_EQ(to, route.back());
+                    EXPECT_DOUBLE_EQ(reference.recomputeCosts(refRoute, &vehicle, time), reference.recomputeCosts(route, &vehicle, time));
+                }
+            }
+        }
+    }
+
+    std::vector<TestEdge*> edges;
+    std::vector<std::pair<int, int> > edgeNodes;
+    TestVehicle vehicle;
+};
+
+
+// ===========================================================================
+// test definitions
+// ===========================================================================
+/* Tests that the customizable hierarchy finds routes as cheap as Dijkstra */
+TEST_F(CHRouterTest, test_distances) {
+    DijkstraRouter<TestEdge, TestVehicle, noProhibitions<TestEdge, TestVehicle> > dijkstra(edges, true, &getTestEffort);
+    CHRouter<TestEdge, TestVehicle, noProhibitions<TestEdge, TestVehicle> > cch(edges, true, &getTestEffort, TIME2STEPS(100), 1);
+    compareAll(cch, dijkstra, 0);
+}
+
+
+/* Tests that the customization follows changed weights and that clones share it */
+TEST_F(CHRouterTest, test_recustomize) {
+    DijkstraRouter<TestEdge, TestVehicle, noProhibitions<TestEdge, TestVehicle> > dijkstra(edges, true, &getTestEffort);
+    CHRouter<TestEdge, TestVehicle, noProhibitions<TestEdge, TestVehicle> > cch(edges, true, &getTestEffort, TIME2STEPS(100), 2);
+    compareAll(cch, dijkstra, 0);
+    for (int i = 0; i < (int)edges.size(); i++) {
+        edges[i]->setEffort(1. + (i * 5) % 13);
+    }
+    SUMOAbstractRouter<TestEdge, TestVehicle>* clone = cch.clone();
+    compareAll(*clone, dijkstra, TIME2STEPS(100));
+    compareAll(cch, dijkstra, TIME2STEPS(100));
+    delete clone;
+}
+
+
+/* Tests that A* with the air distance heuristic finds routes as cheap as Dijkstra */
+TEST_F(CHRouterTest, test_astar_distances) {
+    DijkstraRouter<TestEdge, TestVehicle, noProhibitions<TestEdge, TestVehicle> > dijkstra(edges, true, &getTestEffort);
+    AStarRouter<TestEdge, TestVehicle, noProhibitions<TestEdge, TestVehicle> > astar(edges, true, &getTestEffort);
+    compareAll(astar, dijkstra, 0);
+}
+
+
+/* Measures the query latencies of Dijkstra and A* on a grid with 100x100 nodes (run with --gtest_also_run_disabled_tests) */
+TEST_F(CHRouterTest, DISABLED_benchmark_query_latency) {
+    for (TestEdge* const e : edges) {
+        delete e;
+    }
+    edges.clear();
+    edgeNodes.clear();
+    buildGrid(100);
+    const int numQueries = 1000;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> edgeIndex(0, (int)edges.size() - 1);
+    std::vector<std::pair<const TestEdge*, const TestEdge*> > queries;
+    for (int i = 0; i < numQueries; i++) {
+        queries.push_back(std::make_pair(edges[edgeIndex(rng)], edges[edgeIndex(rng)]));
+    }
+    DijkstraRouter<TestEdge, TestVehicle, noProhibitions<TestEdge, TestVehicle> > dijkstra(edges, true, &getTestEffort);
+    AStarRouter<TestEdge, TestVehicle, noProhibitions<TestEdge, TestVehicle> > astar(edges, true, &getTestEffort);
+    SUMOAbstractRouter<TestEdge, TestVehicle>* const routers[] = {&dijkstra, &astar};
+    const char* const names[] = {"Dijkstra", "A*"};
+    for (int r = 0; r < 2; r++) {
+        std::vector<double> latencies;
+        for (const std::pair<const TestEdge*, const TestEdge*>& query : queries) {
+            std::vector<const TestEdge*> route;
+            const std::chrono::high_resolution_clock::time_point begin = std::chrono::high_resolution_clock::now();
+            EXPECT_TRUE(routers[r]->compute(query.first, query.second, &vehicle, 0, route));
+            latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - begin).count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        std::cout << names[r] << " on " << edges.size() << " edges, " << numQueries << " queries, latency in us:"
+                  << " p50=" << latencies[numQueries / 2]
+                  << " p90=" << latencies[numQueries * 9 / 10]
+                  << " p99=" << latencies[numQueries * 99 / 100]
+                  << " max=" << latencies.back() << "\n";
+    }
+}
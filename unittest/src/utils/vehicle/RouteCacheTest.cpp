@@ -0,0 +1,103 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    RouteCacheTest.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// Tests RouteCache class from <SUMO>/src/utils/vehicle
+/****************************************************************************/
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <vector>
+#include <gtest/gtest.h>
+#include <utils/vehicle/RouteCache.h>
+
+
+// ===========================================================================
+// test definitions
+// ===========================================================================
+/* Tests that stored routes are found for the same origin, destination and class only */
+TEST(RouteCache, test_get_put) {
+    int edges[3];
+    RouteCache<int> cache(10);
+    std::vector<const int*> route;
+    route.push_back(&edges[0]);
+    route.push_back(&edges[1]);
+    route.push_back(&edges[2]);
+    cache.put(&edges[0], &edges[2], SVC_PASSENGER, 0, route);
+    std::vector<const int*> into;
+    EXPECT_TRUE(cache.get(&edges[0], &edges[2], SVC_PASSENGER, 0, into));
+    EXPECT_EQ(route, into);
+    EXPECT_FALSE(cache.get(&edges[0], &edges[2], SVC_BICYCLE, 0, into));
+    EXPECT_FALSE(cache.get(&edges[2], &edges[0], SVC_PASSENGER, 0, into));
+    EXPECT_EQ(1, cache.getHits());
+    EXPECT_EQ(2, cache.getMisses());
+}
+
+
+/* Tests that routes older than the requested epoch are not returned and not stored */
+TEST(RouteCache, test_epoch) {
+    int edges[2];
+    RouteCache<int> cache(10);
+    std::vector<const int*> oldRoute(1, &edges[0]);
+    std::vector<const int*> newRoute(2, &edges[1]);
+    std::vector<const int*> into;
+    cache.put(&edges[0], &edges[1], SVC_PASSENGER, 10, oldRoute);
+    EXPECT_TRUE(cache.get(&edges[0], &edges[1], SVC_PASSENGER, 10, into));
+    EXPECT_FALSE(cache.get(&edges[0], &edges[1], SVC_PASSENGER, 20, into));
+    cache.put(&edges[0], &edges[1], SVC_PASSENGER, 20, newRoute);
+    EXPECT_TRUE(cache.get(&edges[0], &edges[1], SVC_PASSENGER, 20, into));
+    EXPECT_EQ(newRoute, into);
+    // an older route does not replace a newer one
+    cache.put(&edges[0], &edges[1], SVC_PASSENGER, 10, oldRoute);
+    EXPECT_TRUE(cache.get(&edges[0], &edges[1], SVC_PASSENGER, 0, into));
+    EXPECT_EQ(newRoute, into);
+}
+
+
+/* Tests that the least recently used route is dropped */
+TEST(RouteCache, test_lru) {
+    int edges[3];
+    RouteCache<int> cache(2, 1);
+    std::vector<const int*> route(1, &edges[0]);
+    std::vector<const int*> into;
+    cache.put(&edges[0], &edges[1], SVC_PASSENGER, 0, route);
+    cache.put(&edges[1], &edges[2], SVC_PASSENGER, 0, route);
+    EXPECT_TRUE(cache.get(&edges[0], &edges[1], SVC_PASSENGER, 0, into));
+    cache.put(&edges[2], &edges[0], SVC_PASSENGER, 0, route);
+    EXPECT_TRUE(cache.get(&edges[0], &edges[1], SVC_PASSENGER, 0, into));
+    EXPECT_FALSE(cache.get(&edges[1], &edges[2], SVC_PASSENGER, 0, into));
+    EXPECT_TRUE(cache.get(&edges[2], &edges[0], SVC_PASSENGER, 0, into));
+}
+
+
+/* Tests that the cache never holds more routes than its capacity (also with fewer routes than shards) */
+TEST(RouteCache, test_capacity) {
+    int edges[100];
+    std::vector<const int*> route(1, &edges[0]);
+    std::vector<const int*> into;
+    for (int capacity = 1; capacity <= 40; capacity++) {
+        RouteCache<int> cache(capacity);
+        for (int i = 0; i < 100; i++) {
+            cache.put(&edges[i], &edges[(i + 1) % 100], SVC_PASSENGER, 0, route);
+        }
+        int found = 0;
+        for (int i = 0; i < 100; i++) {
+            if (cache.get(&edges[i], &edges[(i + 1) % 100], SVC_PASSENGER, 0, into)) {
+                found++;
+            }
+        }
+        EXPECT_LE(found, capacity);
+        EXPECT_GT(found, 0);
+    }
+}
@@ -0,0 +1,102 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2001-2018 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials
+// are made available under the terms of the Eclipse Public License v2.0
+// which accompanies this distribution, and is available at
+// http://www.eclipse.org/legal/epl-v20.html
+// SPDX-License-Identifier: EPL-2.0
+/****************************************************************************/
+/// @file    SuccessorGraphTest.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id$
+///
+// Tests the shared successor snapshots of SuccessorGraph from <SUMO>/src/utils/vehicle
+/****************************************************************************/
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <vector>
+#include <gtest/gtest.h>
+#include <utils/vehicle/SuccessorGraph.h>
+
+
+// ===========================================================================
+// helper classes
+// ===========================================================================
+class GraphEdge {
+public:
+    GraphEdge(const int id) : myNumericalID(id) {}
+    int getNumericalID() const {
+        return myNumericalID;
+    }
+    const std::vector<GraphEdge*>& getSuccessors(SUMOVehicleClass /* vClass */ = SVC_IGNORING) const {
+        return mySuccessors;
+    }
+    void addSuccessor(GraphEdge* const succ) {
+        mySuccessors.push_back(succ);
+    }
+private:
+    const int myNumericalID;
+    std::vector<GraphEdge*> mySuccessors;
+};
+
+
+/* Builds a chain 0 -> 1 -> 2 */
+class SuccessorGraphTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        for (int i = 0; i < 3; i++) {
+            edges.push_back(new GraphEdge(i));
+        }
+        edges[0]->addSuccessor(edges[1]);
+        edges[1]->addSuccessor(edges[2]);
+    }
+
+    virtual void TearDown() {
+        for (GraphEdge* const e : edges) {
+            delete e;
+        }
+    }
+
+    std::vector<GraphEdge*> edges;
+};
+
+
+// ===========================================================================
+// test definitions
+// ===========================================================================
+/* Tests the successors and the reversed predecessors */
+TEST_F(SuccessorGraphTest, test_neighbors) {
+    SuccessorGraph<GraphEdge> graph(edges);
+    const SuccessorGraph<GraphEdge>::Adjacency& succ = graph.getSuccessors(SVC_PASSENGER);
+    EXPECT_EQ(1, succ.end(0) - succ.begin(0));
+    EXPECT_EQ(1, *succ.begin(0));
+    EXPECT_EQ(0, succ.end(2) - succ.begin(2));
+    const SuccessorGraph<GraphEdge>::Adjacency& pred = graph.getPredecessors(SVC_PASSENGER);
+    EXPECT_EQ(0, pred.end(0) - pred.begin(0));
+    EXPECT_EQ(1, *pred.begin(2));
+}
+
+
+/* Tests that graphs on the same edges share the snapshots until the permissions change */
+TEST_F(SuccessorGraphTest, test_shared) {
+    SuccessorGraph<GraphEdge> graph(edges);
+    SuccessorGraph<GraphEdge> other(edges);
+    const SuccessorGraph<GraphEdge>::Adjacency* const succ = &graph.getSuccessors(SVC_PASSENGER);
+    EXPECT_EQ(succ, &other.getSuccessors(SVC_PASSENGER));
+    EXPECT_EQ(&graph.getPredecessors(SVC_PASSENGER), &other.getPredecessors(SVC_PASSENGER));
+    edges[2]->addSuccessor(edges[0]);
+    SuccessorGraph<GraphEdge>::permissionsChanged();
+    // the old snapshot stays valid until the next update
+    EXPECT_EQ(succ, &graph.getSuccessors(SVC_PASSENGER));
+    EXPECT_EQ(0, succ->end(2) - succ->begin(2));
+    graph.update();
+    other.update();
+    const SuccessorGraph<GraphEdge>::Adjacency& updated = graph.getSuccessors(SVC_PASSENGER);
+    EXPECT_EQ(&updated, &other.getSuccessors(SVC_PASSENGER));
+    EXPECT_EQ(1, updated.end(2) - updated.begin(2));
+    EXPECT_EQ(0, *updated.begin(2));
+}